@@ -30,8 +30,12 @@ static string ct_str_file_path_asym = string(SE_ADAPTER_FILE_OUTPUT_DIR) + "/out
 static string ct_str_file_path_sym  = string(SE_ADAPTER_FILE_OUTPUT_DIR) + "/out_sym_api_tests";
 
 void verify_ciphertexts(string dirpath, double scale, size_t degree, seal::SEALContext &context,
-                        bool symm_enc, string ct_str_file_path, string sk_binfilename = "")
+                        bool symm_enc, string ct_str_file_path, bool seeded = false,
+                        string sk_binfilename = "")
 {
+    // -- Seeded ciphertexts (see: SE_ENABLE_SYM_SEED_CT) are only supported in symmetric mode
+    assert(symm_enc || !seeded);
+
     auto &parms = context.key_context_data()->parms();
     size_t n    = parms.poly_modulus_degree();
 
@@ -123,7 +127,16 @@ void verify_ciphertexts(string dirpath, double scale, size_t degree, seal::SEALC
 
             // -- Read in the ciphertext from the string file
             cout << "Reading ciphertexts from file..." << endl;
-            filepos = ct_string_file_load(ct_str_file_path, context, evaluator, ct, filepos);
+            if (seeded)
+            {
+                // -- c1 is regenerated from the seed sent in front of the ciphertext
+                filepos =
+                    ct_seeded_string_file_load(ct_str_file_path, context, evaluator, ct, filepos);
+            }
+            else
+            {
+                filepos = ct_string_file_load(ct_str_file_path, context, evaluator, ct, filepos);
+            }
             cout << "encrypted size: " << ct.size() << endl;
 
             // -- Decrypt and decode the ciphertext
@@ -310,6 +323,7 @@ int main(int argc, char *argv[])
         cout << "  7) Generate regular  NTT roots\n";
         cout << "  8) Generate regular INTT roots\n";
         cout << "  9) Generate index map\n";
+        if (is_sym) { cout << " 10) Verify seeded ciphertexts (in symmetric mode)\n"; }
         int option;
         cin >> option;
 
@@ -346,6 +360,15 @@ int main(int argc, char *argv[])
                 gen_save_ntt_roots(save_dir_path, context, 0, 1, 0, 1);
                 if (option != 1) break;
             case 9: gen_save_index_map(save_dir_path, context, 0); break;
+            case 10:
+                if (!is_sym)
+                {
+                    cout << err_msg2 << endl;
+                    break;
+                }
+                verify_ciphertexts(save_dir_path, scale, degree, context, is_sym,
+                                   ct_str_file_path_sym, true);
+                break;
             default: cout << err_msg2 << endl; break;
         }
     }
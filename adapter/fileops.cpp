@@ -7,12 +7,15 @@
 
 #include "fileops.h"
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 
 #include "convert.h"
 #include "seal/seal.h"
+#include "seal/util/fips202.h"
 #include "utils.h"
 
 using namespace std;
@@ -51,7 +54,7 @@ void sk_bin_file_save(string fpath, string str_fpath, const SEALContext &context
         file2 << "\n#include <stdint.h>\n\n";
         // -- # bytes = n vals * (2 bits / val) * (1 byte / 8 bits)
         size_t nbytes = n / 4;
-        file2 << "#ifdef SE_DATA_FROM_CODE_COPY\nconst\n#endif" << endl;
+        file2 << "const" << endl;
         file2 << "// -- Secret key for polynomial ring degree = " << n << "\n";
         file2 << "uint8_t secret_key[" << nbytes << "] = { ";
     }
@@ -191,7 +194,7 @@ void pk_bin_file_save(string dirpath, const SEALContext &context, PublicKeyWrapp
     file3 << "#if defined(SE_DATA_FROM_CODE_COPY) || defined(SE_DATA_FROM_CODE_DIRECT)\n\n";
 
     stringstream pk_addr_str;
-    pk_addr_str << "ZZ* pk_prime_addr[" << string_file_nprimes << "][2] = \n{\n";
+    pk_addr_str << "const ZZ *const pk_prime_addr[" << string_file_nprimes << "][2] = \n{\n";
 
     for (size_t outer = 0; outer < 2; outer++)
     {
@@ -232,7 +235,7 @@ void pk_bin_file_save(string dirpath, const SEALContext &context, PublicKeyWrapp
                 }
                 file2 << "#if defined(SE_DATA_FROM_CODE_COPY) || "
                          "defined(SE_DATA_FROM_CODE_DIRECT)\n";
-                file2 << "#ifdef SE_DATA_FROM_CODE_COPY\nconst\n#endif" << endl;
+                file2 << "const" << endl;
                 if (large_modulus)
                     file2 << "uint64_t ";
                 else
@@ -371,6 +374,86 @@ void pk_bin_file_load(string dirpath, const SEALContext &context, PublicKeyWrapp
     }
 }
 
+void poly_unpack(const uint8_t *in, size_t n, size_t nbits, uint64_t *out)
+{
+    assert(nbits >= 1 && nbits <= 32);
+    uint64_t mask = (uint64_t(1) << nbits) - 1;
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t bit_pos  = i * nbits;
+        size_t byte_pos = bit_pos / 8;
+        size_t shift    = bit_pos % 8;
+        size_t nread    = (shift + nbits + 7) / 8;  // At most 5 bytes
+
+        uint64_t val = 0;
+        for (size_t k = 0; k < nread; k++) { val |= uint64_t(in[byte_pos + k]) << (8 * k); }
+        out[i] = (val >> shift) & mask;
+    }
+}
+
+streampos ct_bin_file_load(string fpath, const SEALContext &context, Evaluator &evaluator,
+                           Ciphertext &ct, bool packed, bool seeded, streampos filepos_in)
+{
+    auto &ct_parms    = context.first_context_data()->parms();
+    auto &ct_parms_id = context.first_parms_id();
+    auto &coeff_mod   = ct_parms.coeff_modulus();
+    size_t ct_nprimes = coeff_mod.size();
+    size_t n          = ct_parms.poly_modulus_degree();
+    bool is_ntt       = ct.is_ntt_form();
+    assert(is_ntt);
+
+    // -- Ciphertext has two components
+    ct.resize(context, ct_parms_id, 2);
+
+    // -- Make sure ciphertext is in NTT form
+    if (!is_ntt)
+    {
+        ct_to_non_ntt_form(evaluator, ct);
+        assert(ct.is_ntt_form() == false);
+    }
+
+    string action = "Loading ciphertext from file at \"" + fpath + "\"";
+    fstream file(fpath, fstream::binary | fstream::in);
+    exit_on_err_file(file, action, 1);
+    file.seekg(filepos_in);
+
+    // -- Seed version, followed by the seed (sent once per ciphertext)
+    vector<uint8_t> header(65);
+    if (seeded) { file.read(reinterpret_cast<char *>(header.data()), header.size()); }
+
+    auto ct_ptr = get_ct_arr_ptr(ct);
+    vector<uint8_t> poly_bytes(n * 4);
+    for (size_t j = 0; j < ct_nprimes; j++)
+    {
+        size_t nbits  = packed ? static_cast<size_t>(coeff_mod[j].bit_count()) : 32;
+        size_t nbytes = (n * nbits + 7) / 8;
+        for (size_t k = 0; k < 2; k++)
+        {
+            uint64_t *poly = ct_ptr + j * n + k * ct_nprimes * n;
+            if (k && seeded)
+            {
+                seeded_ct_expand_c1(header, j, coeff_mod[j], n, poly);
+                continue;
+            }
+            file.read(reinterpret_cast<char *>(poly_bytes.data()), nbytes);
+            poly_unpack(poly_bytes.data(), n, nbits, poly);
+        }
+    }
+    exit_on_err_file(file, action, 0);
+    streampos filepos = file.tellg();
+    file.close();
+    print_ct(ct, 8);
+
+    // -- Convert ciphertext back to non-NTT form if necessary
+    if (!is_ntt)
+    {
+        ct_to_ntt_form(evaluator, ct);
+        assert(ct.is_ntt_form() == true);
+    }
+
+    return filepos;
+}
+
 // ==============================================================
 //                      Binary file save/load
 //                         (SEAL format)
@@ -536,3 +619,100 @@ streampos ct_string_file_load(string fpath, const SEALContext &context, Evaluato
 
     return filepos;
 }
+
+void seeded_ct_expand_c1(const vector<uint8_t> &header, uint64_t counter, const Modulus &q,
+                         size_t n, uint64_t *c1)
+{
+    // -- Must match SE_PRNG_SEED_BYTE_COUNT and SE_PRNG_SEED_VERSION (SHAKE256) on the device
+    const size_t seed_byte_count = 64;
+    assert(header.size() == 1 + seed_byte_count);
+    if (header[0] != 1)
+    {
+        throw invalid_argument("seed version " + to_string(header[0]) +
+                               " is not supported (set SE_PRNG_TYPE to 0 on the device)");
+    }
+
+    // -- The device expands SHAKE256(seed || le64(counter)) into 32-bit candidates
+    vector<uint8_t> seed_ext(seed_byte_count + 8);
+    copy_n(header.cbegin() + 1, seed_byte_count, seed_ext.begin());
+    for (size_t k = 0; k < 8; k++)
+    { seed_ext[seed_byte_count + k] = (uint8_t)(counter >> (8 * k)); }
+
+    // -- Accept candidates below max_multiple (a multiple of q), as on the device
+    uint64_t max_random   = 0xFFFFFFFFULL;
+    uint64_t max_multiple = max_random - (max_random % q.value()) - 1;
+
+    // -- The first n candidates are the coefficients of c1. Each rejected coefficient is replaced,
+    //    in order, with the next accepted candidate after the first n. Regenerate with a longer
+    //    output (of which the shorter output is a prefix) if we run out of candidates.
+    size_t ncand = n + n / 8;
+    while (true)
+    {
+        vector<uint8_t> stream(ncand * 4);
+        shake256(stream.data(), stream.size(), seed_ext.data(), seed_ext.size());
+        auto get_cand = [&stream](size_t k) {
+            return (uint64_t)stream[4 * k] | ((uint64_t)stream[4 * k + 1] << 8) |
+                   ((uint64_t)stream[4 * k + 2] << 16) | ((uint64_t)stream[4 * k + 3] << 24);
+        };
+
+        size_t next = n;
+        size_t i    = 0;
+        for (; i < n; i++)
+        {
+            uint64_t val = get_cand(i);
+            while (val >= max_multiple && next < ncand) { val = get_cand(next++); }
+            if (val >= max_multiple) break;
+            c1[i] = val % q.value();
+        }
+        if (i == n) return;
+        ncand *= 2;
+    }
+}
+
+streampos ct_seeded_string_file_load(string fpath, const SEALContext &context,
+                                     Evaluator &evaluator, Ciphertext &ct, streampos filepos_in)
+{
+    auto &ct_parms    = context.first_context_data()->parms();
+    auto &ct_parms_id = context.first_parms_id();
+    auto &coeff_mod   = ct_parms.coeff_modulus();
+    size_t ct_nprimes = coeff_mod.size();
+    size_t n          = ct_parms.poly_modulus_degree();
+    bool is_ntt       = ct.is_ntt_form();
+    assert(is_ntt);
+
+    // -- Ciphertext has two components
+    ct.resize(context, ct_parms_id, 2);
+
+    // -- Make sure ciphertext is in NTT form
+    if (!is_ntt)
+    {
+        ct_to_non_ntt_form(evaluator, ct);
+        assert(ct.is_ntt_form() == false);
+    }
+
+    // -- Read the header (seed version and seed) once per ciphertext
+    vector<uint64_t> header_temp(65);
+    streampos filepos = poly_string_file_load(fpath, 1, header_temp, filepos_in);
+    vector<uint8_t> header(header_temp.size());
+    for (size_t k = 0; k < header.size(); k++) { header[k] = (uint8_t)header_temp[k]; }
+
+    vector<uint64_t> ct_temp_1p(n);
+    for (size_t j = 0; j < ct_nprimes; j++)
+    {
+        // -- Load in c0, then regenerate c1 with prng counter j
+        filepos     = poly_string_file_load(fpath, 1, ct_temp_1p, filepos);
+        auto ct_ptr = get_ct_arr_ptr(ct);
+        copy_n(ct_temp_1p.cbegin(), n, ct_ptr + j * n);
+        seeded_ct_expand_c1(header, j, coeff_mod[j], n, ct_ptr + j * n + ct_nprimes * n);
+    }
+    print_ct(ct, 8);
+
+    // -- Convert ciphertext back to non-NTT form if necessary
+    if (!is_ntt)
+    {
+        ct_to_ntt_form(evaluator, ct);
+        assert(ct.is_ntt_form() == true);
+    }
+
+    return filepos;
+}
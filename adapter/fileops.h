@@ -13,6 +13,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "seal/seal.h"
 #include "utils.h"
@@ -127,6 +128,45 @@ Loads a public key from a SEAL-Embedded-formatted binary file.
 void pk_bin_file_load(std::string dirpath, const seal::SEALContext &context,
                       PublicKeyWrapper &pk_wr, bool incl_sp, bool high_byte_first);
 
+/**
+Unpacks a polynomial packed by SEAL-Embedded (see: SE_ENABLE_PACKED_CT in the device library's
+user_defines.h and poly_pack_inpl in pack.h). Coefficient i occupies bits
+[i * nbits, (i + 1) * nbits) of the packed bytes, least significant bit first. With nbits = 32, this
+reads n 32-bit little-endian values, i.e., an unpacked polynomial.
+
+@param[in]  in     Packed polynomial ((n * nbits + 7) / 8 bytes)
+@param[in]  n      Number of coefficients
+@param[in]  nbits  Bit width of each coefficient (the number of bits of the prime if packed)
+@param[out] out    Unpacked polynomial (n values)
+*/
+void poly_unpack(const uint8_t *in, std::size_t n, std::size_t nbits, std::uint64_t *out);
+
+/**
+Loads a freshly encrypted ciphertext from a binary file containing the bytes that SEAL-Embedded
+passed to its network send function for this ciphertext, in order:
+
+[header]                     --> only if seeded (seed version, followed by the seed)
+c0 : w.r.t. first prime
+[c1 : w.r.t. first prime]    --> only if not seeded (otherwise regenerated from the seed)
+c0 : w.r.t. next prime
+...
+
+Each component is either packed to the bit width of its prime (if packed) or n 32-bit little-endian
+values.
+
+@param[in]  fpath       Path to binary file
+@param[in]  context     SEAL context
+@param[in]  evaluator   SEAL evaluator
+@param[out] ct          Ciphertext object to load values into
+@param[in]  packed      Set to true if SE_ENABLE_PACKED_CT was defined on the device
+@param[in]  seeded      Set to true if SE_ENABLE_SYM_SEED_CT was defined on the device
+@param[in]  filepos_in  Previous returned value from calling this function
+@return Position of file pointer after reading in a single ciphertext
+*/
+std::streampos ct_bin_file_load(std::string fpath, const seal::SEALContext &context,
+                                seal::Evaluator &evaluator, seal::Ciphertext &ct, bool packed,
+                                bool seeded, std::streampos filepos_in = 0);
+
 // ==============================================================
 //                      Binary file save/load
 //                         (SEAL format)
@@ -204,6 +244,40 @@ std::streampos ct_string_file_load(std::string fpath, const seal::SEALContext &c
                                    seal::Evaluator &evaluator, seal::Ciphertext &ct,
                                    std::streampos filepos_in = 0);
 
+/**
+Regenerates component c1 (i.e., the uniform random polynomial 'a') of a seeded symmetric ciphertext
+for a single prime, in the same way as sample_poly_uniform in SEAL-Embedded (see:
+SE_ENABLE_SYM_SEED_CT in the device library's user_defines.h). Only seed version 1 (SHAKE256) is
+supported.
+
+@param[in]  header   Seeded ciphertext header: seed version (1 byte), followed by the seed
+@param[in]  counter  Index of the prime in the order the primes were sent
+@param[in]  q        Modulus of the prime
+@param[in]  n        Polynomial ring degree
+@param[out] c1       Regenerated values of c1 (n values)
+*/
+void seeded_ct_expand_c1(const std::vector<uint8_t> &header, std::uint64_t counter,
+                         const seal::Modulus &q, std::size_t n, std::uint64_t *c1);
+
+/**
+Load a freshly encrypted seeded symmetric ciphertext from a string file, regenerating c1 for each
+prime from the seed (see: seeded_ct_expand_c1). Seeded CT objects should be formatted as follows:
+
+seed : { v, x, x, x, x}  --> seed version, followed by the seed
+ct0  : { x, x, x, x, x}
+ct0  : { x, x, x, x, x}  --> w.r.t. next prime
+
+@param[in]  fpath       Path to string file containing values of ciphertext.
+@param[in]  context     SEAL context
+@param[in]  evaluator   SEAL evaluator
+@param[out] ct          Ciphertext object to load values into
+@param[in]  filepos_in  Previous returned value from calling this function
+@return Position of file pointer after reading in a single ciphertext
+*/
+std::streampos ct_seeded_string_file_load(std::string fpath, const seal::SEALContext &context,
+                                          seal::Evaluator &evaluator, seal::Ciphertext &ct,
+                                          std::streampos filepos_in = 0);
+
 /**
 Load a polynomial object from a string file.
 String file objects should be formatted as follows (values in [] are optional):
@@ -154,7 +154,7 @@ void gen_save_ifft_roots(string dirpath, const SEALContext &context, bool high_b
         file2 << "#if defined(SE_DATA_FROM_CODE_COPY) || "
                  "defined(SE_DATA_FROM_CODE_DIRECT)\n";
         file2 << "#ifdef SE_IFFT_LOAD_FULL\n";
-        file2 << "#ifdef SE_DATA_FROM_CODE_COPY\nconst\n#endif" << endl;
+        file2 << "const" << endl;
         file2 << "// -- IFFT roots for polynomial ring degree = " << n << "\n";
         // -- Save using uint64_t instead of double to maintain full precision
         file2 << "uint64_t ifft_roots_save[" << num_uint64_elements << "] = { ";
@@ -235,12 +235,12 @@ void gen_save_ntt_roots_header(string dirpath, const SEALContext &context, bool
         }
         if (outer == 1) file << "#endif\n";
     }
-    file << "\nZZ* " << ntt_str << "_roots_addr[" << string_file_nprimes << "] =\n{\n";
+    file << "\nconst ZZ *const " << ntt_str << "_roots_addr[" << string_file_nprimes << "] =\n{\n";
 
     // -- No need to include special prime in string files
     for (size_t t = 0; t < string_file_nprimes; t++)
     {
-        file << "  &(((ZZ*)(" << ntt_str << "_roots_save_prime" << to_string(t) << "))[0])";
+        file << "  &(((const ZZ *)(" << ntt_str << "_roots_save_prime" << to_string(t) << "))[0])";
         if (t == string_file_nprimes - 1)
             file << "\n};" << endl;
         else
@@ -378,7 +378,7 @@ void gen_save_ntt_roots(string dirpath, const SEALContext &context, bool lazy, b
                 file2 << "// -- Note: This file uses >30-bit primes and cannot";
                 file2 << " be used with the SEAL-Embedded device library." << endl;
             }
-            file2 << "#ifdef SE_DATA_FROM_CODE_COPY\nconst\n#endif" << endl;
+            file2 << "const" << endl;
             if (large_modulus)
                 file2 << "uint64_t ";
             else
@@ -529,7 +529,7 @@ void gen_save_index_map(string dirpath, const SEALContext &context, bool high_by
                 "defined(SE_INDEX_MAP_LOAD_PERSIST) || "
                 "defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)\n";
         file << "#include <stdint.h>\n\n";  // uint64_t ?
-        file << "#ifdef SE_DATA_FROM_CODE_COPY\nconst\n#endif" << endl;
+        file << "const" << endl;
         file << "// -- index map indices for polynomial ring degree = " << n << "\n";
         file << "uint32_t index_map_store[" << n / 2 << "] = { ";
         uint32_t *index_map_str_save = (uint32_t *)index_map;
@@ -48,8 +48,8 @@ void bench_asym(void)
     parms.small_u       = true;  // should be this
 
 #ifdef SE_USE_MALLOC
-    print_ckks_mempool_size(n, 0);
-    ZZ *mempool = ckks_mempool_setup_asym(n);
+    print_ckks_mempool_size(n, nprimes, 0);
+    ZZ *mempool = ckks_mempool_setup_asym(n, nprimes);
 #else
     print_ckks_mempool_size();
     ZZ mempool_local[MEMPOOL_SIZE];
@@ -60,7 +60,7 @@ void bench_asym(void)
     // -- Get pointers
     SE_PTRS se_ptrs_local;
     ckks_set_ptrs_asym(n, mempool, &se_ptrs_local);
-    double complex *conj_vals  = se_ptrs_local.conj_vals;
+    cflpt *conj_vals           = se_ptrs_local.conj_vals;
     int64_t *conj_vals_int     = se_ptrs_local.conj_vals_int_ptr;
     double complex *ifft_roots = se_ptrs_local.ifft_roots;
     ZZ *pk_c0                  = se_ptrs_local.c0_ptr;
@@ -78,6 +78,10 @@ void bench_asym(void)
     // -- Set up parameters and index_map if applicable
     ckks_setup(n, nprimes, index_map, &parms);
 
+    // -- If the public key is resident, load it for every prime ahead of time
+    ZZ *pk_cache = se_ptrs_local.pk_ptr;
+    if (pk_cache) ckks_setup_pk(&parms, pk_cache);
+
     const char *bench_name = "Asymmetric_Encryption";
     print_bench_banner(bench_name, &parms);
 
@@ -116,8 +120,8 @@ void bench_asym(void)
 #if defined(SE_BENCH_ENCRYPT) || defined(SE_BENCH_FULL)
             reset_start_timer(&timer);
 #endif
-            ckks_encode_encrypt_asym(&parms, conj_vals_int, u, e1, ntt_roots, ntt_u_e1_pte, NULL,
-                                     NULL, pk_c0, pk_c1);
+            ckks_encode_encrypt_asym(&parms, conj_vals_int, u, e1, pk_cache, ntt_roots,
+                                     ntt_u_e1_pte, NULL, NULL, pk_c0, pk_c1);
 
 #if defined(SE_BENCH_ENCRYPT) || defined(SE_BENCH_FULL)
             stop_timer(&timer);
@@ -113,6 +113,47 @@ static inline void print_time_vals(const char *name, float time_curr, size_t num
     }
 }
 
+/**
+Clock frequency of the target (in MHz), used to convert runtimes to cycle counts. The generic value
+is only nominal: set this to the clock frequency of the host for meaningful cycle counts.
+*/
+#ifndef SE_BENCH_CPU_FREQ_MHZ
+#ifdef SE_ON_SPHERE_A7
+#define SE_BENCH_CPU_FREQ_MHZ 500
+#elif defined(SE_ON_SPHERE_M4)
+#define SE_BENCH_CPU_FREQ_MHZ 197.6
+#elif defined(SE_ON_NRF5)
+#define SE_BENCH_CPU_FREQ_MHZ 64
+#else
+#define SE_BENCH_CPU_FREQ_MHZ 3000
+#endif
+#endif
+
+/**
+Prints the (approximate) number of cycles per polynomial coefficient for a runtime.
+
+@param[in] name     Benchmark name
+@param[in] time_us  Runtime in microseconds (e.g., the minimum runtime)
+@param[in] n        Number of coefficients processed in 'time_us'
+*/
+static inline void print_cycles_per_coeff(const char *name, float time_us, size_t n)
+{
+    float cycles = time_us * (float)SE_BENCH_CPU_FREQ_MHZ;
+    printf("-- Cycles per coefficient (%s) --\n", name);
+    printf("cycles/coeff = %0.2f (min runtime at %0.1f MHz)\n", cycles / (float)n,
+           (float)SE_BENCH_CPU_FREQ_MHZ);
+}
+
+/**
+Prints the throughput of a benchmark that generates or processes 'nbytes' bytes in 'time_us'
+microseconds.
+*/
+static inline void print_throughput(const char *name, float time_us, size_t nbytes)
+{
+    printf("-- Throughput (%s) --\n", name);
+    printf("MB/s = %0.2f (min runtime)\n", (float)nbytes / time_us);
+}
+
 static inline void set_print_time_vals(const char *name, float time_curr, size_t num_runs,
                                        float *time_total, float *time_min, float *time_max)
 {
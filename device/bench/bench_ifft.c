@@ -72,7 +72,7 @@ void bench_ifft(void)
 #endif
 
     Parms parms;
-    ckks_setup(n, 1, NULL, &parms);
+    set_parms_ckks(n, 1, &parms);
 
 #ifdef SE_BENCH_IFFT_ROOTS
     const char *bench_name = "inverse fft (timing roots load/gen)";
@@ -100,9 +100,9 @@ void bench_ifft(void)
         reset_start_timer(&timer);
 #endif
         // -- Load or generate the roots --
+        const double complex *roots = ifft_roots;
 #ifdef SE_IFFT_LOAD_FULL
-        se_assert(ifft_roots);
-        load_ifft_roots(n, ifft_roots);
+        roots = load_ifft_roots(n, ifft_roots);
 #endif
 
 #ifdef SE_BENCH_IFFT_ROOTS
@@ -113,7 +113,7 @@ void bench_ifft(void)
 #endif
 
         // -- Ifft computation --
-        ifft_inpl(vec, n, logn, ifft_roots);
+        ifft_inpl(vec, n, logn, roots);
 
 #if defined(SE_BENCH_IFFT_COMP) || defined(SE_BENCH_IFFT_FULL)
         stop_timer(&timer);
@@ -137,6 +137,77 @@ void bench_ifft(void)
 
     delete_parameters(&parms);
 }
+
+/**
+Times the real-input IFFT used by the encoder, in double and single precision (see:
+SE_IFFT_PRECISION_TYPE), next to the full IFFT (if SE_IFFT_OTF is defined).
+*/
+void bench_ifft_real(void)
+{
+#ifdef SE_USE_MALLOC
+    const PolySizeType n = 4096;
+    double complex *vec  = calloc(n, sizeof(double complex));
+#else
+    const PolySizeType n = SE_DEGREE_N;
+    double complex vec[SE_DEGREE_N];
+    memset(&vec, 0, n * sizeof(double complex));
+#endif
+    size_t logn = get_log2(n);
+
+    // -- The real-input IFFTs only use the first half of vec
+    double *vec_real = (double *)vec;
+    float *vec_float = (float *)vec;
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+
+    const char *bench_names[3] = {"inverse fft (real input, double precision, on-the-fly)",
+                                  "inverse fft (real input, single precision, on-the-fly)",
+                                  "inverse fft (full, double precision, on-the-fly)"};
+#ifdef SE_IFFT_OTF
+    const size_t ntypes = 3;
+#else
+    const size_t ntypes = 0;
+    printf("IFFT type is not on-the-fly. Skipping real-input IFFT bench.\n");
+#endif
+
+    Timer timer;
+    const size_t COUNT = 10;
+    for (size_t type = 0; type < ntypes; type++)
+    {
+        const char *bench_name = bench_names[type];
+        print_bench_banner(bench_name, &parms);
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            gen_double_complex_half_vec(vec, pow(10, 6), n);
+            if (type == 1)
+            {
+                for (size_t i = 0; i < n; i++) vec_float[i] = (float)vec_real[i];
+            }
+            reset_start_timer(&timer);
+
+            switch (type)
+            {
+                case 0: ifft_real_inpl(vec_real, n, logn, 0); break;
+                case 1: ifft_real_float_inpl(vec_float, n, logn); break;
+                default: ifft_inpl(vec, n, logn, 0); break;
+            }
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_cycles_per_coeff(bench_name, t_min, n);
+        print_bench_banner(bench_name, &parms);
+    }
+
+#ifdef SE_USE_MALLOC
+    free(vec);
+#endif
+    delete_parameters(&parms);
+}
 #endif
 
 #ifndef SE_USE_MALLOC
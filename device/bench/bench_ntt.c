@@ -15,6 +15,7 @@
 #include "ckks_common.h"
 #include "fileops.h"
 #include "ntt.h"
+#include "ntt_simd.h"
 #include "parameters.h"
 #include "timer.h"
 #include "util_print.h"
@@ -76,7 +77,7 @@ void bench_ntt(void)
 
     Parms parms;
     parms.nprimes = 1;
-    ckks_setup(n, 1, NULL, &parms);
+    set_parms_ckks(n, 1, &parms);
 
 #ifdef SE_BENCH_NTT_ROOTS
     const char *bench_name = "ntt (timing roots load/gen)";
@@ -128,6 +129,7 @@ void bench_ntt(void)
     }
 
     print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+    print_cycles_per_coeff(bench_name, t_min, n);
     print_bench_banner(bench_name, &parms);
 
 #ifdef SE_USE_MALLOC
@@ -140,6 +142,81 @@ void bench_ntt(void)
 
     delete_parameters(&parms);
 }
+
+/**
+Compares the scalar "fast" NTT against the "fast" NTT variant selected by ntt_inpl (computation
+only), i.e., the SIMD NTT if SE_NTT_SIMD_X86 or SE_NTT_SIMD_ARM is defined, or the merged-layer NTT
+if SE_NTT_FAST_MERGED is defined. Only runs if SE_NTT_FAST is defined.
+*/
+void bench_ntt_fast(void)
+{
+#ifndef SE_NTT_FAST
+    printf("Fast NTT is not enabled. Skipping fast NTT benchmark.\n");
+#else
+#ifdef SE_USE_MALLOC
+    const PolySizeType n = 4096;
+    ZZ *mempool          = calloc(3 * n, sizeof(ZZ));
+#else
+    const PolySizeType n = SE_DEGREE_N;
+    ZZ mempool[3 * SE_DEGREE_N];
+    memset(&mempool, 0, 3 * SE_DEGREE_N * sizeof(ZZ));
+#endif
+    ZZ *vec       = mempool;
+    ZZ *ntt_roots = &(mempool[n]);
+
+    Parms parms;
+    parms.nprimes = 1;
+    set_parms_ckks(n, 1, &parms);
+    ntt_roots_initialize(&parms, ntt_roots);
+
+#ifdef SE_NTT_FAST_MERGED
+    const char *bench_names[2] = {"ntt (scalar fast computation)", "ntt (merged fast computation)"};
+#else
+    const char *bench_names[2] = {"ntt (scalar fast computation)", "ntt (simd fast computation)"};
+#endif
+#ifdef SE_NTT_SIMD_X86
+    SE_SIMD_LEVEL simd_level = ntt_simd_level();
+    printf("Simd level: %s\n", simd_level == SE_SIMD_AVX512 ? "AVX-512"
+                                : simd_level == SE_SIMD_AVX2 ? "AVX2"
+                                                             : "none");
+#endif
+
+    Timer timer;
+    const size_t COUNT = 10;
+    for (size_t type = 0; type < 2; type++)
+    {
+        const char *bench_name = bench_names[type];
+        print_bench_banner(bench_name, &parms);
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            random_zzq_poly(vec, n, parms.curr_modulus);
+            reset_start_timer(&timer);
+
+            if (type == 0)
+                ntt_fast_ref_inpl(&parms, (MUMO *)ntt_roots, vec);
+            else
+                ntt_inpl(&parms, ntt_roots, vec);
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_cycles_per_coeff(bench_name, t_min, n);
+        print_bench_banner(bench_name, &parms);
+    }
+
+#ifdef SE_USE_MALLOC
+    if (mempool)
+    {
+        free(mempool);
+        mempool = 0;
+    }
+#endif
+    delete_parameters(&parms);
+#endif
+}
 #endif
 
 #ifdef SE_USE_MALLOC
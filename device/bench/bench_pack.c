@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_pack.c
+*/
+
+#include "defines.h"
+#ifdef SE_ENABLE_TIMERS
+#include "bench_common.h"
+#include "modulus.h"
+#include "pack.h"
+#include "sample.h"
+#include "timer.h"
+#include "util_print.h"
+
+/**
+Times poly_pack_inpl on a uniform random polynomial for a 30-bit and a 27-bit prime (see:
+SE_ENABLE_PACKED_CT), and prints the number of bytes saved per ciphertext component.
+*/
+void bench_poly_pack(void)
+{
+#ifdef SE_USE_MALLOC
+    const size_t n = 4096;
+    ZZ *vec        = calloc(2 * n, sizeof(ZZ));
+#else
+    const size_t n = SE_DEGREE_N;
+    ZZ vec[2 * SE_DEGREE_N];
+#endif
+    ZZ *poly      = &(vec[0]);
+    ZZ *poly_orig = &(vec[n]);
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    Modulus modulus_27bit;
+    set_modulus(134012929, &modulus_27bit);
+    Modulus *moduli[2] = {parms.curr_modulus, &modulus_27bit};
+
+    const char *bench_name = "poly pack (in place)";
+    print_bench_banner(bench_name, &parms);
+
+    SE_PRNG prng;
+    prng_randomize_reset(&prng, NULL);
+    for (size_t m = 0; m < 2; m++)
+    {
+        parms.curr_modulus = moduli[m];
+        size_t nbits       = packed_bit_count(parms.curr_modulus);
+        sample_poly_uniform(&parms, &prng, poly_orig);
+
+        Timer timer;
+        const size_t COUNT = 10;
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        size_t nbytes = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            memcpy(poly, poly_orig, n * sizeof(ZZ));
+            reset_start_timer(&timer);
+
+            nbytes = poly_pack_inpl(poly, n, nbits);
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_throughput(bench_name, t_min, n * sizeof(ZZ));
+
+        size_t nbytes_raw = n * sizeof(ZZ);
+        printf("q: %" PRIu32 " (%zu bits)\n", parms.curr_modulus->value, nbits);
+        printf("bytes per component: %zu raw, %zu packed (%zu saved, %0.2f%%)\n", nbytes_raw,
+               nbytes, nbytes_raw - nbytes, 100.0 * (double)(nbytes_raw - nbytes) / nbytes_raw);
+        printf("pack cost per byte saved (min): %0.4f us\n", t_min / (nbytes_raw - nbytes));
+    }
+#ifdef SE_USE_MALLOC
+    free(vec);
+    delete_parameters(&parms);
+#endif
+}
+#endif
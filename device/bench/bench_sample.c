@@ -7,8 +7,11 @@
 
 #include "defines.h"
 #ifdef SE_ENABLE_TIMERS
+#include "aes256ctr.h"
 #include "bench_common.h"
+#include "chacha20.h"
 #include "sample.h"
+#include "shake256/fips202.h"
 #include "timer.h"
 #include "util_print.h"
 
@@ -97,8 +100,64 @@ void bench_sample_ternary_small(void)
 #endif
 }
 
+/**
+Times sample_poly_uniform and prints its throughput (in bytes of output polynomial) for each
+polynomial ring degree from 4096 to 16384 (only n = SE_DEGREE_N if SE_USE_MALLOC is not defined).
+*/
 void bench_sample_uniform(void)
 {
+#ifdef SE_USE_MALLOC
+    const size_t n_max = 16384;
+    ZZ *vec            = calloc(n_max, sizeof(ZZ));
+    for (size_t n = 4096; n <= n_max; n *= 2)
+    {
+#else
+    ZZ vec[SE_DEGREE_N];
+    {
+        const size_t n = SE_DEGREE_N;
+#endif
+        Parms parms;
+        set_parms_ckks(n, 1, &parms);
+
+        ZZ *poly               = &(vec[0]);
+        const char *bench_name = "sample poly uniform";
+        print_bench_banner(bench_name, &parms);
+
+        SE_PRNG prng;
+        prng_randomize_reset(&prng, NULL);
+
+        Timer timer;
+        const size_t COUNT = 10;
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            reset_start_timer(&timer);
+
+            sample_poly_uniform(&parms, &prng, poly);
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+            print_poly_full("uniform poly", poly, n);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_throughput(bench_name, t_min, n * sizeof(ZZ));
+#ifdef SE_USE_MALLOC
+        delete_parameters(&parms);
+#endif
+    }
+#ifdef SE_USE_MALLOC
+    free(vec);
+#endif
+}
+
+/**
+Counts the Keccak-f[1600] permutations needed to sample one polynomial, for each sampler (averaged
+over several polynomials, since the number of rejections varies). The 4-way permutations of the
+cbd samplers (see: prng_fill_buffer_x4) count as 4 permutations each.
+*/
+void bench_sample_keccak_permutations(void)
+{
 #ifdef SE_USE_MALLOC
     const size_t n = 4096;
     ZZ *vec        = calloc(n, sizeof(ZZ));
@@ -110,36 +169,40 @@ void bench_sample_uniform(void)
     Parms parms;
     set_parms_ckks(n, 1, &parms);
 
-    ZZ *poly               = &(vec[0]);
-    const char *bench_name = "sample poly uniform";
-    print_bench_banner(bench_name, &parms);
+    const char *bench_names[4] = {"sample poly uniform", "sample poly ternary",
+                                  "sample poly ternary (small)", "sample poly cbd"};
+    print_bench_banner("keccak permutations per polynomial sample", &parms);
 
     SE_PRNG prng;
     prng_randomize_reset(&prng, NULL);
 
-    Timer timer;
-    const size_t COUNT = 10;
-    float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
-    for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+    const size_t COUNT = 100;
+    for (size_t type = 0; type < 4; type++)
     {
-        reset_start_timer(&timer);
-
-        sample_poly_uniform(&parms, &prng, poly);
-
-        stop_timer(&timer);
-        t_curr = read_timer(timer, MICRO_SEC);
-        if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
-        print_poly_full("uniform poly", poly, n);
+        uint64_t count_start = se_keccak_permutation_count;
+        for (size_t b_itr = 0; b_itr < COUNT; b_itr++)
+        {
+            switch (type)
+            {
+                case 0: sample_poly_uniform(&parms, &prng, vec); break;
+                case 1: sample_poly_ternary(&parms, &prng, vec); break;
+                case 2: sample_small_poly_ternary_prng_96(n, &prng, vec); break;
+                default: sample_poly_cbd_generic_prng_16(n, &prng, (int8_t *)vec); break;
+            }
+        }
+        double count = (double)(se_keccak_permutation_count - count_start) / (double)COUNT;
+        printf("-- Keccak permutations (%s) --\n", bench_names[type]);
+        printf("per polynomial  = %0.2f\n", count);
+        printf("per coefficient = %0.4f\n", count / (double)n);
     }
-    print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
 #ifdef SE_USE_MALLOC
     if (vec)
     {
         free(vec);
         vec = 0;
     }
-    delete_parameters(&parms);
 #endif
+    delete_parameters(&parms);
 }
 
 void bench_prng_randomize_seed(void)
@@ -207,6 +270,112 @@ void bench_prng_fill_buffer(void)
 #endif
 }
 
+/**
+Times the PRNG output used by the cbd samplers (i.e., 96-byte prng_fill_buffer calls) for a full
+polynomial, generated one call at a time and 4 calls at a time (see: prng_fill_buffer_x4).
+*/
+void bench_prng_fill_buffer_x4(void)
+{
+    const size_t n      = 4096;
+    const size_t nbytes = 6 * n;  // 6 bytes per cbd sample
+#ifdef SE_USE_MALLOC
+    uint8_t *buffer = calloc(nbytes, sizeof(uint8_t));
+#else
+    uint8_t buffer[6 * 4096];
+#endif
+
+    SE_PRNG prng;
+    prng_randomize_reset(&prng, NULL);
+
+    const char *bench_names[2] = {"prng fill buffer (96 bytes x 1)",
+                                  "prng fill buffer (96 bytes x 4)"};
+
+    Timer timer;
+    const size_t COUNT = 10;
+    for (size_t type = 0; type < 2; type++)
+    {
+        const char *bench_name = bench_names[type];
+        print_bench_banner(bench_name, 0);
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            reset_start_timer(&timer);
+
+            if (type == 0)
+            {
+                for (size_t i = 0; i < nbytes; i += 96) prng_fill_buffer(96, &prng, &(buffer[i]));
+            }
+            else
+            {
+                for (size_t i = 0; i < nbytes; i += 4 * 96)
+                { prng_fill_buffer_x4(96, &prng, &(buffer[i])); }
+            }
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_throughput(bench_name, t_min, nbytes);
+    }
+#ifdef SE_USE_MALLOC
+    free(buffer);
+#endif
+}
+
+/**
+Times the expansion of a seed into the random bytes for a uniform polynomial (4 bytes per
+coefficient) with each PRNG backend (see: SE_PRNG_TYPE), independent of the configured one.
+*/
+void bench_prng_backends(void)
+{
+    const size_t n      = 4096;
+    const size_t nbytes = 4 * n;
+#ifdef SE_USE_MALLOC
+    uint8_t *buffer = calloc(nbytes, sizeof(uint8_t));
+#else
+    uint8_t buffer[4 * 4096];
+#endif
+
+    SE_PRNG prng;
+    prng_randomize_reset(&prng, NULL);
+    uint8_t seed_ext[SE_PRNG_SEED_BYTE_COUNT + 8];
+    memcpy(&(seed_ext[0]), &(prng.seed[0]), SE_PRNG_SEED_BYTE_COUNT);
+    memcpy(&(seed_ext[SE_PRNG_SEED_BYTE_COUNT]), &(prng.counter), 8);
+
+    const char *bench_names[3] = {"prng backend: shake256", "prng backend: aes-256-ctr",
+                                  "prng backend: chacha20"};
+
+    Timer timer;
+    const size_t COUNT = 10;
+    for (size_t type = 0; type < 3; type++)
+    {
+        const char *bench_name = bench_names[type];
+        print_bench_banner(bench_name, 0);
+        float t_total = 0, t_min = 0, t_max = 0, t_curr = 0;
+        for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+        {
+            reset_start_timer(&timer);
+
+            switch (type)
+            {
+                case 0: shake256(buffer, nbytes, seed_ext, sizeof(seed_ext)); break;
+                case 1: aes256ctr_prf(buffer, nbytes, prng.seed, prng.counter); break;
+                case 2: chacha20_prf(buffer, nbytes, prng.seed, prng.counter); break;
+            }
+
+            stop_timer(&timer);
+            t_curr = read_timer(timer, MICRO_SEC);
+            if (b_itr) set_print_time_vals(bench_name, t_curr, b_itr, &t_total, &t_min, &t_max);
+        }
+        print_time_vals(bench_name, t_curr, COUNT, &t_total, &t_min, &t_max);
+        print_throughput(bench_name, t_min, nbytes);
+    }
+#ifdef SE_USE_MALLOC
+    free(buffer);
+#endif
+}
+
 void bench_prng_randomize_seed_fill_buffer(void)
 {
     const char *bench_name = "prng randomize + fill buffer";
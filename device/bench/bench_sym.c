@@ -45,8 +45,8 @@ void bench_sym(void)
     if (!parms.sample_s) se_assert(parms.small_s);
 
 #ifdef SE_USE_MALLOC
-    print_ckks_mempool_size(n, 1);
-    ZZ *mempool = ckks_mempool_setup_sym(n);
+    print_ckks_mempool_size(n, nprimes, 1);
+    ZZ *mempool = ckks_mempool_setup_sym(n, nprimes);
 #else
     print_ckks_mempool_size();
     ZZ mempool_local[MEMPOOL_SIZE];
@@ -57,7 +57,7 @@ void bench_sym(void)
     // -- Get pointers
     SE_PTRS se_ptrs_local;
     ckks_set_ptrs_sym(n, mempool, &se_ptrs_local);
-    double complex *conj_vals  = se_ptrs_local.conj_vals;
+    cflpt *conj_vals           = se_ptrs_local.conj_vals;
     int64_t *conj_vals_int     = se_ptrs_local.conj_vals_int_ptr;
     double complex *ifft_roots = se_ptrs_local.ifft_roots;
     ZZ *c0                     = se_ptrs_local.c0_ptr;
@@ -79,6 +79,10 @@ void bench_sym(void)
     // -- If we are testing and sample s is set, this will also sample s
     ckks_setup_s(&parms, NULL, &prng, s);
 
+    // -- If ntt(s) is resident, compute it for every prime ahead of time too
+    ZZ *ntt_s_cache = se_ptrs_local.ntt_s_ptr;
+    if (ntt_s_cache) ckks_setup_ntt_s(&parms, s, ntt_roots, ntt_s_cache);
+
     const char *bench_name = "Symmetric_Encryption";
     print_bench_banner(bench_name, &parms);
 
@@ -121,8 +125,8 @@ void bench_sym(void)
             reset_start_timer(&timer);
 #endif
             // -- Per prime Encode + Encrypt
-            ckks_encode_encrypt_sym(&parms, conj_vals_int, 0, &shareable_prng, s, ntt_pte,
-                                    ntt_roots, c0, c1, 0, 0);
+            ckks_encode_encrypt_sym(&parms, conj_vals_int, 0, &shareable_prng, s, ntt_s_cache,
+                                    ntt_pte, ntt_roots, c0, c1, 0, 0);
 
 #if defined(SE_BENCH_ENCRYPT) || defined(SE_BENCH_FULL)
             stop_timer(&timer);
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_sym_batch.c
+
+Compares the throughput of encrypting a batch of vectors with se_encrypt_batch against calling
+se_encrypt once per vector. Requires SE_USE_MALLOC.
+*/
+
+#include "defines.h"
+#if defined(SE_ENABLE_TIMERS) && defined(SE_USE_MALLOC)
+#include <stdbool.h>
+
+#include "bench_common.h"
+#include "seal_embedded.h"
+#include "timer.h"
+
+// -- Configuration
+#define SE_BENCH_BATCH_COUNT 32  // Number of vectors per batch
+
+static size_t bench_sym_batch_nop_send(void *v, size_t vlen_bytes)
+{
+    SE_UNUSED(v);
+    return vlen_bytes;
+}
+
+void bench_sym_batch(void)
+{
+    const size_t n       = 4096;
+    const size_t nprimes = 3;
+    const size_t vlen    = n / 2;
+    const size_t count   = SE_BENCH_BATCH_COUNT;
+
+    SE_PARMS *se_parms = se_setup(n, nprimes, pow(2, 25), SE_SYM_ENCR);
+    flpt *v            = calloc(count * vlen, sizeof(flpt));
+    se_assert(se_parms && v);
+    const void *vecs[SE_BENCH_BATCH_COUNT];
+    for (size_t b = 0; b < count; b++)
+    {
+        gen_flpt_quarter_poly(&(v[b * vlen]), -10, vlen);
+        vecs[b] = &(v[b * vlen]);
+    }
+
+    const char *bench_name = "Symmetric_Encryption_Batch";
+    print_bench_banner(bench_name, se_parms->parms);
+
+    Timer timer;
+    const size_t COUNT = 5;
+    float t_single_total = 0, t_single_min = 0, t_single_max = 0, t_single_curr = 0;
+    float t_batch_total = 0, t_batch_min = 0, t_batch_max = 0, t_batch_curr = 0;
+    for (size_t b_itr = 0; b_itr < COUNT + 1; b_itr++)
+    {
+        // -- One se_encrypt call per vector
+        reset_start_timer(&timer);
+        for (size_t b = 0; b < count; b++)
+        {
+            bool ret = se_encrypt(&bench_sym_batch_nop_send, (void *)vecs[b], vlen * sizeof(flpt),
+                                  false, se_parms);
+            se_assert(ret);
+            SE_UNUSED(ret);
+        }
+        stop_timer(&timer);
+        t_single_curr = read_timer(timer, MICRO_SEC);
+
+        // -- One se_encrypt_batch call for all vectors
+        reset_start_timer(&timer);
+        bool ret = se_encrypt_batch(&bench_sym_batch_nop_send, vecs, count, vlen * sizeof(flpt),
+                                    se_parms);
+        stop_timer(&timer);
+        se_assert(ret);
+        SE_UNUSED(ret);
+        t_batch_curr = read_timer(timer, MICRO_SEC);
+
+        // -- Skip the first (warm-up) iteration
+        if (b_itr)
+        {
+            set_time_vals(t_single_curr, &t_single_total, &t_single_min, &t_single_max);
+            set_time_vals(t_batch_curr, &t_batch_total, &t_batch_min, &t_batch_max);
+        }
+    }
+
+    print_time_vals("se_encrypt (per batch)", t_single_curr, COUNT, &t_single_total,
+                    &t_single_min, &t_single_max);
+    print_time_vals("se_encrypt_batch (per batch)", t_batch_curr, COUNT, &t_batch_total,
+                    &t_batch_min, &t_batch_max);
+
+    float ct_per_sec_single = (float)(count * COUNT) * 1e6f / t_single_total;
+    float ct_per_sec_batch  = (float)(count * COUNT) * 1e6f / t_batch_total;
+    printf("\n-- Throughput (%zu vectors per batch) --\n", count);
+    printf("se_encrypt       : ciphertexts/sec = %0.2f\n", ct_per_sec_single);
+    printf("se_encrypt_batch : ciphertexts/sec = %0.2f (%0.2fx)\n", ct_per_sec_batch,
+           ct_per_sec_batch / ct_per_sec_single);
+    print_bench_banner(bench_name, se_parms->parms);
+
+    free(v);
+    se_cleanup(se_parms);
+}
+#endif
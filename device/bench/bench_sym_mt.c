@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_sym_mt.c
+
+Multi-threaded throughput benchmark for the symmetric encryption API. Each thread owns its own
+SE_PARMS instance and encrypts back-to-back. Only runs on native builds (requires pthreads and
+SE_USE_MALLOC).
+*/
+
+#include "defines.h"
+#if defined(SE_ENABLE_TIMERS) && defined(SE_USE_MALLOC) && !defined(SE_ON_SPHERE_M4) && \
+    !defined(SE_ON_NRF5)
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "bench_common.h"
+#include "seal_embedded.h"
+
+// -- Configuration
+#define SE_BENCH_MT_MAX_THREADS 8
+#define SE_BENCH_MT_COUNT 20  // Number of encryptions per thread
+
+/**
+Per-thread benchmark state.
+
+@param se_parms  SE_PARMS instance owned by this thread
+@param v         Values to encrypt
+@param vlen      Number of values in v
+@param ok        Set to 1 if all encryptions succeeded
+*/
+typedef struct
+{
+    SE_PARMS *se_parms;
+    flpt *v;
+    size_t vlen;
+    bool ok;
+} BenchSymMtArgs;
+
+static size_t bench_sym_mt_nop_send(void *v, size_t vlen_bytes)
+{
+    SE_UNUSED(v);
+    return vlen_bytes;
+}
+
+static void *bench_sym_mt_worker(void *arg)
+{
+    BenchSymMtArgs *args = (BenchSymMtArgs *)arg;
+    args->ok             = true;
+    for (size_t i = 0; i < SE_BENCH_MT_COUNT; i++)
+    {
+        args->ok &= se_encrypt(&bench_sym_mt_nop_send, args->v, args->vlen * sizeof(flpt), false,
+                               args->se_parms);
+    }
+    return NULL;
+}
+
+static double bench_sym_mt_wall_time_sec(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+void bench_sym_mt(void)
+{
+    const size_t n       = 4096;
+    const size_t nprimes = 3;
+    const size_t vlen    = n / 2;
+    double scale         = pow(2, 25);
+
+    const char *bench_name = "Symmetric_Encryption_Multithreaded";
+    print_bench_banner(bench_name, NULL);
+
+    SE_PARMS *se_parms[SE_BENCH_MT_MAX_THREADS];
+    BenchSymMtArgs args[SE_BENCH_MT_MAX_THREADS];
+    pthread_t threads[SE_BENCH_MT_MAX_THREADS];
+    for (size_t t = 0; t < SE_BENCH_MT_MAX_THREADS; t++)
+    {
+        se_parms[t]  = se_setup(n, nprimes, scale, SE_SYM_ENCR);
+        args[t].v    = calloc(vlen, sizeof(flpt));
+        args[t].vlen = vlen;
+        se_assert(se_parms[t] && args[t].v);
+        gen_flpt_quarter_poly(args[t].v, -10, vlen);
+        args[t].se_parms = se_parms[t];
+    }
+
+    double ct_per_sec_single = 0;
+    for (size_t nthreads = 1; nthreads <= SE_BENCH_MT_MAX_THREADS; nthreads *= 2)
+    {
+        double start = bench_sym_mt_wall_time_sec();
+        for (size_t t = 0; t < nthreads; t++)
+        {
+            int rc = pthread_create(&(threads[t]), NULL, &bench_sym_mt_worker, &(args[t]));
+            se_assert(!rc);
+            SE_UNUSED(rc);
+        }
+        for (size_t t = 0; t < nthreads; t++)
+        {
+            pthread_join(threads[t], NULL);
+            se_assert(args[t].ok);
+        }
+        double elapsed = bench_sym_mt_wall_time_sec() - start;
+
+        double ct_per_sec = (double)(nthreads * SE_BENCH_MT_COUNT) / elapsed;
+        if (nthreads == 1) ct_per_sec_single = ct_per_sec;
+        printf("-- threads: %2zu, ciphertexts: %4zu, wall time (ms) = %8.2f, "
+               "ciphertexts/sec = %8.2f, speedup = %0.2fx\n",
+               nthreads, nthreads * SE_BENCH_MT_COUNT, elapsed * 1e3, ct_per_sec,
+               ct_per_sec / ct_per_sec_single);
+    }
+
+    for (size_t t = 0; t < SE_BENCH_MT_MAX_THREADS; t++)
+    {
+        free(args[t].v);
+        se_cleanup(se_parms[t]);
+    }
+    print_bench_banner(bench_name, NULL);
+}
+#endif
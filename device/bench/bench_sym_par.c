@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_sym_par.c
+
+Latency benchmark for encrypting w.r.t. each prime of the modulus chain on a separate thread (see:
+se_encrypt_parallel). For 1 to 8 primes, compares the wall time of se_encrypt with that of
+se_encrypt_parallel with one thread per prime. Only runs on native builds (requires pthreads and
+SE_USE_MALLOC), and only with NTT roots that are computed rather than loaded (there are no root
+files for the additional primes).
+*/
+
+#include "defines.h"
+#if defined(SE_ENABLE_TIMERS) && defined(SE_USE_PTHREADS) && !defined(SE_NTT_REG) && \
+    !defined(SE_NTT_FAST)
+#include <time.h>
+#include <unistd.h>  // sysconf
+
+#include "bench_common.h"
+#include "seal_embedded.h"
+
+// -- Configuration
+#define SE_BENCH_PAR_MAX_PRIMES 8
+#define SE_BENCH_PAR_COUNT 20  // Number of encryptions per measurement
+
+static size_t bench_sym_par_nop_send(void *v, size_t vlen_bytes)
+{
+    SE_UNUSED(v);
+    return vlen_bytes;
+}
+
+static double bench_sym_par_wall_time_sec(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+void bench_sym_par(void)
+{
+    const size_t n    = 4096;
+    const size_t vlen = n / 2;
+    double scale      = pow(2, 25);
+
+    // -- 30-bit primes for n = 4K (the first 3 are the defaults), with their const_ratio values
+    const ZZ modulus_vals[SE_BENCH_PAR_MAX_PRIMES] = {1053818881, 1054015489, 1054212097,
+                                                      1055260673, 1056178177, 1056440321,
+                                                      1058209793, 1060175873};
+    const ZZ ratios[2 * SE_BENCH_PAR_MAX_PRIMES]   = {
+        0x4, 0x135bf4ba, 0x4, 0x132a2218, 0x4, 0x12f85437, 0x4, 0x11ef051e,
+        0x4, 0x11074e88, 0x4, 0x10c52d4a, 0x4, 0x0f07a84a, 0x4, 0x0d1a6142};
+
+    const char *bench_name = "Symmetric_Encryption_Parallel_Primes";
+    print_bench_banner(bench_name, NULL);
+    printf("online cpus: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    flpt *v = calloc(vlen, sizeof(flpt));
+    se_assert(v);
+    gen_flpt_quarter_poly(v, -10, vlen);
+
+    for (size_t nprimes = 1; nprimes <= SE_BENCH_PAR_MAX_PRIMES; nprimes++)
+    {
+        SE_PARMS *se_parms = se_setup_custom(n, nprimes, modulus_vals, ratios, scale, SE_SYM_ENCR);
+        se_assert(se_parms);
+
+        // -- Warm up
+        bool ok = se_encrypt(&bench_sym_par_nop_send, v, vlen * sizeof(flpt), false, se_parms);
+        ok &= se_encrypt_parallel(&bench_sym_par_nop_send, v, vlen * sizeof(flpt), nprimes,
+                                  se_parms);
+
+        double start = bench_sym_par_wall_time_sec();
+        for (size_t i = 0; i < SE_BENCH_PAR_COUNT; i++)
+        {
+            ok &= se_encrypt(&bench_sym_par_nop_send, v, vlen * sizeof(flpt), false, se_parms);
+        }
+        double t_serial = (bench_sym_par_wall_time_sec() - start) / SE_BENCH_PAR_COUNT;
+
+        start = bench_sym_par_wall_time_sec();
+        for (size_t i = 0; i < SE_BENCH_PAR_COUNT; i++)
+        {
+            ok &= se_encrypt_parallel(&bench_sym_par_nop_send, v, vlen * sizeof(flpt), nprimes,
+                                      se_parms);
+        }
+        double t_par = (bench_sym_par_wall_time_sec() - start) / SE_BENCH_PAR_COUNT;
+        se_assert(ok);
+        SE_UNUSED(ok);
+
+        printf("-- primes: %zu, serial (us) = %9.2f, parallel (us) = %9.2f, speedup = %0.2fx\n",
+               nprimes, t_serial * 1e6, t_par * 1e6, t_serial / t_par);
+        se_cleanup(se_parms);
+    }
+
+    free(v);
+    print_bench_banner(bench_name, NULL);
+}
+#endif
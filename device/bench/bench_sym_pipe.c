@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_sym_pipe.c
+
+Throughput benchmark for the two-stage encode-encrypt pipeline (see: SE_PIPELINE). Times each stage
+on its own, and compares the throughput of se_encrypt_batch with that of se_encrypt_pipelined, which
+encodes the next vector on a second thread while the calling thread encrypts the current one. With
+two free cores, the pipeline throughput is bounded by the slower stage. Only runs on native builds
+(requires pthreads and SE_USE_MALLOC).
+*/
+
+#include "defines.h"
+#if defined(SE_ENABLE_TIMERS) && defined(SE_USE_PTHREADS)
+#include <time.h>
+#include <unistd.h>  // sysconf
+
+#include "bench_common.h"
+#include "seal_embedded.h"
+
+// -- Configuration
+#define SE_BENCH_PIPE_COUNT 20  // Number of vectors per measurement
+#define SE_BENCH_PIPE_NSLOTS 2
+
+static size_t bench_sym_pipe_nop_send(void *v, size_t vlen_bytes)
+{
+    SE_UNUSED(v);
+    return vlen_bytes;
+}
+
+static double bench_sym_pipe_wall_time_sec(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+void bench_sym_pipe(void)
+{
+    const size_t n       = 4096;
+    const size_t nprimes = 3;
+    const size_t vlen    = n / 2;
+    size_t vlen_bytes    = vlen * sizeof(flpt);
+    double scale         = pow(2, 25);
+
+    const char *bench_name = "Symmetric_Encryption_Pipelined";
+    print_bench_banner(bench_name, NULL);
+    printf("online cpus: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    SE_PARMS *se_parms = se_setup(n, nprimes, scale, SE_SYM_ENCR);
+    flpt *v            = calloc(SE_BENCH_PIPE_COUNT * vlen, sizeof(flpt));
+    se_assert(se_parms && v);
+    const void *vecs[SE_BENCH_PIPE_COUNT];
+    for (size_t b = 0; b < SE_BENCH_PIPE_COUNT; b++)
+    {
+        gen_flpt_quarter_poly(&(v[b * vlen]), -10, vlen);
+        vecs[b] = &(v[b * vlen]);
+    }
+
+    // -- Time each stage on its own (single-threaded)
+    SE_PIPELINE pipe;
+    bool ok = se_pipeline_alloc(se_parms, 1, &pipe);
+    double t_encode = 0, t_encrypt = 0;
+    for (size_t b = 0; b < SE_BENCH_PIPE_COUNT; b++)
+    {
+        double start = bench_sym_pipe_wall_time_sec();
+        ok &= se_pipeline_encode(NULL, NULL, (void *)vecs[b], vlen_bytes, &pipe);
+        double mid = bench_sym_pipe_wall_time_sec();
+        se_pipeline_encrypt(&bench_sym_pipe_nop_send, &pipe);
+        t_encode += mid - start;
+        t_encrypt += bench_sym_pipe_wall_time_sec() - mid;
+    }
+    se_pipeline_free(&pipe);
+    t_encode /= SE_BENCH_PIPE_COUNT;
+    t_encrypt /= SE_BENCH_PIPE_COUNT;
+    double t_max_stage = (t_encode > t_encrypt) ? t_encode : t_encrypt;
+    printf("-- encode stage (us) = %9.2f, encrypt stage (us) = %9.2f, "
+           "ideal pipeline speedup = %0.2fx\n",
+           t_encode * 1e6, t_encrypt * 1e6, (t_encode + t_encrypt) / t_max_stage);
+
+    // -- Warm up
+    ok &= se_encrypt_batch(&bench_sym_pipe_nop_send, vecs, 2, vlen_bytes, se_parms);
+    ok &= se_encrypt_pipelined(&bench_sym_pipe_nop_send, vecs, 2, vlen_bytes, SE_BENCH_PIPE_NSLOTS,
+                               se_parms);
+
+    double start = bench_sym_pipe_wall_time_sec();
+    ok &= se_encrypt_batch(&bench_sym_pipe_nop_send, vecs, SE_BENCH_PIPE_COUNT, vlen_bytes,
+                           se_parms);
+    double t_serial = bench_sym_pipe_wall_time_sec() - start;
+
+    start = bench_sym_pipe_wall_time_sec();
+    ok &= se_encrypt_pipelined(&bench_sym_pipe_nop_send, vecs, SE_BENCH_PIPE_COUNT, vlen_bytes,
+                               SE_BENCH_PIPE_NSLOTS, se_parms);
+    double t_pipe = bench_sym_pipe_wall_time_sec() - start;
+    se_assert(ok);
+    SE_UNUSED(ok);
+
+    printf("-- batch:     ciphertexts/sec = %8.2f\n", SE_BENCH_PIPE_COUNT / t_serial);
+    printf("-- pipelined: ciphertexts/sec = %8.2f, speedup = %0.2fx (slots: %d)\n",
+           SE_BENCH_PIPE_COUNT / t_pipe, t_serial / t_pipe, SE_BENCH_PIPE_NSLOTS);
+
+    free(v);
+    se_cleanup(se_parms);
+    print_bench_banner(bench_name, NULL);
+}
+#endif
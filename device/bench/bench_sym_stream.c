@@ -0,0 +1,402 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file bench_sym_stream.c
+
+End-to-end latency benchmark for sending symmetric ciphertexts with a blocking send function
+(se_encrypt_batch) versus a non-blocking stream (se_encrypt_stream). A local (loopback) socket pair
+stands in for the transport: a receiver thread emulates a link of SE_BENCH_STREAM_LINK_MBPS by
+sleeping for the transmission time of each block it reads, and small socket buffers make the sender
+feel that back-pressure. The transport threads (the receiver, and the transmit thread of the stream)
+run at real-time priority if allowed, so that on a single core they preempt encryption like DMA or a
+radio would. Latency is measured from the start of encryption to the arrival of the last byte.
+Only runs on native builds (requires pthreads, POSIX sockets, and SE_USE_MALLOC).
+*/
+
+#include "defines.h"
+#if defined(SE_ENABLE_TIMERS) && defined(SE_USE_MALLOC) && !defined(SE_ON_SPHERE_M4) && \
+    !defined(SE_ON_NRF5)
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench_common.h"
+#include "seal_embedded.h"
+
+// -- Configuration
+#define SE_BENCH_STREAM_COUNT 20               // Number of timed encryptions per method
+#define SE_BENCH_STREAM_LINK_MBPS 400          // Emulated link rate (megabits per second)
+#define SE_BENCH_STREAM_SOCK_BUF_BYTES 2048    // Socket buffer sizes (rounded up by the kernel)
+#define SE_BENCH_STREAM_RECV_BLOCK_BYTES 1024  // Bytes read (i.e., "transmitted") at a time
+#define SE_BENCH_STREAM_MAX_PENDING 64         // Capacity of the stream's queue of pending sends
+#define SE_BENCH_STREAM_CHUNK_COUNT 512        // Coefficients of c0 per send
+#define SE_BENCH_STREAM_SLACK_US 250           // Tolerated oversleep of the receiver
+
+static double bench_sym_stream_wall_time_sec(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void bench_sym_stream_sleep_until(double t_sec)
+{
+    double now = bench_sym_stream_wall_time_sec();
+    if (t_sec <= now) return;
+    struct timespec t;
+    t.tv_sec  = (time_t)(t_sec - now);
+    t.tv_nsec = (long)((t_sec - now - (double)t.tv_sec) * 1e9);
+    nanosleep(&t, NULL);
+}
+
+/**
+Raises the priority of the calling thread to real-time, if allowed (otherwise does nothing).
+*/
+static void bench_sym_stream_set_rt_priority(void)
+{
+    struct sched_param sp;
+    sp.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp);
+}
+
+static void bench_sym_stream_write_all(int fd, const void *data, size_t nbytes)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    while (nbytes)
+    {
+        ssize_t ret = write(fd, p, nbytes);
+        se_assert(ret > 0);
+        if (ret <= 0) return;
+        p += ret;
+        nbytes -= (size_t)ret;
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  Receiver (emulated link)
+// ----------------------------------------------------------------------------
+
+/**
+Receiver thread state. The receiver runs for the whole benchmark and receives 'nmsgs' ciphertexts.
+
+@param fd      Receiving end of the connection
+@param nbytes  Number of bytes of each ciphertext
+@param nmsgs   Number of ciphertexts to receive
+@param ndone   Number of ciphertexts received so far
+@param t_done  Time at which the last byte of the last ciphertext was received
+*/
+typedef struct
+{
+    int fd;
+    size_t nbytes;
+    size_t nmsgs;
+    size_t ndone;
+    double t_done;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BenchStreamRx;
+
+static void *bench_sym_stream_receiver(void *arg)
+{
+    BenchStreamRx *rx = (BenchStreamRx *)arg;
+    bench_sym_stream_set_rt_priority();
+    uint8_t buf[SE_BENCH_STREAM_RECV_BLOCK_BYTES];
+    const double sec_per_byte = 8.0 / (SE_BENCH_STREAM_LINK_MBPS * 1e6);
+
+    // -- Each block occupies the link for its transmission time, starting when it is available and
+    //    the link is free. Blocks that arrive within SE_BENCH_STREAM_SLACK_US of the link becoming
+    //    free are treated as back-to-back, so that oversleeping does not slow down the link.
+    const double slack_sec = SE_BENCH_STREAM_SLACK_US * 1e-6;
+    double t_link_free     = 0;
+    for (size_t k = 0; k < rx->nmsgs; k++)
+    {
+        size_t nrecv = 0;
+        while (nrecv < rx->nbytes)
+        {
+            size_t nread = rx->nbytes - nrecv;
+            if (nread > sizeof(buf)) nread = sizeof(buf);
+            ssize_t ret = read(rx->fd, buf, nread);
+            se_assert(ret > 0);
+            if (ret <= 0) return NULL;
+            nrecv += (size_t)ret;
+
+            double now = bench_sym_stream_wall_time_sec();
+            if (t_link_free + slack_sec < now) t_link_free = now;
+            t_link_free += (double)ret * sec_per_byte;
+            bench_sym_stream_sleep_until(t_link_free);
+        }
+
+        pthread_mutex_lock(&(rx->lock));
+        rx->t_done = bench_sym_stream_wall_time_sec();
+        rx->ndone++;
+        pthread_cond_broadcast(&(rx->cond));
+        pthread_mutex_unlock(&(rx->lock));
+    }
+    return NULL;
+}
+
+/**
+Waits until the receiver has received 'ndone' ciphertexts.
+
+@param[in] rx     Receiver thread state
+@param[in] ndone  Number of ciphertexts
+@returns          Time at which the last byte of the ndone-th ciphertext was received
+*/
+static double bench_sym_stream_rx_wait(BenchStreamRx *rx, size_t ndone)
+{
+    pthread_mutex_lock(&(rx->lock));
+    while (rx->ndone < ndone) pthread_cond_wait(&(rx->cond), &(rx->lock));
+    double t_done = rx->t_done;
+    pthread_mutex_unlock(&(rx->lock));
+    return t_done;
+}
+
+// ----------------------------------------------------------------------------
+//  Blocking send
+// ----------------------------------------------------------------------------
+
+static int bench_sym_stream_send_fd     = -1;
+static size_t bench_sym_stream_nbytes   = 0;  // Bytes sent by the last encryption (for counting)
+static bool bench_sym_stream_count_only = false;
+
+static size_t bench_sym_stream_blocking_send(void *v, size_t vlen_bytes)
+{
+    bench_sym_stream_nbytes += vlen_bytes;
+    if (!bench_sym_stream_count_only)
+        bench_sym_stream_write_all(bench_sym_stream_send_fd, v, vlen_bytes);
+    return vlen_bytes;
+}
+
+// ----------------------------------------------------------------------------
+//  Non-blocking stream: a transmit thread drains a queue of pending sends
+// ----------------------------------------------------------------------------
+
+/**
+Transmit thread state (the 'ctx' of the SE_SEND_STREAM).
+
+@param fd        Sending end of the connection
+@param data      Queue of pointers to the data of pending sends
+@param lens      Queue of the sizes of pending sends
+@param head      Index of the oldest pending send
+@param npending  Number of pending sends, including the one being written
+@param quit      Set to 1 to stop the transmit thread
+*/
+typedef struct
+{
+    int fd;
+    const void *data[SE_BENCH_STREAM_MAX_PENDING];
+    size_t lens[SE_BENCH_STREAM_MAX_PENDING];
+    size_t head;
+    size_t npending;
+    bool quit;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BenchStreamTx;
+
+static void *bench_sym_stream_transmitter(void *arg)
+{
+    BenchStreamTx *tx = (BenchStreamTx *)arg;
+    bench_sym_stream_set_rt_priority();
+    pthread_mutex_lock(&(tx->lock));
+    while (true)
+    {
+        while (!tx->npending && !tx->quit) pthread_cond_wait(&(tx->cond), &(tx->lock));
+        if (!tx->npending) break;
+        const void *data = tx->data[tx->head];
+        size_t len       = tx->lens[tx->head];
+        pthread_mutex_unlock(&(tx->lock));
+
+        bench_sym_stream_write_all(tx->fd, data, len);
+
+        pthread_mutex_lock(&(tx->lock));
+        tx->head = (tx->head + 1) % SE_BENCH_STREAM_MAX_PENDING;
+        tx->npending--;
+        pthread_cond_broadcast(&(tx->cond));
+    }
+    pthread_mutex_unlock(&(tx->lock));
+    return NULL;
+}
+
+static size_t bench_sym_stream_tx_send(void *ctx, const void *data, size_t nbytes)
+{
+    BenchStreamTx *tx = (BenchStreamTx *)ctx;
+    pthread_mutex_lock(&(tx->lock));
+    // -- Only blocks if the queue is full
+    while (tx->npending == SE_BENCH_STREAM_MAX_PENDING) pthread_cond_wait(&(tx->cond), &(tx->lock));
+    size_t tail    = (tx->head + tx->npending) % SE_BENCH_STREAM_MAX_PENDING;
+    tx->data[tail] = data;
+    tx->lens[tail] = nbytes;
+    tx->npending++;
+    pthread_cond_broadcast(&(tx->cond));
+    pthread_mutex_unlock(&(tx->lock));
+    return nbytes;
+}
+
+static void bench_sym_stream_tx_wait(void *ctx)
+{
+    BenchStreamTx *tx = (BenchStreamTx *)ctx;
+    pthread_mutex_lock(&(tx->lock));
+    while (tx->npending) pthread_cond_wait(&(tx->cond), &(tx->lock));
+    pthread_mutex_unlock(&(tx->lock));
+}
+
+// ----------------------------------------------------------------------------
+//  Benchmark
+// ----------------------------------------------------------------------------
+
+/**
+Connects a local socket pair with small buffers, to stand in for a transport with a small transmit
+FIFO. (The kernel sizes the buffers of a loopback TCP connection up regardless of SO_SNDBUF, which
+would hide the cost of a blocking send.)
+
+@param[out] send_fd  Sending end
+@param[out] recv_fd  Receiving end
+*/
+static void bench_sym_stream_connect(int *send_fd, int *recv_fd)
+{
+    int fds[2];
+    int ret = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    se_assert(!ret);
+    SE_UNUSED(ret);
+    *send_fd = fds[0];
+    *recv_fd = fds[1];
+
+    int buf_size = SE_BENCH_STREAM_SOCK_BUF_BYTES;
+    setsockopt(*send_fd, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+    setsockopt(*recv_fd, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
+}
+
+void bench_sym_stream(void)
+{
+    const size_t n       = 4096;
+    const size_t nprimes = 3;
+    const size_t vlen    = n / 2;
+
+    SE_PARMS *se_parms = se_setup(n, nprimes, pow(2, 25), SE_SYM_ENCR);
+    flpt *v            = calloc(vlen, sizeof(flpt));
+    se_assert(se_parms && v);
+    gen_flpt_quarter_poly(v, -10, vlen);
+    const void *vecs[1] = {v};
+
+    const char *bench_name = "Symmetric_Encryption_Stream";
+    print_bench_banner(bench_name, se_parms->parms);
+
+    int send_fd, recv_fd;
+    bench_sym_stream_connect(&send_fd, &recv_fd);
+    bench_sym_stream_send_fd = send_fd;
+
+    BenchStreamTx tx;
+    memset(&tx, 0, sizeof(tx));
+    tx.fd = send_fd;
+    pthread_mutex_init(&(tx.lock), NULL);
+    pthread_cond_init(&(tx.cond), NULL);
+    pthread_t tx_thread;
+    int rc = pthread_create(&tx_thread, NULL, &bench_sym_stream_transmitter, &tx);
+    se_assert(!rc);
+
+    SE_SEND_STREAM stream;
+    stream.send        = &bench_sym_stream_tx_send;
+    stream.wait        = &bench_sym_stream_tx_wait;
+    stream.ctx         = &tx;
+    stream.chunk_count = SE_BENCH_STREAM_CHUNK_COUNT;
+
+    // -- Count the bytes of one ciphertext (depends on SE_ENABLE_SYM_SEED_CT, SE_ENABLE_PACKED_CT)
+    bench_sym_stream_count_only = true;
+    bench_sym_stream_nbytes     = 0;
+    se_encrypt_batch(&bench_sym_stream_blocking_send, vecs, 1, vlen * sizeof(flpt), se_parms);
+    bench_sym_stream_count_only = false;
+    size_t ct_nbytes            = bench_sym_stream_nbytes;
+    double link_us              = (double)ct_nbytes * 8.0 / SE_BENCH_STREAM_LINK_MBPS;
+
+    BenchStreamRx rx;
+    memset(&rx, 0, sizeof(rx));
+    rx.fd     = recv_fd;
+    rx.nbytes = ct_nbytes;
+    rx.nmsgs  = 2 * (SE_BENCH_STREAM_COUNT + 1);
+    pthread_mutex_init(&(rx.lock), NULL);
+    pthread_cond_init(&(rx.cond), NULL);
+    pthread_t rx_thread;
+    rc = pthread_create(&rx_thread, NULL, &bench_sym_stream_receiver, &rx);
+    se_assert(!rc);
+    SE_UNUSED(rc);
+
+    const char *names[3] = {"compute only", "blocking send", "stream send"};
+    float t_total[3] = {0}, t_min[3] = {0}, t_max[3] = {0}, t_curr[3] = {0};
+    size_t nmsgs_sent = 0;
+    for (size_t b_itr = 0; b_itr < SE_BENCH_STREAM_COUNT + 1; b_itr++)
+    {
+        for (size_t m = 0; m < 3; m++)
+        {
+            // -- Let the link go idle between runs
+            bench_sym_stream_sleep_until(bench_sym_stream_wall_time_sec() + 1e-3);
+
+            bool ret     = true;
+            double start = bench_sym_stream_wall_time_sec();
+            double t_done;
+            if (m == 0)
+            {
+                bench_sym_stream_count_only = true;
+                ret = se_encrypt_batch(&bench_sym_stream_blocking_send, vecs, 1,
+                                       vlen * sizeof(flpt), se_parms);
+                bench_sym_stream_count_only = false;
+                t_done                      = bench_sym_stream_wall_time_sec();
+            }
+            else
+            {
+                if (m == 1)
+                    ret = se_encrypt_batch(&bench_sym_stream_blocking_send, vecs, 1,
+                                           vlen * sizeof(flpt), se_parms);
+                else
+                    ret = se_encrypt_stream(&stream, vecs, 1, vlen * sizeof(flpt), se_parms);
+                t_done = bench_sym_stream_rx_wait(&rx, ++nmsgs_sent);
+            }
+            se_assert(ret);
+            SE_UNUSED(ret);
+
+            t_curr[m] = (float)((t_done - start) * 1e6);
+            // -- Skip the first (warm-up) iteration
+            if (b_itr) set_time_vals(t_curr[m], &(t_total[m]), &(t_min[m]), &(t_max[m]));
+        }
+    }
+
+    for (size_t m = 0; m < 3; m++)
+    {
+        print_time_vals(names[m], t_curr[m], SE_BENCH_STREAM_COUNT, &(t_total[m]), &(t_min[m]),
+                        &(t_max[m]));
+    }
+    printf("\n-- End-to-end latency per ciphertext (%zu bytes, %d Mbps link) --\n", ct_nbytes,
+           SE_BENCH_STREAM_LINK_MBPS);
+    printf("link time only      : %8.2f us\n", link_us);
+    for (size_t m = 0; m < 3; m++)
+    {
+        float avg = t_total[m] / SE_BENCH_STREAM_COUNT;
+        printf("%-20s: %8.2f us (min: %8.2f us)\n", names[m], avg, t_min[m]);
+    }
+    float avg_blocking = t_total[1] / SE_BENCH_STREAM_COUNT;
+    float avg_stream   = t_total[2] / SE_BENCH_STREAM_COUNT;
+    printf("stream vs blocking  : %0.2fx lower latency (%0.2f us hidden)\n",
+           avg_blocking / avg_stream, avg_blocking - avg_stream);
+    print_bench_banner(bench_name, se_parms->parms);
+
+    pthread_mutex_lock(&(tx.lock));
+    tx.quit = true;
+    pthread_cond_broadcast(&(tx.cond));
+    pthread_mutex_unlock(&(tx.lock));
+    pthread_join(tx_thread, NULL);
+    pthread_join(rx_thread, NULL);
+    pthread_cond_destroy(&(rx.cond));
+    pthread_mutex_destroy(&(rx.lock));
+    pthread_cond_destroy(&(tx.cond));
+    pthread_mutex_destroy(&(tx.lock));
+    close(send_fd);
+    close(recv_fd);
+    bench_sym_stream_send_fd = -1;
+
+    free(v);
+    se_cleanup(se_parms);
+}
+#endif
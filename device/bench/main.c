@@ -16,14 +16,29 @@ time (i.e., uncomment the benchmark you want to run and uncomment all others bef
 // -- Benchmarks
 extern void bench_index_map(void);
 extern void bench_ifft(void);
+extern void bench_ifft_real(void);
 extern void bench_ntt(void);
+extern void bench_ntt_fast(void);
 extern void bench_prng_randomize_seed(void);
 extern void bench_prng_fill_buffer(void);
+extern void bench_prng_fill_buffer_x4(void);
+extern void bench_prng_backends(void);
 extern void bench_prng_randomize_seed_fill_buffer(void);
 extern void bench_sample_uniform(void);
 extern void bench_sample_ternary_small(void);
 extern void bench_sample_poly_cbd(void);
+extern void bench_sample_keccak_permutations(void);
+extern void bench_poly_pack(void);
 extern void bench_sym(void);
+#ifdef SE_USE_MALLOC
+extern void bench_sym_batch(void);
+#endif
+#if defined(SE_USE_MALLOC) && !defined(SE_ON_SPHERE_M4) && !defined(SE_ON_NRF5)
+extern void bench_sym_mt(void);
+extern void bench_sym_stream(void);
+extern void bench_sym_par(void);
+extern void bench_sym_pipe(void);
+#endif
 extern void bench_asym(void);
 
 #ifdef SE_ON_SPHERE_M4
@@ -80,14 +95,33 @@ int main(void)
 
     bench_index_map();
     bench_ifft();
+    bench_ifft_real();
     bench_ntt();
+    bench_ntt_fast();
     bench_prng_randomize_seed();
     bench_prng_fill_buffer();
+    bench_prng_fill_buffer_x4();
+    bench_prng_backends();
     bench_prng_randomize_seed_fill_buffer();
     bench_sample_uniform();
     bench_sample_ternary_small();
     bench_sample_poly_cbd();
+    bench_sample_keccak_permutations();
+    bench_poly_pack();
     bench_sym();
+#ifdef SE_USE_MALLOC
+    bench_sym_batch();
+#endif
+#if defined(SE_USE_MALLOC) && !defined(SE_ON_SPHERE_M4) && !defined(SE_ON_NRF5)
+    bench_sym_mt();
+    bench_sym_stream();
+#endif
+#if defined(SE_USE_PTHREADS) && !defined(SE_NTT_REG) && !defined(SE_NTT_FAST)
+    bench_sym_par();
+#endif
+#ifdef SE_USE_PTHREADS
+    bench_sym_pipe();
+#endif
 #if defined(SE_USE_MALLOC) || defined(SE_DEFINE_PK_DATA)
     bench_asym();
 #endif
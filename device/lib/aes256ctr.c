@@ -0,0 +1,342 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file aes256ctr.c
+*/
+
+#include "aes256ctr.h"
+
+#include <string.h>  // memcpy
+
+#ifdef SE_AES_NI
+#include <immintrin.h>
+
+#include "cpu_features.h"
+
+#define SE_TARGET_AESNI __attribute__((target("aes,sse2")))
+#endif
+
+/**
+Applies the AES S-box to up to 32 bytes at once, in constant time. The bytes are bitsliced (bit i of
+byte j goes to bit j of q[i]), then the S-box is computed with the circuit of Boyar and Peralta
+(113 gates, as in BearSSL's aes_ct), so no memory access depends on the input.
+
+@param[in,out] s    Bytes to substitute
+@param[in]     len  Number of bytes (at most 32)
+*/
+static void aes_sub_bytes(uint8_t *s, size_t len)
+{
+    uint32_t q[8] = {0};
+    for (size_t j = 0; j < len; j++)
+    {
+        for (size_t i = 0; i < 8; i++) q[i] |= (uint32_t)((s[j] >> i) & 1) << j;
+    }
+
+    // -- x0 is the most significant bit
+    uint32_t x0 = q[7], x1 = q[6], x2 = q[5], x3 = q[4];
+    uint32_t x4 = q[3], x5 = q[2], x6 = q[1], x7 = q[0];
+
+    // -- Top linear transformation
+    uint32_t y14 = x3 ^ x5;
+    uint32_t y13 = x0 ^ x6;
+    uint32_t y9  = x0 ^ x3;
+    uint32_t y8  = x0 ^ x5;
+    uint32_t t0  = x1 ^ x2;
+    uint32_t y1  = t0 ^ x7;
+    uint32_t y4  = y1 ^ x3;
+    uint32_t y12 = y13 ^ y14;
+    uint32_t y2  = y1 ^ x0;
+    uint32_t y5  = y1 ^ x6;
+    uint32_t y3  = y5 ^ y8;
+    uint32_t t1  = x4 ^ y12;
+    uint32_t y15 = t1 ^ x5;
+    uint32_t y20 = t1 ^ x1;
+    uint32_t y6  = y15 ^ x7;
+    uint32_t y10 = y15 ^ t0;
+    uint32_t y11 = y20 ^ y9;
+    uint32_t y7  = x7 ^ y11;
+    uint32_t y17 = y10 ^ y11;
+    uint32_t y19 = y10 ^ y8;
+    uint32_t y16 = t0 ^ y11;
+    uint32_t y21 = y13 ^ y16;
+    uint32_t y18 = x0 ^ y16;
+
+    // -- Non-linear section
+    uint32_t t2  = y12 & y15;
+    uint32_t t3  = y3 & y6;
+    uint32_t t4  = t3 ^ t2;
+    uint32_t t5  = y4 & x7;
+    uint32_t t6  = t5 ^ t2;
+    uint32_t t7  = y13 & y16;
+    uint32_t t8  = y5 & y1;
+    uint32_t t9  = t8 ^ t7;
+    uint32_t t10 = y2 & y7;
+    uint32_t t11 = t10 ^ t7;
+    uint32_t t12 = y9 & y11;
+    uint32_t t13 = y14 & y17;
+    uint32_t t14 = t13 ^ t12;
+    uint32_t t15 = y8 & y10;
+    uint32_t t16 = t15 ^ t12;
+    uint32_t t17 = t4 ^ t14;
+    uint32_t t18 = t6 ^ t16;
+    uint32_t t19 = t9 ^ t14;
+    uint32_t t20 = t11 ^ t16;
+    uint32_t t21 = t17 ^ y20;
+    uint32_t t22 = t18 ^ y19;
+    uint32_t t23 = t19 ^ y21;
+    uint32_t t24 = t20 ^ y18;
+
+    uint32_t t25 = t21 ^ t22;
+    uint32_t t26 = t21 & t23;
+    uint32_t t27 = t24 ^ t26;
+    uint32_t t28 = t25 & t27;
+    uint32_t t29 = t28 ^ t22;
+    uint32_t t30 = t23 ^ t24;
+    uint32_t t31 = t22 ^ t26;
+    uint32_t t32 = t31 & t30;
+    uint32_t t33 = t32 ^ t24;
+    uint32_t t34 = t23 ^ t33;
+    uint32_t t35 = t27 ^ t33;
+    uint32_t t36 = t24 & t35;
+    uint32_t t37 = t36 ^ t34;
+    uint32_t t38 = t27 ^ t36;
+    uint32_t t39 = t29 & t38;
+    uint32_t t40 = t25 ^ t39;
+
+    uint32_t t41 = t40 ^ t37;
+    uint32_t t42 = t29 ^ t33;
+    uint32_t t43 = t29 ^ t40;
+    uint32_t t44 = t33 ^ t37;
+    uint32_t t45 = t42 ^ t41;
+    uint32_t z0  = t44 & y15;
+    uint32_t z1  = t37 & y6;
+    uint32_t z2  = t33 & x7;
+    uint32_t z3  = t43 & y16;
+    uint32_t z4  = t40 & y1;
+    uint32_t z5  = t29 & y7;
+    uint32_t z6  = t42 & y11;
+    uint32_t z7  = t45 & y17;
+    uint32_t z8  = t41 & y10;
+    uint32_t z9  = t44 & y12;
+    uint32_t z10 = t37 & y3;
+    uint32_t z11 = t33 & y4;
+    uint32_t z12 = t43 & y13;
+    uint32_t z13 = t40 & y5;
+    uint32_t z14 = t29 & y2;
+    uint32_t z15 = t42 & y9;
+    uint32_t z16 = t45 & y14;
+    uint32_t z17 = t41 & y8;
+
+    // -- Bottom linear transformation
+    uint32_t t46 = z15 ^ z16;
+    uint32_t t47 = z10 ^ z11;
+    uint32_t t48 = z5 ^ z13;
+    uint32_t t49 = z9 ^ z10;
+    uint32_t t50 = z2 ^ z12;
+    uint32_t t51 = z2 ^ z5;
+    uint32_t t52 = z7 ^ z8;
+    uint32_t t53 = z0 ^ z3;
+    uint32_t t54 = z6 ^ z7;
+    uint32_t t55 = z16 ^ z17;
+    uint32_t t56 = z12 ^ t48;
+    uint32_t t57 = t50 ^ t53;
+    uint32_t t58 = z4 ^ t46;
+    uint32_t t59 = z3 ^ t54;
+    uint32_t t60 = t46 ^ t57;
+    uint32_t t61 = z14 ^ t57;
+    uint32_t t62 = t52 ^ t58;
+    uint32_t t63 = t49 ^ t58;
+    uint32_t t64 = z4 ^ t59;
+    uint32_t t65 = t61 ^ t62;
+    uint32_t t66 = z1 ^ t63;
+    uint32_t s0  = t59 ^ t63;
+    uint32_t s6  = t56 ^ ~t62;
+    uint32_t s7  = t48 ^ ~t60;
+    uint32_t t67 = t64 ^ t65;
+    uint32_t s3  = t53 ^ t66;
+    uint32_t s4  = t51 ^ t66;
+    uint32_t s5  = t47 ^ t65;
+    uint32_t s1  = t64 ^ ~s3;
+    uint32_t s2  = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+
+    for (size_t j = 0; j < len; j++)
+    {
+        uint8_t byte = 0;
+        for (size_t i = 0; i < 8; i++) byte |= (uint8_t)(((q[i] >> j) & 1) << i);
+        s[j] = byte;
+    }
+}
+
+static inline uint8_t xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+/**
+AES-256 key expansion (FIPS-197, Section 5.2). The round keys are stored in the byte order
+expected by both the portable implementation and AES-NI.
+
+@param[in]  key         AES-256 key (32 bytes)
+@param[out] round_keys  15 round keys (240 bytes)
+*/
+static void aes256_key_expansion(const uint8_t *key, uint8_t *round_keys)
+{
+    memcpy(round_keys, key, 32);
+    uint8_t rcon = 1;
+    for (size_t i = 8; i < 60; i++)  // 4-byte words
+    {
+        uint8_t t[4];
+        memcpy(t, &(round_keys[4 * (i - 1)]), 4);
+        if (i % 8 == 0)
+        {
+            // -- RotWord, SubWord, and Rcon
+            uint8_t t0 = t[0];
+            t[0]       = t[1];
+            t[1]       = t[2];
+            t[2]       = t[3];
+            t[3]       = t0;
+            aes_sub_bytes(t, 4);
+            t[0] ^= rcon;
+            rcon = xtime(rcon);
+        }
+        else if (i % 8 == 4)
+        {
+            aes_sub_bytes(t, 4);
+        }
+        for (size_t k = 0; k < 4; k++) round_keys[4 * i + k] = round_keys[4 * (i - 8) + k] ^ t[k];
+    }
+}
+
+/**
+Portable AES-256 encryption of a single 16-byte block. Constant-time (see: aes_sub_bytes).
+*/
+static void aes256_encrypt_block(const uint8_t *round_keys, const uint8_t *in, uint8_t *out)
+{
+    uint8_t s[16], t[16];
+    for (size_t i = 0; i < 16; i++) s[i] = in[i] ^ round_keys[i];
+
+    for (size_t round = 1; round <= 14; round++)
+    {
+        // -- SubBytes and ShiftRows (state is column-major: byte r + 4c is row r, column c)
+        aes_sub_bytes(s, 16);
+        for (size_t c = 0; c < 4; c++)
+        {
+            for (size_t r = 0; r < 4; r++) t[r + 4 * c] = s[r + 4 * ((c + r) % 4)];
+        }
+
+        // -- MixColumns (skipped in the last round)
+        if (round < 14)
+        {
+            for (size_t c = 0; c < 4; c++)
+            {
+                uint8_t *a  = &(t[4 * c]);
+                uint8_t all = a[0] ^ a[1] ^ a[2] ^ a[3];
+                uint8_t a0  = a[0];
+                a[0] ^= all ^ xtime(a[0] ^ a[1]);
+                a[1] ^= all ^ xtime(a[1] ^ a[2]);
+                a[2] ^= all ^ xtime(a[2] ^ a[3]);
+                a[3] ^= all ^ xtime(a[3] ^ a0);
+            }
+        }
+
+        // -- AddRoundKey
+        for (size_t i = 0; i < 16; i++) s[i] = t[i] ^ round_keys[16 * round + i];
+    }
+    memcpy(out, s, 16);
+}
+
+#ifdef SE_AES_NI
+/**
+AES-NI implementation of aes256ctr_squeezeblocks. Encrypts the 4 counter blocks of each output
+block in parallel.
+*/
+static SE_TARGET_AESNI void aes256ctr_squeezeblocks_aesni(uint8_t *out, size_t nblocks,
+                                                          aes256ctr_ctx *state)
+{
+    __m128i rk[15];
+    for (size_t i = 0; i < 15; i++)
+    { rk[i] = _mm_loadu_si128((const __m128i *)&(state->round_keys[16 * i])); }
+
+    for (size_t b = 0; b < nblocks; b++, out += AES256CTR_BLOCKBYTES)
+    {
+        __m128i x[4];
+        for (size_t i = 0; i < 4; i++)
+        {
+            // -- Counter block: le64(nonce) || be64(block index)
+            uint64_t idx = __builtin_bswap64(state->block_idx + i);
+            x[i] = _mm_xor_si128(_mm_set_epi64x((long long)idx, (long long)state->nonce), rk[0]);
+        }
+        for (size_t r = 1; r < 14; r++)
+        {
+            for (size_t i = 0; i < 4; i++) x[i] = _mm_aesenc_si128(x[i], rk[r]);
+        }
+        for (size_t i = 0; i < 4; i++)
+        {
+            x[i] = _mm_aesenclast_si128(x[i], rk[14]);
+            _mm_storeu_si128((__m128i *)&(out[16 * i]), x[i]);
+        }
+        state->block_idx += 4;
+    }
+}
+#endif
+
+void aes256ctr_init(aes256ctr_ctx *state, const uint8_t *key, uint64_t nonce)
+{
+    aes256_key_expansion(key, state->round_keys);
+    state->nonce     = nonce;
+    state->block_idx = 0;
+#ifdef SE_AES_NI
+    state->use_aesni = se_cpu_has_aes();
+#endif
+}
+
+void aes256ctr_squeezeblocks(uint8_t *out, size_t nblocks, aes256ctr_ctx *state)
+{
+#ifdef SE_AES_NI
+    if (state->use_aesni)
+    {
+        aes256ctr_squeezeblocks_aesni(out, nblocks, state);
+        return;
+    }
+#endif
+    for (size_t b = 0; b < 4 * nblocks; b++, out += 16)
+    {
+        // -- Counter block: le64(nonce) || be64(block index)
+        uint8_t ctr[16];
+        for (size_t i = 0; i < 8; i++)
+        {
+            ctr[i]      = (uint8_t)(state->nonce >> (8 * i));
+            ctr[15 - i] = (uint8_t)(state->block_idx >> (8 * i));
+        }
+        aes256_encrypt_block(state->round_keys, ctr, out);
+        state->block_idx++;
+    }
+}
+
+void aes256ctr_prf(uint8_t *out, size_t outlen, const uint8_t *key, uint64_t nonce)
+{
+    aes256ctr_ctx state;
+    aes256ctr_init(&state, key, nonce);
+
+    size_t nblocks = outlen / AES256CTR_BLOCKBYTES;
+    aes256ctr_squeezeblocks(out, nblocks, &state);
+    out += nblocks * AES256CTR_BLOCKBYTES;
+    outlen -= nblocks * AES256CTR_BLOCKBYTES;
+
+    if (outlen)
+    {
+        uint8_t t[AES256CTR_BLOCKBYTES];
+        aes256ctr_squeezeblocks(t, 1, &state);
+        memcpy(out, t, outlen);
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file aes256ctr.h
+
+AES-256 in counter mode, used as a PRNG backend (see: SE_PRNG_TYPE). Block j of the output stream
+for nonce 'nonce' is AES-256(key, le64(nonce) || be64(j)), i.e., standard AES-256-CTR with initial
+counter block le64(nonce) || 0^64.
+
+On x86-64 hosts (if SE_AES_NI is defined), uses AES-NI if the CPU supports it (checked once per
+stream, in aes256ctr_init). Otherwise, uses a portable implementation that computes the S-box with a
+bitsliced circuit instead of table lookups, so that it is constant-time on cores with data caches.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "defines.h"
+
+// -- Output is generated 4 AES blocks (64 bytes) at a time
+#define AES256CTR_BLOCKBYTES 64
+
+typedef struct aes256ctr_ctx
+{
+    uint8_t round_keys[15 * 16];
+    uint64_t nonce;
+    uint64_t block_idx;  // Index of the next 16-byte AES block
+#ifdef SE_AES_NI
+    bool use_aesni;  // Set to 1 if the CPU supports AES-NI
+#endif
+} aes256ctr_ctx;
+
+/**
+Sets up a AES-256-CTR stream.
+
+@param[out] state  Stream state to initialize
+@param[in]  key    AES-256 key (32 bytes)
+@param[in]  nonce  Nonce (i.e., first half of the counter block)
+*/
+void aes256ctr_init(aes256ctr_ctx *state, const uint8_t *key, uint64_t nonce);
+
+/**
+Generates the next nblocks * AES256CTR_BLOCKBYTES bytes of a AES-256-CTR stream.
+
+@param[out]    out      Output buffer (nblocks * AES256CTR_BLOCKBYTES bytes)
+@param[in]     nblocks  Number of AES256CTR_BLOCKBYTES-byte blocks to generate
+@param[in,out] state    Stream state
+*/
+void aes256ctr_squeezeblocks(uint8_t *out, size_t nblocks, aes256ctr_ctx *state);
+
+/**
+Generates the first outlen bytes of the AES-256-CTR stream for a key and nonce.
+
+@param[out] out     Output buffer (outlen bytes)
+@param[in]  outlen  Number of bytes to generate
+@param[in]  key     AES-256 key (32 bytes)
+@param[in]  nonce   Nonce (i.e., first half of the counter block)
+*/
+void aes256ctr_prf(uint8_t *out, size_t outlen, const uint8_t *key, uint64_t nonce);
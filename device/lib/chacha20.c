@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file chacha20.c
+*/
+
+#include "chacha20.h"
+
+#include <string.h>  // memcpy
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d) \
+    a += b;                      \
+    d ^= a;                      \
+    d = ROTL32(d, 16);           \
+    c += d;                      \
+    b ^= c;                      \
+    b = ROTL32(b, 12);           \
+    a += b;                      \
+    d ^= a;                      \
+    d = ROTL32(d, 8);            \
+    c += d;                      \
+    b ^= c;                      \
+    b = ROTL32(b, 7);
+
+static inline uint32_t load32_le(const uint8_t *x)
+{
+    return (uint32_t)x[0] | ((uint32_t)x[1] << 8) | ((uint32_t)x[2] << 16) |
+           ((uint32_t)x[3] << 24);
+}
+
+static inline void store32_le(uint8_t *x, uint32_t v)
+{
+    x[0] = (uint8_t)v;
+    x[1] = (uint8_t)(v >> 8);
+    x[2] = (uint8_t)(v >> 16);
+    x[3] = (uint8_t)(v >> 24);
+}
+
+void chacha20_init(chacha20_ctx *state, const uint8_t *key, uint64_t nonce)
+{
+    // -- "expand 32-byte k"
+    state->input[0] = 0x61707865;
+    state->input[1] = 0x3320646e;
+    state->input[2] = 0x79622d32;
+    state->input[3] = 0x6b206574;
+    for (size_t i = 0; i < 8; i++) state->input[4 + i] = load32_le(&(key[4 * i]));
+    state->input[12] = 0;  // block counter
+    state->input[13] = (uint32_t)nonce;
+    state->input[14] = (uint32_t)(nonce >> 32);
+    state->input[15] = 0;
+}
+
+void chacha20_squeezeblocks(uint8_t *out, size_t nblocks, chacha20_ctx *state)
+{
+    for (size_t b = 0; b < nblocks; b++, out += CHACHA20_BLOCKBYTES)
+    {
+        uint32_t x[16];
+        memcpy(x, state->input, sizeof(x));
+        for (size_t i = 0; i < 10; i++)  // 20 rounds
+        {
+            QUARTERROUND(x[0], x[4], x[8], x[12]);
+            QUARTERROUND(x[1], x[5], x[9], x[13]);
+            QUARTERROUND(x[2], x[6], x[10], x[14]);
+            QUARTERROUND(x[3], x[7], x[11], x[15]);
+            QUARTERROUND(x[0], x[5], x[10], x[15]);
+            QUARTERROUND(x[1], x[6], x[11], x[12]);
+            QUARTERROUND(x[2], x[7], x[8], x[13]);
+            QUARTERROUND(x[3], x[4], x[9], x[14]);
+        }
+        for (size_t i = 0; i < 16; i++) store32_le(&(out[4 * i]), x[i] + state->input[i]);
+        state->input[12]++;
+    }
+}
+
+void chacha20_prf(uint8_t *out, size_t outlen, const uint8_t *key, uint64_t nonce)
+{
+    chacha20_ctx state;
+    chacha20_init(&state, key, nonce);
+
+    size_t nblocks = outlen / CHACHA20_BLOCKBYTES;
+    chacha20_squeezeblocks(out, nblocks, &state);
+    out += nblocks * CHACHA20_BLOCKBYTES;
+    outlen -= nblocks * CHACHA20_BLOCKBYTES;
+
+    if (outlen)
+    {
+        uint8_t t[CHACHA20_BLOCKBYTES];
+        chacha20_squeezeblocks(t, 1, &state);
+        memcpy(out, t, outlen);
+    }
+}
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file chacha20.h
+
+ChaCha20 (RFC 8439) keystream, used as a PRNG backend (see: SE_PRNG_TYPE). The output stream for
+nonce 'nonce' is the ChaCha20 keystream with 96-bit nonce le64(nonce) || 0^32, starting at block
+counter 0. Only uses 32-bit additions, rotations, and XORs, so it is fast (and constant-time) on
+cores without cryptographic extensions.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CHACHA20_BLOCKBYTES 64
+
+typedef struct chacha20_ctx
+{
+    uint32_t input[16];  // Constants, key, block counter, and nonce
+} chacha20_ctx;
+
+/**
+Sets up a ChaCha20 stream.
+
+@param[out] state  Stream state to initialize
+@param[in]  key    ChaCha20 key (32 bytes)
+@param[in]  nonce  Nonce (i.e., first 8 bytes of the 96-bit RFC 8439 nonce)
+*/
+void chacha20_init(chacha20_ctx *state, const uint8_t *key, uint64_t nonce);
+
+/**
+Generates the next nblocks * CHACHA20_BLOCKBYTES bytes of a ChaCha20 stream.
+
+@param[out]    out      Output buffer (nblocks * CHACHA20_BLOCKBYTES bytes)
+@param[in]     nblocks  Number of blocks to generate
+@param[in,out] state    Stream state
+*/
+void chacha20_squeezeblocks(uint8_t *out, size_t nblocks, chacha20_ctx *state);
+
+/**
+Generates the first outlen bytes of the ChaCha20 stream for a key and nonce.
+
+@param[out] out     Output buffer (outlen bytes)
+@param[in]  outlen  Number of bytes to generate
+@param[in]  key     ChaCha20 key (32 bytes)
+@param[in]  nonce   Nonce (i.e., first 8 bytes of the 96-bit RFC 8439 nonce)
+*/
+void chacha20_prf(uint8_t *out, size_t outlen, const uint8_t *key, uint64_t nonce);
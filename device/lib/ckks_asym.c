@@ -17,6 +17,7 @@
 #include "defines.h"
 #include "fft.h"
 #include "fileops.h"
+#include "mempool.h"
 #include "modulo.h"
 #include "ntt.h"
 #include "parameters.h"
@@ -27,39 +28,20 @@
 #include "util_print.h"
 
 #ifdef SE_USE_MALLOC
-size_t ckks_get_mempool_size_asym(size_t degree)
+size_t ckks_get_mempool_size_asym(size_t degree, size_t nprimes)
 {
     se_assert(degree >= 16);
-    if (degree == SE_DEGREE_N) return MEMPOOL_SIZE_Asym;
     size_t n            = degree;
-    size_t mempool_size = 4 * n;  // base
-
-#ifdef SE_IFFT_OTF
-    mempool_size += n + n / 4 + n / 16;
-#if defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
-    mempool_size += n;
-#elif defined(SE_NTT_FAST)
-    mempool_size += 2 * n;
-#endif
-#else
-    mempool_size += 4 * n;
-#endif
-
-#if defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST)
-    mempool_size += n / 2;
-#endif
-
-#ifdef SE_MEMPOOL_ALLOC_VALUES
-    mempool_size += n / 2;
-#endif
+    size_t unit         = n / 16;  // see: mempool.h
+    size_t mempool_size = SE_MP_ASYM_UNITS * unit + nprimes * SE_MP_ASYM_SIZE_pk * unit;
 
     se_assert(mempool_size);
     return mempool_size;
 }
 
-ZZ *ckks_mempool_setup_asym(size_t degree)
+ZZ *ckks_mempool_setup_asym(size_t degree, size_t nprimes)
 {
-    size_t mempool_size = ckks_get_mempool_size_asym(degree);
+    size_t mempool_size = ckks_get_mempool_size_asym(degree, nprimes);
     ZZ *mempool         = calloc(mempool_size, sizeof(ZZ));
     // printf("mempool_size: %zu\n", mempool_size);
     if (!mempool)
@@ -75,70 +57,28 @@ ZZ *ckks_mempool_setup_asym(size_t degree)
 void ckks_set_ptrs_asym(size_t degree, ZZ *mempool, SE_PTRS *se_ptrs)
 {
     se_assert(mempool && se_ptrs);
-    size_t n = degree;
-
-    // -- First, set everything to the set size or 0
-    se_ptrs->conj_vals         = (double complex *)mempool;
-    se_ptrs->conj_vals_int_ptr = (int64_t *)mempool;
-    se_ptrs->c1_ptr            = &(mempool[2 * n]);
-    se_ptrs->c0_ptr            = &(mempool[3 * n]);
-
-    // -- In asymmetric mode, ntt_pte_ptr == ntt_u2pte_ptr
-    se_ptrs->ternary       = &(mempool[5 * n + n / 4]);  // default: SE_INDEX_MAP_OTF
-    se_ptrs->ifft_roots    = 0;                          // default: SE_IFFT_OTF
-    se_ptrs->index_map_ptr = 0;                          // default: SE_INDEX_MAP_OTF
-    se_ptrs->ntt_roots_ptr = 0;                          // default: SE_NTT_OTF
-    se_ptrs->values        = 0;
-
-    // -- Sizes
-    size_t ifft_roots_size        = 0;
-    size_t ntt_roots_size         = 0;
-    size_t index_map_persist_size = 0;
-
-    // -- Set ifft_roots based on IFFT type
-#ifndef SE_IFFT_OTF
-    ifft_roots_size     = 4 * n;
-    se_ptrs->ifft_roots = (double complex *)&(mempool[4 * n]);
-#endif
-
-    // -- Set ntt_roots based on NTT type
-#if defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
-    ntt_roots_size         = n;
-    se_ptrs->ntt_roots_ptr = &(mempool[4 * n]);
-#elif defined(SE_NTT_FAST)
-    ntt_roots_size         = 2 * n;
-    se_ptrs->ntt_roots_ptr = &(mempool[4 * n]);
-#endif
-
-    size_t total_block2_size = ifft_roots_size ? ifft_roots_size : (ntt_roots_size + n);
-
-    // -- Set pi inverse based on index map type
-#if defined(SE_INDEX_MAP_LOAD) || defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
-    se_ptrs->index_map_ptr = (uint16_t *)&(mempool[4 * n]);
-#elif defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST)
-    // -- If ifft, this will be + the ifft_roots size
-    //    else, this will be + the ntt size, + ntt(e1) size
-    se_ptrs->index_map_ptr = (uint16_t *)&(mempool[4 * n + total_block2_size]);
-    index_map_persist_size = n / 2;
-#endif
-    se_ptrs->ntt_pte_ptr = &(mempool[4 * n + ntt_roots_size]);
-
-#ifdef SE_IFFT_OTF
-    se_ptrs->e1_ptr  = (int8_t *)&(mempool[4 * n + ntt_roots_size + n + index_map_persist_size]);
-    se_ptrs->ternary = &(mempool[4 * n + ntt_roots_size + n + index_map_persist_size + n / 4]);
-#else
-    se_ptrs->e1_ptr        = (int8_t *)&(mempool[4 * n + ntt_roots_size + n]);
-    se_ptrs->ternary       = &(mempool[4 * n + ntt_roots_size + n + n / 4]);
-#endif
-
-#ifdef SE_MEMPOOL_ALLOC_VALUES
-#ifdef SE_IFFT_OTF
-    se_ptrs->values =
-        (flpt *)&(mempool[4 * n + total_block2_size + index_map_persist_size + n / 4 + n / 16]);
-#else
-    se_ptrs->values = (flpt *)&(mempool[4 * n + total_block2_size + index_map_persist_size]);
-#endif
-#endif
+    const size_t n = degree;
+
+    // -- Every offset comes from the layout table in mempool.h. Unused buffers are set to 0.
+    se_ptrs->conj_vals         = SE_MP_PTR(ASYM, cflpt, conj_vals, mempool, n);
+    se_ptrs->conj_vals_int_ptr = SE_MP_PTR(ASYM, int64_t, conj_vals_int, mempool, n);
+    se_ptrs->c1_ptr            = SE_MP_PTR(ASYM, ZZ, c1, mempool, n);
+    se_ptrs->c0_ptr            = SE_MP_PTR(ASYM, ZZ, c0, mempool, n);
+    se_ptrs->ifft_roots        = SE_MP_PTR(ASYM, double complex, ifft_roots, mempool, n);
+    se_ptrs->ntt_roots_ptr     = SE_MP_PTR(ASYM, ZZ, ntt_roots, mempool, n);
+    se_ptrs->ntt_pte_ptr       = SE_MP_PTR(ASYM, ZZ, ntt_pte, mempool, n);
+    se_ptrs->e1_ptr            = SE_MP_PTR(ASYM, int8_t, e1, mempool, n);
+    se_ptrs->values            = SE_MP_PTR(ASYM, flpt, values, mempool, n);
+    se_ptrs->ntt_s_ptr         = SE_MP_PTR(ASYM, ZZ, ntt_s, mempool, n);
+    se_ptrs->pk_ptr            = SE_MP_PTR(ASYM, ZZ, pk, mempool, n);
+
+    // -- The index map and u are either reloaded for every encode-encrypt sequence or persistent
+    se_ptrs->index_map_ptr = SE_MP_ASYM_SIZE_index_map
+                                 ? SE_MP_PTR(ASYM, uint16_t, index_map, mempool, n)
+                                 : SE_MP_PTR(ASYM, uint16_t, index_map_persist, mempool, n);
+    se_ptrs->ternary       = SE_MP_ASYM_SIZE_ternary
+                                 ? SE_MP_PTR(ASYM, ZZ, ternary, mempool, n)
+                                 : SE_MP_PTR(ASYM, ZZ, ternary_persist, mempool, n);
 
     size_t address_size = 4;
     se_assert(((ZZ *)se_ptrs->conj_vals) == ((ZZ *)se_ptrs->conj_vals_int_ptr));
@@ -166,8 +106,23 @@ void gen_pk(const Parms *parms, ZZ *s_small, ZZ *ntt_roots, uint8_t *seed, SE_PR
     //    pk_c1 := a
     // -- If pk_c0 and pk_c1 point to the same location, pk0 will overwrite pk1.
     //    However, we need to return pk1. Therefore, must save it in extra buffer.
-    ckks_encode_encrypt_sym(parms, 0, ep_small, shareable_prng, s_small, ntt_ep, ntt_roots, pk_c0,
-                            pk_c1, s_save, 0);
+    ckks_encode_encrypt_sym(parms, 0, ep_small, shareable_prng, s_small, 0, ntt_ep, ntt_roots,
+                            pk_c0, pk_c1, s_save, 0);
+}
+
+void ckks_setup_pk(Parms *parms, ZZ *pk_cache)
+{
+    se_assert(parms && parms->is_asymmetric && pk_cache);
+    size_t n = parms->coeff_count;
+
+    ckks_reset_primes(parms);
+    for (size_t i = 0; i < parms->nprimes; i++)
+    {
+        load_pki(0, parms, &(pk_cache[2 * i * n]));
+        load_pki(1, parms, &(pk_cache[(2 * i + 1) * n]));
+        if ((i + 1) < parms->nprimes) next_modulus(parms);
+    }
+    ckks_reset_primes(parms);
 }
 
 void ckks_asym_init(const Parms *parms, uint8_t *seed, SE_PRNG *prng, int64_t *conj_vals_int, ZZ *u,
@@ -203,8 +158,9 @@ void ckks_asym_init(const Parms *parms, uint8_t *seed, SE_PRNG *prng, int64_t *c
 }
 
 void ckks_encode_encrypt_asym(const Parms *parms, const int64_t *conj_vals_int, const ZZ *u,
-                              const int8_t *e1, ZZ *ntt_roots, ZZ *ntt_u_e1_pte, ZZ *ntt_u_save,
-                              ZZ *ntt_e1_save, ZZ *pk_c0, ZZ *pk_c1)
+                              const int8_t *e1, const ZZ *pk_cache, ZZ *ntt_roots,
+                              ZZ *ntt_u_e1_pte, ZZ *ntt_u_save, ZZ *ntt_e1_save, ZZ *pk_c0,
+                              ZZ *pk_c1)
 {
     se_assert(parms);
 #ifdef SE_DISABLE_TESTING_CAPABILITY
@@ -221,10 +177,19 @@ void ckks_encode_encrypt_asym(const Parms *parms, const int64_t *conj_vals_int,
     // -------------------------
     //      Load pk1, pk0
     // -------------------------
-    if (parms->pk_from_file)
+    // -- If the public key is resident, read it directly from the cache (no loads needed). If it
+    //    is read from code directly, the loads do not write pk_c0 and pk_c1 either.
+    const ZZ *pk0 = pk_c0;
+    const ZZ *pk1 = pk_c1;
+    if (pk_cache)
+    {
+        pk0 = &(pk_cache[2 * parms->curr_modulus_idx * n]);
+        pk1 = &(pk_cache[(2 * parms->curr_modulus_idx + 1) * n]);
+    }
+    else if (parms->pk_from_file)
     {
-        load_pki(1, parms, pk_c1);
-        load_pki(0, parms, pk_c0);
+        pk1 = load_pki(1, parms, pk_c1);
+        pk0 = load_pki(0, parms, pk_c0);
     }
 
     // -------------------------
@@ -249,13 +214,11 @@ void ckks_encode_encrypt_asym(const Parms *parms, const int64_t *conj_vals_int,
         // if (ntt_u_save) print_poly("ntt(u) (inside, ntt_u_save)", ntt_u_save, n);
 #endif
 
-    // -- Calculate [ntt(pk1) . ntt(u)]_Rq. Store result in pk_c1
-    poly_mult_mod_ntt_form_inpl(pk_c1, ntt_u_e1_pte, n, mod);
-    // print_poly("pk1*u (ntt)", pk_c1, n);
-
-    // -- Calculate [ntt(pk0) . ntt(u)]_Rq. Store result in pk_c0
-    poly_mult_mod_ntt_form_inpl(pk_c0, ntt_u_e1_pte, n, mod);
+    // -- Calculate [ntt(pk0) . ntt(u)]_Rq and [ntt(pk1) . ntt(u)]_Rq in one pass over ntt(u).
+    //    Store results in pk_c0 and pk_c1
+    poly_mult_mod_ntt_form_pair(pk0, pk1, ntt_u_e1_pte, n, mod, pk_c0, pk_c1);
     // print_poly("pk0*u (ntt)", pk_c0, n);
+    // print_poly("pk1*u (ntt)", pk_c1, n);
 
     // -------------------------
     //      [pk1*u + e1]_Rq
@@ -18,22 +18,24 @@
 
 #ifdef SE_USE_MALLOC
 /**
-Returns the required size of the memory pool in units of sizeof(ZZ).
+Returns the required size of the memory pool in units of sizeof(ZZ) (see: mempool.h).
 
-@param[in] degree  Desired polynomial ring degree
-@returns           Required size of the memory pool units of sizeof(ZZ)
+@param[in] degree   Desired polynomial ring degree
+@param[in] nprimes  Desired number of primes (only affects the size if SE_PK_PERSISTENT is defined)
+@returns            Required size of the memory pool units of sizeof(ZZ)
 */
-size_t ckks_get_mempool_size_asym(size_t degree);
+size_t ckks_get_mempool_size_asym(size_t degree, size_t nprimes);
 
 /**
 Sets up the memory pool for CKKS asymmetric encryption.
 
 Note: This function calls calloc.
 
-@param[in] degree  Desired polynomial ring degree
-@returns           A handle to the memory pool
+@param[in] degree   Desired polynomial ring degree
+@param[in] nprimes  Desired number of primes
+@returns            A handle to the memory pool
 */
-ZZ *ckks_mempool_setup_asym(size_t degree);
+ZZ *ckks_mempool_setup_asym(size_t degree, size_t nprimes);
 #endif
 
 /**
@@ -66,6 +68,18 @@ type chosen. If seed != NULL, seed must be SE_PRNG_SEED_BYTE_COUNT long.
 void gen_pk(const Parms *parms, ZZ *s_small, ZZ *ntt_roots, uint8_t *seed, SE_PRNG *shareable_prng,
             ZZ *s_save, int8_t *ep_small, ZZ *ntt_ep, ZZ *pk_c0, ZZ *pk_c1);
 
+/**
+Loads both public key components for every prime in the modulus chain into 'pk_cache', so that they
+do not need to be loaded again for each encode-encrypt sequence. Should be called once during setup.
+Primes are reset before returning.
+
+Size req: 'pk_cache' must contain space for 2 * nprimes * n ZZ elements.
+
+@param[in,out] parms     Parameters set by ckks_setup
+@param[out]    pk_cache  pk0 followed by pk1 for each prime (in order of the modulus chain)
+*/
+void ckks_setup_pk(Parms *parms, ZZ *pk_cache);
+
 /**
 Initializes values for a single full asymmetric CKKS encryption. Samples the errors (w/o respect to
 any prime), as well as the ternary polynomial 'u'. Should be called once per encode-encrypt sequence
@@ -91,24 +105,31 @@ Encodes and asymmetrically encrypts a vector of values using CKKS, for the curre
 Optionally returns some additional values useful for testing, if SE_DISABLE_TESTING_CAPABILITY is
 not defined.
 
+If 'pk_cache' is NULL, 'pk_c0' and 'pk_c1' are expected to hold the public key for the current prime
+on input (or it will be loaded into them if parms->pk_from_file is set, unless
+SE_DATA_FROM_CODE_DIRECT is defined, in which case it is read from code directly). Otherwise, the
+public key for the current prime is read from 'pk_cache' and is not modified.
+
 Size req: 'ntt_roots' should have space for NTT roots according to NTT option chosen.
 'ntt_u_e1_pte', 'pk_c0', and 'pk_c1' should have space for n ZZ elements.  If testing,
 'ntt_u_save' and 'ntt_e1_save' should have space for n ZZ elements.
 
-@param[in]  parms          Parameters set by ckks_setup
-@param[in]  conj_vals_int  As set by ckks_asym_init
-@param[in]  u              As set by ckks_asym_init
-@param[in]  e1             As set by ckks_asym_init
-@param      ntt_roots      [Optional]. Scratch space for ntt roots. Ignored if SE_NTT_OTF is chosen.
-@param[out] ntt_u_e1_pte   Scratch space. Out: m + e0 in reduced and ntt form (useful for testing).
-@param[out] ntt_u_save     [Optional, ignored if NULL]. Expanded and ntt form of u (for testing)
-@param[out] ntt_e1_save    [Optional, ignored if NULL]. Reduced and ntt form of e1 (for testing)
-@param[out] pk_c0          First component of ciphertext
-@param[out] pk_c1          Second component of ciphertext
+@param[in]     parms          Parameters set by ckks_setup
+@param[in]     conj_vals_int  As set by ckks_asym_init
+@param[in]     u              As set by ckks_asym_init
+@param[in]     e1             As set by ckks_asym_init
+@param[in]     pk_cache       [Optional]. Resident public key for all primes (see: ckks_setup_pk)
+@param         ntt_roots      [Optional]. Scratch for ntt roots. Ignored if SE_NTT_OTF is chosen.
+@param[out]    ntt_u_e1_pte   Scratch space. Out: m + e0 in reduced and ntt form (for testing).
+@param[out]    ntt_u_save     [Optional, ignored if NULL]. Expanded and ntt form of u (for testing)
+@param[out]    ntt_e1_save    [Optional, ignored if NULL]. Reduced and ntt form of e1 (for testing)
+@param[in,out] pk_c0          In: pk0 (if pk_cache is NULL); Out: First component of ciphertext
+@param[in,out] pk_c1          In: pk1 (if pk_cache is NULL); Out: Second component of ciphertext
 */
 void ckks_encode_encrypt_asym(const Parms *parms, const int64_t *conj_vals_int, const ZZ *u,
-                              const int8_t *e1, ZZ *ntt_roots, ZZ *ntt_u_e1_pte, ZZ *ntt_u_save,
-                              ZZ *ntt_e1_save, ZZ *pk_c0, ZZ *pk_c1);
+                              const int8_t *e1, const ZZ *pk_cache, ZZ *ntt_roots,
+                              ZZ *ntt_u_e1_pte, ZZ *ntt_u_save, ZZ *ntt_e1_save, ZZ *pk_c0,
+                              ZZ *pk_c1);
 
 /**
 Updates parameters to next prime in modulus switching chain for asymmetric CKKS encryption. Also
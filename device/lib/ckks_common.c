@@ -87,7 +87,7 @@ void ckks_setup_custom(size_t degree, size_t nprimes, const ZZ *modulus_vals, co
         ckks_setup(degree, nprimes, index_map, parms);
         return;
     }
-    ckks_setup_custom(degree, nprimes, modulus_vals, ratios, index_map, parms);
+    set_custom_parms_ckks(degree, parms->scale, nprimes, modulus_vals, ratios, parms);
 #ifdef SE_INDEX_MAP_PERSIST
     ckks_calc_index_map(parms, index_map);
 #elif defined(SE_INDEX_MAP_LOAD_PERSIST)
@@ -103,25 +103,34 @@ void ckks_reset_primes(Parms *parms)
 }
 
 bool ckks_encode_base(const Parms *parms, const flpt *values, size_t values_len,
-                      uint16_t *index_map, double complex *ifft_roots, double complex *conj_vals)
+                      uint16_t *index_map, double complex *ifft_roots, cflpt *conj_vals)
 {
     se_assert(parms);
     size_t n     = parms->coeff_count;
     size_t logn  = parms->logn;
     double scale = parms->scale;
 
+#ifndef SE_INDEX_MAP_OTF
+    const uint16_t *map = index_map;
+#endif
 #ifdef SE_INDEX_MAP_LOAD
-    se_assert(index_map);
-    load_index_map(parms, index_map);
+    map = load_index_map(parms, index_map);
 #elif defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
-    if (parms->is_asymmetric)
-    {
-        se_assert(index_map);
-        load_index_map(parms, index_map);
-    }
+    if (parms->is_asymmetric) map = load_index_map(parms, index_map);
 #endif
     // if (index_map) print_poly_uint16("index map", index_map, n);
 
+    // -- The encoder's input is conjugate-symmetric (and the slot values are real), so we only need
+    //    to store the first half of the (bit-reversed) ifft input, split into real parts followed by
+    //    imaginary parts (see: ifft_real_inpl). Slots not set below must be zero.
+#ifdef SE_IFFT_SINGLE_PRECISION
+    float *vec = (float *)conj_vals;
+#else
+    double *vec = (double *)conj_vals;
+#endif
+    size_t half = n / 2;
+    memset(vec, 0, n * sizeof(vec[0]));
+
 #ifdef SE_INDEX_MAP_OTF
     SE_UNUSED(index_map);
     // uint64_t gen = 5;
@@ -132,70 +141,91 @@ bool ckks_encode_base(const Parms *parms, const flpt *values, size_t values_len,
     for (size_t i = 0; i < values_len; i++, pos = ((pos * gen) & (m - 1)))
     {
         size_t index1       = ((size_t)pos - 1) / 2;
-        size_t index2       = n - index1 - 1;
         uint16_t index1_rev = (uint16_t)bitrev(index1, logn);
-        uint16_t index2_rev = (uint16_t)bitrev(index2, logn);
 #else
-    size_t slot_count = n / 2;
     for (size_t i = 0; i < values_len; i++)
     {
-        se_assert(index_map);
-        uint16_t index1_rev = index_map[i];
-        uint16_t index2_rev = index_map[i + slot_count];
+        se_assert(map);
+        uint16_t index1_rev = map[i];
 #endif
         se_assert(index1_rev < n);
-        se_assert(index2_rev < n);
-        double complex val    = (double complex)_complex((double)values[i], (double)0);
-        conj_vals[index1_rev] = val;
-        conj_vals[index2_rev] = val;
-        // -- Note: conj_vals[index2_rev] should be set to conj(val), but since we
-        //    assume values[i] is non-complex, val == conj(val)
+        // -- Note: The conjugate slot of index1_rev is index2_rev = bitrev(n - index1 - 1, logn)
+        //    = n - index1_rev - 1, and exactly one of the two is in the first half. It should be
+        //    set to conj(values[i]), but since we assume values[i] is non-complex, they are equal.
+        size_t idx = (index1_rev < half) ? index1_rev : (n - index1_rev - 1);
+        vec[idx]   = values[i];
     }
 
+#ifdef SE_IFFT_SINGLE_PRECISION
+    SE_UNUSED(ifft_roots);
+    ifft_real_float_inpl(vec, n, logn);
+
+    // -- Combine ifft step of dividing by n with ckks step of scaling by "scale". The outputs of
+    //    ifft_real_float_inpl are half of the ifft outputs, so this is really scale / (n/2). Stay in
+    //    single precision so that we never need double precision (soft-float) arithmetic.
+    float n_inv = (float)(scale / (double)half);
+    se_assert(fabsf(n_inv) > 0);
+
+    // -- Note: conj_vals_int[i] is twice the size of vec[i], so convert from the back to avoid
+    //    overwriting values we still need
+    int64_t *conj_vals_int = (int64_t *)conj_vals;
+    for (size_t i = n; i-- > 0;)
+    {
+        float coeff = roundf(vec[i] * n_inv);
+
+        // -- Check to make sure value can fit in an int64_t
+        if (fabsf(coeff) > (float)MAX_INT_64_DOUBLE)
+        {
+            printf("Error! Value at index %zu is possibly too large.\n", i);
+            printf("coeff:             %0.6f\n", (double)coeff);
+            return false;
+        }
+        conj_vals_int[i] = (int64_t)(coeff);
+    }
+#else
 #ifdef SE_VERBOSE_TESTING
     // print_poly_uint16("index_map", index_map, n);
-    print_poly_double_complex("conj_vals inside", conj_vals, n);
+    print_poly_double("conj_vals inside", vec, n);
 #endif
 
+    const double complex *roots = ifft_roots;
 #ifdef SE_IFFT_LOAD_FULL
-    se_assert(ifft_roots);
-    load_ifft_roots(n, ifft_roots);
+    roots = load_ifft_roots(n, ifft_roots);
 #endif
 
-    // -- Note: ifft_roots argument will be ignored if SE_IFFT_OTF is defined
-    ifft_inpl(conj_vals, n, logn, ifft_roots);
+    // -- Note: roots will be ignored if SE_IFFT_OTF is defined
+    ifft_real_inpl(vec, n, logn, roots);
 
 #ifdef SE_VERBOSE_TESTING
-    print_poly_double_complex("ifft(conj_vals)           ", conj_vals, n);
+    print_poly_double("ifft(conj_vals)           ", vec, n);
 #endif
 
+    // -- The outputs of ifft_real_inpl are half of the ifft outputs, so divide by n/2 instead of n
 #ifdef SE_VERBOSE_TESTING
     // -- Don't combine ifft step of dividing by n with ckks step of scaling by "scale"
-    double n_inv = 1.0 / (double)n;
+    double n_inv = 1.0 / (double)half;
     se_assert(n_inv >= 0);
 
-    for (size_t i = 0; i < n; i++) conj_vals[i] *= n_inv;
-    print_poly_double_complex("conj_vals", conj_vals, n);
+    for (size_t i = 0; i < n; i++) vec[i] *= n_inv;
+    print_poly_double("conj_vals", vec, n);
 
     n_inv = scale;
 #else
     // -- Combine ifft step of dividing by n with ckks step of scaling by "scale"
-    double n_inv = scale / (double)n;
+    double n_inv = scale / (double)half;
 #endif
 
-    // -- We no longer need the imaginary part of conj_vals
+    // -- Note: conj_vals_int[i] and vec[i] are both 8 bytes, so this is safe in-place
     int64_t *conj_vals_int = (int64_t *)conj_vals;
     for (size_t i = 0; i < n; i++)
     {
-        // print_poly_double_complex("conj_vals", conj_vals, n);
-
-        double coeff = round(se_creal(conj_vals[i]) * n_inv);
+        double coeff = round(vec[i] * n_inv);
 
         // -- Check to make sure value can fit in an int64_t
         if (fabs(coeff) > MAX_INT_64_DOUBLE)
         {
             printf("Error! Value at index %zu is possibly too large.\n", i);
-            printf("se_creal(conj_vals[i]):      %0.6f\n", se_creal(conj_vals[i]));
+            printf("vec[i]:            %0.6f\n", vec[i]);
             printf("ninv:              %0.6f\n", n_inv);
             printf("coeff:             %0.6f\n", coeff);
             printf("fabs(coeff):       %0.6f\n", fabs(coeff));
@@ -204,9 +234,8 @@ bool ckks_encode_base(const Parms *parms, const flpt *values, size_t values_len,
         }
 
         conj_vals_int[i] = (int64_t)(coeff);
-        // conj_vals_int[i] = (int64_t)round((se_creal(conj_vals[i])) * n_inv);
-        // print_poly_int64("conj_vals_int", conj_vals_int, n);
     }
+#endif
 
 #ifdef SE_VERBOSE_TESTING
     print_poly_int64("conj_vals_int", conj_vals_int, n);
@@ -298,21 +327,26 @@ void se_print_relative_positions(const ZZ *st, const SE_PTRS *se_ptrs)
     if (!sym) { printf("\t           e1: %0.4f\n", ((ZZ *)se_ptrs->e1_ptr - st) / (double)n); }
     printf("\t      ternary: %0.4f\n", ((ZZ *)se_ptrs->ternary - st) / (double)n);
     printf("\t       values: %0.4f\n", ((ZZ *)se_ptrs->values - st) / (double)n);
+    if (sym) { printf("\t        ntt_s: %0.4f\n", ((ZZ *)se_ptrs->ntt_s_ptr - st) / (double)n); }
+    if (!sym) { printf("\t           pk: %0.4f\n", ((ZZ *)se_ptrs->pk_ptr - st) / (double)n); }
     printf("\n");
 }
 
 #ifdef SE_USE_MALLOC
 void se_print_addresses(const ZZ *mempool, const SE_PTRS *se_ptrs, size_t n, bool sym)
 {
-    size_t mempool_size = sym ? ckks_get_mempool_size_sym(n) : ckks_get_mempool_size_asym(n);
+    // -- Note: The end address does not include the ntt(s) or pk cache (if it exists)
+    size_t mempool_size = sym ? ckks_get_mempool_size_sym(n, 0) : ckks_get_mempool_size_asym(n, 0);
 #else
 void se_print_addresses(const ZZ *mempool, const SE_PTRS *se_ptrs)
 {
     size_t mempool_size = MEMPOOL_SIZE;
 #ifdef SE_ENCRYPT_TYPE_SYMMETRIC
     bool sym = 1;
+    mempool_size -= SK_NTT_PERSIST_SIZE;
 #else
     bool sym = 0;
+    mempool_size -= PK_PERSIST_SIZE;
 #endif
 #endif
     printf("\n\tPrinting addresses (nil == does not exist)...\n");
@@ -329,20 +363,29 @@ void se_print_addresses(const ZZ *mempool, const SE_PTRS *se_ptrs)
     if (!sym) printf("\t           e1: %p\n", se_ptrs->e1_ptr);
     printf("\t      ternary: %p\n", se_ptrs->ternary);
     printf("\t       values: %p\n", se_ptrs->values);
+    if (sym) printf("\t        ntt_s: %p\n", se_ptrs->ntt_s_ptr);
+    if (!sym) printf("\t           pk: %p\n", se_ptrs->pk_ptr);
     printf("\n");
 }
 
 #ifdef SE_USE_MALLOC
-void print_ckks_mempool_size(size_t n, bool sym)
+void print_ckks_mempool_size(size_t n, size_t nprimes, bool sym)
 {
     se_assert(n >= 16);
-    size_t mempool_size = sym ? ckks_get_mempool_size_sym(n) : ckks_get_mempool_size_asym(n);
+    size_t mempool_size =
+        sym ? ckks_get_mempool_size_sym(n, nprimes) : ckks_get_mempool_size_asym(n, nprimes);
     se_assert(mempool_size);
 #else
 void print_ckks_mempool_size(void)
 {
     size_t mempool_size = MEMPOOL_SIZE;
-    size_t n = SE_DEGREE_N;
+    size_t n            = SE_DEGREE_N;
+    size_t nprimes      = SE_NPRIMES;
+#ifdef SE_ENCRYPT_TYPE_SYMMETRIC
+    bool sym = 1;
+#else
+    bool sym = 0;
+#endif
 #endif
 
     size_t n_size_B  = n * sizeof(ZZ);
@@ -354,6 +397,18 @@ void print_ckks_mempool_size(void)
     bool alloc_values = 0;
 #endif
 
+    // -- The values buffer reuses the memory of the encryption buffers (see: mempool.h), so it
+    //    only adds to the total if it ends up above every other buffer
+    SE_MEMPOOL_BUF bufs[SE_MP_NBUFS];
+    se_mempool_layout(n, nprimes, sym, bufs);
+    size_t mempool_size_no_values = 0;
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        size_t end = bufs[i].offset + bufs[i].size;
+        if (i != SE_MP_ID_values && bufs[i].size && end > mempool_size_no_values)
+        { mempool_size_no_values = end; }
+    }
+
     const char *print_str1     = "\nTotal memory requirement (incl. values buffer)  :";
     const char *print_str2     = "\nTotal memory requirement (without values buffer):";
     const char *print_str_curr = alloc_values ? print_str1 : print_str2;
@@ -375,7 +430,9 @@ void print_ckks_mempool_size(void)
         else
             printf("%zu bytes] * %0.4f )\n\n", n_size_B, mempool_size / (double)n);
 
-        mempool_size -= n / 2;
+        mempool_size   = mempool_size_no_values;
         print_str_curr = print_str2;
     }
+    se_print_mempool_layout(n, nprimes, sym);
+    se_print_mempool_savings(n, nprimes, sym);
 }
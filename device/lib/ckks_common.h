@@ -11,6 +11,7 @@
 #include <stdbool.h>
 
 #include "defines.h"
+#include "mempool.h"
 #include "modulo.h"
 #include "parameters.h"
 #include "rng.h"
@@ -19,7 +20,7 @@
 Object that stores pointers to various objects for CKKS encode/encryption.
 For the following, n is the polynomial ring degree.
 
-@param conj_vals          Storage for output of encode
+@param conj_vals          Storage for encode (n/2 cflpt values, see: ckks_encode_base)
 @param ifft_roots         Roots for inverse fft (n double complex values)
 @param values             Floating point values to encode/encrypt
 @param ternary            Ternary polynomial ('s' for symmetric, 'u' for asymmetric).
@@ -32,10 +33,14 @@ For the following, n is the polynomial ring degree.
 @param ntt_pte_ptr        Used for adding the plaintext to the error.
                           If asymmetric, this is also used for ntt(u) and ntt(e1).
 @param e1_ptr             Second error polynomial (unused in symmetric case)
+@param ntt_s_ptr          ntt(s) for every prime in the modulus chain (only used in symmetric case
+                          if SE_SK_PERSISTENT_NTT is defined)
+@param pk_ptr             pk0 followed by pk1 for every prime in the modulus chain (only used in
+                          asymmetric case if SE_PK_PERSISTENT is defined)
 */
 typedef struct SE_PTRS
 {
-    double complex *conj_vals;
+    cflpt *conj_vals;
     double complex *ifft_roots;  // Roots for inverse fft (n double complex values)
     flpt *values;  // Floating point values to encode/encrypt (up to n/2 type-ZZ values)
     ZZ *ternary;   // Ternary polynomial ('s' for symmetric, 'u' for asymmetric).
@@ -49,6 +54,8 @@ typedef struct SE_PTRS
     ZZ *ntt_roots_ptr;        // Storage for NTT roots
     ZZ *ntt_pte_ptr;          // Used for adding the plaintext to the error.
     int8_t *e1_ptr;           // Second error polynomial (unused in symmetric case)
+    ZZ *ntt_s_ptr;            // ntt(s) for every prime (only if SE_SK_PERSISTENT_NTT)
+    ZZ *pk_ptr;               // pk0, pk1 for every prime (only if SE_PK_PERSISTENT)
 } SE_PTRS;
 
 /**
@@ -120,8 +127,12 @@ Note: index_map is non-const in case SE_INDEX_MAP_LOAD is defined (or, if
 SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM is defined and asymmetric encryption is used).
 
 Size req: 'values' can contain at most n/2 slots (i.e. n/2 ZZ values), where n is the polynomial
-ring degree. 'conj_vals' must contain space for n double complex values. If index map needs to be
-loaded (see 'Note' above), index_map must constain space for n uint16_t elements.
+ring degree. 'conj_vals' must contain space for n int64_t values (i.e., n/2 double complex values).
+Internally, only half of the (conjugate-symmetric) ifft input is stored, as n/2 real parts followed
+by n/2 imaginary parts (doubles, or floats if SE_IFFT_SINGLE_PRECISION is defined). If index map
+needs to be loaded (see 'Note' above), index_map must constain space for n uint16_t elements, and
+if SE_IFFT_LOAD_FULL is defined, ifft_roots must contain space for n double complex values. If
+SE_DATA_FROM_CODE_DIRECT is defined, both are read from code directly instead (and can be null).
 
 @param[in]  parms       Parameters set by ckks_setup
 @param[in]  values      Initial message array with (up to) n/2 slots
@@ -132,7 +143,7 @@ loaded (see 'Note' above), index_map must constain space for n uint16_t elements
 @returns                True on success, False on failure
 */
 bool ckks_encode_base(const Parms *parms, const flpt *values, size_t values_len,
-                      uint16_t *index_map, double complex *ifft_roots, double complex *conj_vals);
+                      uint16_t *index_map, double complex *ifft_roots, cflpt *conj_vals);
 
 /**
 Reduces all values in conj_vals_int modulo the current modulus and stores result in out.
@@ -202,12 +213,14 @@ Prints the addresses of various objects.
 void se_print_addresses(const ZZ *mempool, const SE_PTRS *se_ptrs, size_t n, bool sym);
 
 /**
-Prints a banner for the size of the memory pool
+Prints a banner for the size of the memory pool, followed by its layout and the savings from buffer
+reuse (see: mempool.h)
 
 @param[in] n        Polynomial ring degree
+@param[in] nprimes  Number of prime moduli
 @param[in] sym      Set to 1 if in symmetric mode
 */
-void print_ckks_mempool_size(size_t n, bool sym);
+void print_ckks_mempool_size(size_t n, size_t nprimes, bool sym);
 #else
 /**
 Prints the relative positions of various objects.
@@ -226,61 +239,18 @@ Prints the addresses of various objects.
 void se_print_addresses(const ZZ *mempool, const SE_PTRS *se_ptrs);
 
 /**
-Prints a banner for the size of the memory pool
+Prints a banner for the size of the memory pool, followed by its layout and the savings from buffer
+reuse (see: mempool.h)
 */
 void print_ckks_mempool_size(void);
 #endif
 
-// -- Calculate mempool size for no-malloc case
-#ifdef SE_IFFT_OTF
-#if defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
-#define MEMPOOL_SIZE_BASE 5 * SE_DEGREE_N
-#elif defined(SE_NTT_FAST)
-#define MEMPOOL_SIZE_BASE 7 * SE_DEGREE_N
-#else
-#define MEMPOOL_SIZE_BASE 4 * SE_DEGREE_N
-#endif
-#else
-#define MEMPOOL_SIZE_BASE 8 * SE_DEGREE_N
-#endif
-
-#if defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
-    defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM) || defined(SE_SK_INDEX_MAP_SHARED)
-#define SE_INDEX_MAP_PERSIST_SIZE_sym SE_DEGREE_N / 2
-#else
-#define SE_INDEX_MAP_PERSIST_SIZE_sym 0
-#endif
-
-#ifdef SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM
-#define SE_INDEX_MAP_PERSIST_SIZE_asym 0
-#else
-#define SE_INDEX_MAP_PERSIST_SIZE_asym SE_INDEX_MAP_PERSIST_SIZE_sym
-#endif
-
-#ifdef SE_SK_PERSISTENT
-#define SK_PERSIST_SIZE SE_DEGREE_N / 16
-#else
-#define SK_PERSIST_SIZE 0
-#endif
-
-#ifdef SE_MEMPOOL_ALLOC_VALUES
-#define VALUES_ALLOC_SIZE SE_DEGREE_N / 2
-#else
-#define VALUES_ALLOC_SIZE 0
-#endif
-
-#define MEMPOOL_SIZE_sym \
-    MEMPOOL_SIZE_BASE + SE_INDEX_MAP_PERSIST_SIZE_sym + SK_PERSIST_SIZE + VALUES_ALLOC_SIZE
-
-#ifdef SE_IFFT_OTF
-#define MEMPOOL_SIZE_BASE_Asym MEMPOOL_SIZE_BASE + SE_DEGREE_N + SE_DEGREE_N / 4 + SE_DEGREE_N / 16
-// 4n + n + n + n/4 + n/16
-#else
-#define MEMPOOL_SIZE_BASE_Asym MEMPOOL_SIZE_BASE
-#endif
+// -- Calculate mempool size for no-malloc case (see: mempool.h)
+#define SK_NTT_PERSIST_SIZE (SE_NPRIMES * SE_MP_SYM_SIZE_ntt_s * (SE_DEGREE_N / 16))
+#define PK_PERSIST_SIZE (SE_NPRIMES * SE_MP_ASYM_SIZE_pk * (SE_DEGREE_N / 16))
 
-#define MEMPOOL_SIZE_Asym \
-    MEMPOOL_SIZE_BASE_Asym + SE_INDEX_MAP_PERSIST_SIZE_asym + VALUES_ALLOC_SIZE
+#define MEMPOOL_SIZE_sym (SE_MP_SYM_UNITS * (SE_DEGREE_N / 16) + SK_NTT_PERSIST_SIZE)
+#define MEMPOOL_SIZE_Asym (SE_MP_ASYM_UNITS * (SE_DEGREE_N / 16) + PK_PERSIST_SIZE)
 
 #ifdef SE_ENCRYPT_TYPE_SYMMETRIC
 #define MEMPOOL_SIZE MEMPOOL_SIZE_sym
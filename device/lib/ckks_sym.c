@@ -16,6 +16,7 @@
 #include "defines.h"
 #include "fft.h"
 #include "fileops.h"
+#include "mempool.h"
 #include "modulo.h"
 #include "ntt.h"
 #include "parameters.h"
@@ -26,43 +27,20 @@
 #include "util_print.h"
 
 #ifdef SE_USE_MALLOC
-size_t ckks_get_mempool_size_sym(size_t degree)
+size_t ckks_get_mempool_size_sym(size_t degree, size_t nprimes)
 {
     se_assert(degree >= 16);
-    if (degree == SE_DEGREE_N) return MEMPOOL_SIZE_sym;
     size_t n            = degree;
-    size_t mempool_size = 4 * n;  // minimum
-
-#ifdef SE_IFFT_OTF
-#if defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
-    mempool_size += n;
-#elif defined(SE_NTT_FAST)
-    mempool_size += 2 * n;
-#endif
-#else
-    mempool_size += 4 * n;
-#endif
-
-#if defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
-    defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM) || defined(SE_SK_INDEX_MAP_SHARED)
-    mempool_size += n / 2;
-#endif
-
-#ifdef SE_SK_PERSISTENT
-    mempool_size += n / 16;
-#endif
-
-#ifdef SE_MEMPOOL_ALLOC_VALUES
-    mempool_size += n / 2;
-#endif
+    size_t unit         = n / 16;  // see: mempool.h
+    size_t mempool_size = SE_MP_SYM_UNITS * unit + nprimes * SE_MP_SYM_SIZE_ntt_s * unit;
 
     se_assert(mempool_size);
     return mempool_size;
 }
 
-ZZ *ckks_mempool_setup_sym(size_t degree)
+ZZ *ckks_mempool_setup_sym(size_t degree, size_t nprimes)
 {
-    size_t mempool_size = ckks_get_mempool_size_sym(degree);
+    size_t mempool_size = ckks_get_mempool_size_sym(degree, nprimes);
     ZZ *mempool         = calloc(mempool_size, sizeof(ZZ));
     // printf("mempool_size: %zu\n", mempool_size);
     if (!mempool)
@@ -80,68 +58,26 @@ void ckks_set_ptrs_sym(size_t degree, ZZ *mempool, SE_PTRS *se_ptrs)
     se_assert(mempool && se_ptrs);
     const size_t n = degree;
 
-    // -- First, set everything to set size or 0
-    se_ptrs->conj_vals         = (double complex *)mempool;
-    se_ptrs->conj_vals_int_ptr = (int64_t *)mempool;
-    se_ptrs->c1_ptr            = &(mempool[2 * n]);
-    se_ptrs->c0_ptr            = &(mempool[3 * n]);
-    se_ptrs->ntt_pte_ptr       = &(mempool[2 * n]);
-
-    se_ptrs->ternary       = &(mempool[3 * n]);  // default: SE_SK_NOT_PERSISTENT
-    se_ptrs->ifft_roots    = 0;                  // default: SE_IFFT_OTF
-    se_ptrs->index_map_ptr = 0;                  // default: SE_INDEX_MAP_OTF
-    se_ptrs->ntt_roots_ptr = 0;                  // default: SE_NTT_OTF
-    se_ptrs->values        = 0;
-
-    // -- Sizes
-    size_t ifft_roots_size        = 0;
-    size_t ntt_roots_size         = 0;
-    size_t index_map_persist_size = 0;
-    size_t s_persist_size         = 0;
-
-    // -- Set ifft_roots based on IFFT type
-#ifndef SE_IFFT_OTF
-    ifft_roots_size      = 4 * n;
-    se_ptrs->ifft_roots  = (double complex *)&(mempool[4 * n]);
-    se_ptrs->ntt_pte_ptr = &(mempool[6 * n]);
-#endif
-
-    // -- Set ntt_roots based on NTT type
-#if defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
-    ntt_roots_size         = n;
-    se_ptrs->ntt_roots_ptr = &(mempool[4 * n]);
-#elif defined(SE_NTT_FAST)
-    ntt_roots_size         = 2 * n;
-    se_ptrs->ntt_roots_ptr = &(mempool[4 * n]);
-#endif
-
-    size_t total_block2_size = ifft_roots_size ? ifft_roots_size : ntt_roots_size;
-
-    // -- Set pi inverse based on index map type
-#if defined(SE_INDEX_MAP_LOAD)
-    se_ptrs->index_map_ptr = (uint16_t *)(&(mempool[4 * n]));  // 16n / sizeof(ZZ) = 4n
-#elif defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
-    defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
-    // -- If ifft, this will be + the ifft_roots size
-    //    else, this will be + the ntt size
-    se_ptrs->index_map_ptr = (uint16_t *)(&(mempool[4 * n + total_block2_size]));
-    index_map_persist_size = n / 2;
-#endif
-
-#ifdef SE_SK_PERSISTENT
-    s_persist_size   = n / 16;
-    se_ptrs->ternary = &(mempool[4 * n + total_block2_size + index_map_persist_size]);
-#elif !defined(SE_IFFT_OTF) && defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
-    se_ptrs->ternary       = &(mempool[7 * n]);
-#elif defined(SE_SK_INDEX_MAP_SHARED)
-    se_ptrs->ternary       = &(mempool[4 * n]);
-    index_map_persist_size = n / 2;
-#endif
-
-#ifdef SE_MEMPOOL_ALLOC_VALUES
-    se_ptrs->values =
-        (flpt *)&(mempool[4 * n + total_block2_size + index_map_persist_size + s_persist_size]);
-#endif
+    // -- Every offset comes from the layout table in mempool.h. Unused buffers are set to 0.
+    se_ptrs->conj_vals         = SE_MP_PTR(SYM, cflpt, conj_vals, mempool, n);
+    se_ptrs->conj_vals_int_ptr = SE_MP_PTR(SYM, int64_t, conj_vals_int, mempool, n);
+    se_ptrs->c1_ptr            = SE_MP_PTR(SYM, ZZ, c1, mempool, n);
+    se_ptrs->c0_ptr            = SE_MP_PTR(SYM, ZZ, c0, mempool, n);
+    se_ptrs->ifft_roots        = SE_MP_PTR(SYM, double complex, ifft_roots, mempool, n);
+    se_ptrs->ntt_roots_ptr     = SE_MP_PTR(SYM, ZZ, ntt_roots, mempool, n);
+    se_ptrs->ntt_pte_ptr       = SE_MP_PTR(SYM, ZZ, ntt_pte, mempool, n);
+    se_ptrs->e1_ptr            = SE_MP_PTR(SYM, int8_t, e1, mempool, n);
+    se_ptrs->values            = SE_MP_PTR(SYM, flpt, values, mempool, n);
+    se_ptrs->ntt_s_ptr         = SE_MP_PTR(SYM, ZZ, ntt_s, mempool, n);
+    se_ptrs->pk_ptr            = SE_MP_PTR(SYM, ZZ, pk, mempool, n);
+
+    // -- The index map and s are either reloaded for every encode-encrypt sequence or persistent
+    se_ptrs->index_map_ptr = SE_MP_SYM_SIZE_index_map
+                                 ? SE_MP_PTR(SYM, uint16_t, index_map, mempool, n)
+                                 : SE_MP_PTR(SYM, uint16_t, index_map_persist, mempool, n);
+    se_ptrs->ternary       = SE_MP_SYM_SIZE_ternary
+                                 ? SE_MP_PTR(SYM, ZZ, ternary, mempool, n)
+                                 : SE_MP_PTR(SYM, ZZ, ternary_persist, mempool, n);
 
     size_t address_size = 4;
     se_assert(((ZZ *)se_ptrs->conj_vals) == ((ZZ *)se_ptrs->conj_vals_int_ptr));
@@ -174,10 +110,27 @@ void ckks_setup_s(const Parms *parms, uint8_t *seed, SE_PRNG *prng, ZZ *s)
     else
     {
         SE_UNUSED(prng);
-        load_sk(parms, s);
+        // -- s must persist in RAM, so copy it if it was read from code directly (it is only
+        //    2 bits per coefficient)
+        const ZZ *sk = load_sk(parms, s);
+        if (sk != s) memcpy(s, sk, parms->coeff_count / 4);
     }
 }
 
+void ckks_setup_ntt_s(Parms *parms, const ZZ *s_small, ZZ *ntt_roots, ZZ *ntt_s_cache)
+{
+    se_assert(parms && s_small && ntt_s_cache);
+    size_t n = parms->coeff_count;
+
+    ckks_reset_primes(parms);
+    for (size_t i = 0; i < parms->nprimes; i++)
+    {
+        ckks_calc_ntt_s_sym(parms, s_small, ntt_roots, &(ntt_s_cache[i * n]));
+        if ((i + 1) < parms->nprimes) next_modulus(parms);
+    }
+    ckks_reset_primes(parms);
+}
+
 void ckks_sym_init(const Parms *parms, uint8_t *share_seed, uint8_t *seed, SE_PRNG *shareable_prng,
                    SE_PRNG *prng, int64_t *conj_vals_int)
 {
@@ -198,7 +151,8 @@ void ckks_sym_init(const Parms *parms, uint8_t *share_seed, uint8_t *seed, SE_PR
 
 void ckks_encode_encrypt_sym(const Parms *parms, const int64_t *conj_vals_int,
                              const int8_t *ep_small, SE_PRNG *shareable_prng, ZZ *s_small,
-                             ZZ *ntt_pte, ZZ *ntt_roots, ZZ *c0_s, ZZ *c1, ZZ *s_save, ZZ *c1_save)
+                             const ZZ *ntt_s_cache, ZZ *ntt_pte, ZZ *ntt_roots, ZZ *c0_s, ZZ *c1,
+                             ZZ *s_save, ZZ *c1_save)
 {
     se_assert(parms);
 #ifdef SE_DISABLE_TESTING_CAPABILITY
@@ -230,50 +184,65 @@ void ckks_encode_encrypt_sym(const Parms *parms, const int64_t *conj_vals_int,
     // ----------------------------
     //    c0 = [-a*s + m + e]_Rq
     // ----------------------------
-    // -- Load s (if not already loaded)
-    // -- For now, we require s to be in small form.
-    se_assert(s_small);
-#ifdef SE_SK_NOT_PERSISTENT
-    se_assert(!parms->sample_s);
-    load_sk(parms, s_small);
-#elif defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
-    // -- Note that if we are here, ifft type is not otf, which means that SE_REVERSE_CT_GEN_ENABLED
-    //    cannot be defined. Therefore, we only have to check that the current
-    //    modulus is 0 to know that we are in the first prime of the modulus chain
-    if (parms->curr_modulus_idx == 0)
+    const ZZ *ntt_s = c0_s;
+    if (ntt_s_cache)
     {
-        se_assert(!parms->sample_s);
-        load_sk(parms, s_small);
+        // -- ntt(s) is resident for every prime, so we only need the roots for ntt(pte)
+        ntt_s = &(ntt_s_cache[parms->curr_modulus_idx * n]);
+        ntt_roots_initialize(parms, ntt_roots);
+#ifndef SE_DISABLE_TESTING_CAPABILITY
+        if (s_save) memcpy(s_save, ntt_s, n * sizeof(ZZ));
+#endif
     }
+    else
+    {
+        // -- Load s (if not already loaded). If it is read from code directly, s_small is not
+        //    written and we read s from code instead.
+        // -- For now, we require s to be in small form.
+        const ZZ *s = s_small;
+#ifdef SE_SK_NOT_PERSISTENT
+        se_assert(!parms->sample_s);
+        s = load_sk(parms, s_small);
+#elif defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
+        // -- Note that if we are here, ifft type is not otf, which means that
+        //    SE_REVERSE_CT_GEN_ENABLED cannot be defined. Therefore, we only have to check that
+        //    the current modulus is 0 to know that we are in the first prime of the modulus chain
+        if (parms->curr_modulus_idx == 0)
+        {
+            se_assert(!parms->sample_s);
+            load_sk(parms, s_small);
+        }
 #endif
-    // print_poly_small("s (small)", s_small, parms->coeff_count);
-
-    // -- Expand and store s in c0
-    // print_poly_uint8_full("s (small)", (uint8_t*)s_small, parms->coeff_count/4);
-    // print_poly_small_full("s (small)", s_small, parms->coeff_count);
-    expand_poly_ternary(s_small, parms, c0_s);
-    // print_poly_full("s", c0_s, parms->coeff_count);
-    // print_poly_ternary("s", c0_s, parms->coeff_count, false);
-
-    // -- Calculate [a*s]_Rq = [c1*s]_Rq. This will free up c1 space too.
-    //    First calculate ntt(s) and store in c0_s. Note that this will load
-    //    the ntt roots into ntt_roots memory as well (used later for
-    //    calculating ntt(pte))
-
-    // -- Note: Calling ntt_roots_initialize will do nothing if SE_NTT_OTF is defined
-    ntt_roots_initialize(parms, ntt_roots);
-    ntt_inpl(parms, ntt_roots, c0_s);
+        // print_poly_small("s (small)", s_small, parms->coeff_count);
+
+        // -- Expand and store s in c0
+        // print_poly_uint8_full("s (small)", (uint8_t*)s_small, parms->coeff_count/4);
+        // print_poly_small_full("s (small)", s_small, parms->coeff_count);
+        se_assert(s);
+        expand_poly_ternary(s, parms, c0_s);
+        // print_poly_full("s", c0_s, parms->coeff_count);
+        // print_poly_ternary("s", c0_s, parms->coeff_count, false);
+
+        // -- Calculate ntt(s) and store in c0_s. Note that this will load the ntt roots into
+        //    ntt_roots memory as well (used later for calculating ntt(pte))
+
+        // -- Note: Calling ntt_roots_initialize will do nothing if SE_NTT_OTF is defined
+        ntt_roots_initialize(parms, ntt_roots);
+        ntt_inpl(parms, ntt_roots, c0_s);
 #ifndef SE_DISABLE_TESTING_CAPABILITY
-    // -- Save ntt(reduced(s)) for later decryption
-    // print_poly_ternary("s (ntt)", c0_s, parms->coeff_count, false);
-    if (s_save) memcpy(s_save, c0_s, n * sizeof(c0_s[0]));
-        // print_poly_ternary("s_save (ntt)", s_save, parms->coeff_count, false);
+        // -- Save ntt(reduced(s)) for later decryption
+        // print_poly_ternary("s (ntt)", c0_s, parms->coeff_count, false);
+        if (s_save) memcpy(s_save, c0_s, n * sizeof(c0_s[0]));
+            // print_poly_ternary("s_save (ntt)", s_save, parms->coeff_count, false);
 #endif
-    poly_mult_mod_ntt_form_inpl(c0_s, c1, n, mod);
-    // print_poly("rlwe a*s  ", c0_s, n);
+    }
 
-    // -- Negate [a*s]_Rq to get [-a*s]_Rq
-    poly_neg_mod_inpl(c0_s, n, mod);
+    // -- If ntt_pte shares memory with c1 (e.g., if SE_IFFT_OTF is defined), calculate [-a*s]_Rq
+    //    in one pass now. This will free up c1 space too. Otherwise, the multiply by a, the
+    //    negation, the addition of ntt(m + e), and the final reduction of ntt(m + e) are all
+    //    fused into a single pass at the end.
+    bool pte_overlaps_c1 = (ntt_pte < c1 + n) && (c1 < ntt_pte + n);
+    if (pte_overlaps_c1) poly_mul_neg_mod(ntt_s, c1, n, mod, c0_s);
     // print_poly("rlwe -a*s ", c0_s, n);
 
     // -- Calculate reduce(m + e) == reduce(conj_vals_int) ---> store in ntt_pte
@@ -287,8 +256,11 @@ void ckks_encode_encrypt_sym(const Parms *parms, const int64_t *conj_vals_int,
 
     // -- Calculate ntt(m + e) = ntt(reduce(conj_vals_int)) = ntt(ntt_pte)
     //    and store result in ntt_pte. Note: ntt roots (if required) should already be
-    //    loaded from above
-    ntt_inpl(parms, ntt_roots, ntt_pte);
+    //    loaded from above. If ntt_pte is not c1, the result is only reduced to [0, 4q) here.
+    if (pte_overlaps_c1)
+        ntt_inpl(parms, ntt_roots, ntt_pte);
+    else
+        ntt_lazy_out_inpl(parms, ntt_roots, ntt_pte);
     // print_poly("ntt(m + e)", ntt_pte, n);
 
     // -- Debugging
@@ -296,10 +268,48 @@ void ckks_encode_encrypt_sym(const Parms *parms, const int64_t *conj_vals_int,
     // intt(parms, ntt_roots, ntt_pte);
     // print_poly_full("intt(ntt(pte))", ntt_pte, parms->coeff_count);
 
-    poly_add_mod_inpl(c0_s, ntt_pte, n, mod);
+    if (pte_overlaps_c1)
+        poly_add_mod_inpl(c0_s, ntt_pte, n, mod);
+    else
+        poly_mul_neg_add_mod(ntt_s, c1, ntt_pte, n, mod, c0_s);
     // print_poly("a*s + m + e (ntt form)", c0_s, n);
 }
 
+void ckks_calc_ntt_s_sym(const Parms *parms, const ZZ *s_small, ZZ *ntt_roots, ZZ *ntt_s)
+{
+    se_assert(parms && parms->small_s && s_small && ntt_s);
+    expand_poly_ternary(s_small, parms, ntt_s);
+
+    // -- Note: Calling ntt_roots_initialize will do nothing if SE_NTT_OTF is defined
+    ntt_roots_initialize(parms, ntt_roots);
+    ntt_inpl(parms, ntt_roots, ntt_s);
+}
+
+void ckks_encrypt_sym_ntt_s(const Parms *parms, const int64_t *conj_vals_int,
+                            SE_PRNG *shareable_prng, const ZZ *ntt_s, const ZZ *ntt_roots,
+                            ZZ *ntt_pte, ZZ *c0, ZZ *c1)
+{
+    se_assert(parms && conj_vals_int && ntt_s && ntt_pte && c0 && c1);
+    se_assert(ntt_pte != c0 && ntt_pte != c1);
+    const PolySizeType n = parms->coeff_count;
+    const Modulus *mod   = parms->curr_modulus;
+
+    // -- c1 = a <--- U
+    sample_poly_uniform(parms, shareable_prng, c1);
+
+    // -- c0 = [-a*s + m + e]_Rq, in a single pass after ntt(m + e)
+    ckks_calc_ntt_pte_sym(parms, conj_vals_int, ntt_roots, ntt_pte);
+    poly_mul_neg_add_mod(ntt_s, c1, ntt_pte, n, mod, c0);
+}
+
+void ckks_calc_ntt_pte_sym(const Parms *parms, const int64_t *conj_vals_int, const ZZ *ntt_roots,
+                           ZZ *ntt_pte)
+{
+    se_assert(parms && conj_vals_int && ntt_pte);
+    reduce_set_pte(parms, conj_vals_int, ntt_pte);
+    ntt_lazy_out_inpl(parms, ntt_roots, ntt_pte);
+}
+
 bool ckks_next_prime_sym(Parms *parms, ZZ *s)
 {
     se_assert(parms && !parms->is_asymmetric);
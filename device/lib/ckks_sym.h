@@ -18,22 +18,24 @@ Symmetric CKKS encryption.
 
 #ifdef SE_USE_MALLOC
 /**
-Returns the required size of the memory pool in units of sizeof(ZZ).
+Returns the required size of the memory pool in units of sizeof(ZZ) (see: mempool.h).
 
-@param[in] degree  Desired polynomial ring degree
-@returns           Required size of the memory pool units of sizeof(ZZ)
+@param[in] degree   Desired polynomial ring degree
+@param[in] nprimes  Number of prime moduli (only affects the size if SE_SK_PERSISTENT_NTT is defined)
+@returns            Required size of the memory pool units of sizeof(ZZ)
 */
-size_t ckks_get_mempool_size_sym(size_t degree);
+size_t ckks_get_mempool_size_sym(size_t degree, size_t nprimes);
 
 /**
 Sets up the memory pool for CKKS symmetric encryption.
 
 Note: This function calls calloc.
 
-@param[in] degree  Desired polynomial ring degree
-@returns           A handle to the memory pool
+@param[in] degree   Desired polynomial ring degree
+@param[in] nprimes  Number of prime moduli (only affects the size if SE_SK_PERSISTENT_NTT is defined)
+@returns            A handle to the memory pool
 */
-ZZ *ckks_mempool_setup_sym(size_t degree);
+ZZ *ckks_mempool_setup_sym(size_t degree, size_t nprimes);
 #endif
 
 /**
@@ -67,6 +69,24 @@ Size req: If seed is !NULL, seed must be SE_PRNG_SEED_BYTE_COUNT long.
 */
 void ckks_setup_s(const Parms *parms, uint8_t *seed, SE_PRNG *prng, ZZ *s);
 
+/**
+Computes ntt(s) for every prime in the modulus chain and stores the results in 'ntt_s_cache' (one
+block of n ZZ elements per prime, indexed by curr_modulus_idx). Should be called once, just after
+ckks_setup_s, if SE_SK_PERSISTENT_NTT is defined. The cache can then be passed to
+ckks_encode_encrypt_sym to skip the per-prime expansion and NTT of s.
+
+Note: Resets parms to the first prime of the modulus chain. If SE_NTT_OTF is not defined, overwrites
+'ntt_roots'.
+
+Size req: 'ntt_s_cache' must contain space for nprimes * n ZZ elements.
+
+@param[in,out] parms        Parameters set by ckks_setup
+@param[in]     s_small      Secret key in small (compressed) form
+@param         ntt_roots    Scratch space for NTT roots. Ignored if SE_NTT_OTF is defined.
+@param[out]    ntt_s_cache  ntt(s) for every prime in the modulus chain
+*/
+void ckks_setup_ntt_s(Parms *parms, const ZZ *s_small, ZZ *ntt_roots, ZZ *ntt_s_cache);
+
 /**
 Initializes values for a single full symmetric CKKS encryption. Samples the error (w/o respect to
 any prime). Should be called once per encode-encrypt sequence (just after ckks_encode_base).
@@ -100,7 +120,12 @@ ep_small to the compessed form of the error.
 @param[in]     ep_small        [Optional]. See description. For debugging only.
 @param[in,out] shareable_prng  PRNG instance needed to generate first component of ciphertexts. Is
                                safe to share.
-@param         ntt_pte         Scratch space. Will be used to store pt + e (in NTT form)
+@param[in]     s_small         Secret key in small form. Ignored if ntt_s_cache is !NULL.
+@param[in]     ntt_s_cache     [Optional]. ntt(s) for every prime, as set by ckks_setup_ntt_s. If
+                               !NULL, ntt(s) for the current prime is read from here instead of
+                               being recomputed from s_small.
+@param         ntt_pte         Scratch space. Will be used to store pt + e (in NTT form). Unless it
+                               shares memory with c1, is left lazily reduced to [0, 4q).
 @param         ntt_roots       Scratch space. May be used to load NTT roots.
 @param[out]    c0_s            1st component of the ciphertext. Stores n coeffs of size ZZ.
 @param[out]    c1              2nd component of the ciphertext. Stores n coeffs of size ZZ.
@@ -109,7 +134,59 @@ ep_small to the compessed form of the error.
 */
 void ckks_encode_encrypt_sym(const Parms *parms, const int64_t *conj_vals_int,
                              const int8_t *ep_small, SE_PRNG *shareable_prng, ZZ *s_small,
-                             ZZ *ntt_pte, ZZ *ntt_roots, ZZ *c0_s, ZZ *c1, ZZ *s_save, ZZ *c1_save);
+                             const ZZ *ntt_s_cache, ZZ *ntt_pte, ZZ *ntt_roots, ZZ *c0_s, ZZ *c1,
+                             ZZ *s_save, ZZ *c1_save);
+
+/**
+Computes the NTT form of the secret key w.r.t. the current modulus prime and places the result in
+'ntt_s'. Useful for amortizing the secret key NTT across multiple encryptions under the same prime
+(see: ckks_encrypt_sym_ntt_s).
+
+Note: If SE_NTT_OTF is not defined, this function initializes 'ntt_roots' for the current prime.
+
+@param[in]  parms      Parameters set by ckks_setup. parms->small_s must be set.
+@param[in]  s_small    Secret key in small (compressed) form
+@param[out] ntt_roots  NTT roots for the current prime. Ignored if SE_NTT_OTF is defined.
+@param[out] ntt_s      Secret key in NTT form w.r.t. the current prime. Stores n coeffs of size ZZ.
+*/
+void ckks_calc_ntt_s_sym(const Parms *parms, const ZZ *s_small, ZZ *ntt_roots, ZZ *ntt_s);
+
+/**
+Symmetrically encrypts an encoded (and error-added) plaintext for the current modulus prime using a
+precomputed NTT form of the secret key (see: ckks_calc_ntt_s_sym). Produces the same ciphertext as
+ckks_encode_encrypt_sym, but skips the secret key expansion and NTT as well as the NTT roots
+initialization. Unlike ckks_encode_encrypt_sym, c1 is never overwritten by the NTT of the plaintext.
+
+Size req: 'ntt_pte' must not overlap with c0 or c1.
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     conj_vals_int   Plaintext + error (output of ckks_sym_init)
+@param[in,out] shareable_prng  PRNG instance needed to generate first component of ciphertexts. Is
+                               safe to share.
+@param[in]     ntt_s           Secret key in NTT form w.r.t. the current prime
+@param[in]     ntt_roots       NTT roots for the current prime. Ignored if SE_NTT_OTF is defined.
+@param         ntt_pte         Scratch space. Will be used to store pt + e (in NTT form, lazily
+                               reduced to [0, 4q))
+@param[out]    c0              1st component of the ciphertext. Stores n coeffs of size ZZ.
+@param[out]    c1              2nd component of the ciphertext. Stores n coeffs of size ZZ.
+*/
+void ckks_encrypt_sym_ntt_s(const Parms *parms, const int64_t *conj_vals_int,
+                            SE_PRNG *shareable_prng, const ZZ *ntt_s, const ZZ *ntt_roots,
+                            ZZ *ntt_pte, ZZ *c0, ZZ *c1);
+
+/**
+Computes the NTT form of the encoded (and error-added) plaintext w.r.t. the current modulus prime.
+This is the part of ckks_encrypt_sym_ntt_s that does not depend on 'a', so callers may schedule it
+separately from sampling 'a' and computing c0 (see: se_encrypt_stream_seeded). Afterwards,
+c0 = [ntt_pte - ntt_s . a]_q (see: poly_mul_neg_add_mod).
+
+@param[in]  parms          Parameters set by ckks_setup
+@param[in]  conj_vals_int  Plaintext + error (output of ckks_sym_init)
+@param[in]  ntt_roots      NTT roots for the current prime. Ignored if SE_NTT_OTF is defined.
+@param[out] ntt_pte        ntt(pt + e), lazily reduced to [0, 4q). Stores n coeffs of size ZZ.
+*/
+void ckks_calc_ntt_pte_sym(const Parms *parms, const int64_t *conj_vals_int, const ZZ *ntt_roots,
+                           ZZ *ntt_pte);
 
 /**
 Updates parameters to next prime in modulus switching chain for symmetric CKKS encryption. Also
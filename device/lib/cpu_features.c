@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file cpu_features.c
+*/
+
+#include "cpu_features.h"
+
+#ifdef SE_CPU_FEATURES_X86
+
+#define SE_CPU_FEATURES_VALID 0x1
+#define SE_CPU_HAS_AVX2 0x2
+#define SE_CPU_HAS_AVX512F 0x4
+#define SE_CPU_HAS_AES 0x8
+
+// -- Cached feature bits. 0 until the CPU has been queried. Threads that race on the first use
+//    compute and store the same value, so relaxed atomics suffice.
+static unsigned se_cpu_features = 0;
+
+/**
+Returns the feature bits of the CPU, querying it on first use.
+
+@returns  Feature bits (SE_CPU_HAS_*), with SE_CPU_FEATURES_VALID set
+*/
+static unsigned se_cpu_features_get(void)
+{
+    unsigned features = __atomic_load_n(&se_cpu_features, __ATOMIC_RELAXED);
+    if (features) return features;
+
+    __builtin_cpu_init();
+    features = SE_CPU_FEATURES_VALID;
+    if (__builtin_cpu_supports("avx2")) features |= SE_CPU_HAS_AVX2;
+    if (__builtin_cpu_supports("avx512f")) features |= SE_CPU_HAS_AVX512F;
+    if (__builtin_cpu_supports("aes")) features |= SE_CPU_HAS_AES;
+    __atomic_store_n(&se_cpu_features, features, __ATOMIC_RELAXED);
+    return features;
+}
+
+bool se_cpu_has_avx2(void)
+{
+    return (se_cpu_features_get() & SE_CPU_HAS_AVX2) != 0;
+}
+
+bool se_cpu_has_avx512f(void)
+{
+    return (se_cpu_features_get() & SE_CPU_HAS_AVX512F) != 0;
+}
+
+bool se_cpu_has_aes(void)
+{
+    return (se_cpu_features_get() & SE_CPU_HAS_AES) != 0;
+}
+#endif
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file cpu_features.h
+
+Runtime CPU feature checks for the x86-64 SIMD kernels (see: SE_CPU_FEATURES_X86 in defines.h). The
+CPU is queried once, on first use, and the result is cached for all later checks, so the checks are
+cheap enough to make before every call to a kernel. Safe to call from multiple threads.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+
+#include "defines.h"
+
+#ifdef SE_CPU_FEATURES_X86
+/**
+@returns  True if the CPU supports AVX2
+*/
+bool se_cpu_has_avx2(void);
+
+/**
+@returns  True if the CPU supports AVX-512F
+*/
+bool se_cpu_has_avx512f(void);
+
+/**
+@returns  True if the CPU supports AES-NI
+*/
+bool se_cpu_has_aes(void);
+#endif
@@ -66,6 +66,14 @@ For compressed public keys and/or compressed ciphertexts
 */
 #define SE_PRNG_SEED_BYTE_COUNT 64
 
+/**
+Number of consecutive twiddle factors (per IFFT round) that the "on-the-fly" IFFT derives from the
+previous one with a single complex multiplication. Every SE_IFFT_OTF_RESYNC_INTERVAL-th twiddle is
+computed exactly (with cos and sin) instead, which bounds the accumulated floating point error.
+Set to 1 to compute every twiddle exactly.
+*/
+#define SE_IFFT_OTF_RESYNC_INTERVAL 64
+
 /**
 Data path to use if SE_DATA_PATH is not set in CMAKE
 */
@@ -123,6 +131,17 @@ some are not.)
     #endif
 #endif
 
+// ----- Inverse FFT precision
+#  if (SE_IFFT_PRECISION_TYPE == 0)
+    // -- Do nothing
+#elif (SE_IFFT_PRECISION_TYPE == 1)
+    #define SE_IFFT_SINGLE_PRECISION
+#else
+    #ifndef SE_CONFIG_ERROR
+    #define SE_CONFIG_ERROR
+    #endif
+#endif
+
 // ----- Randomness generation type
 #  if (SE_RAND_TYPE == 0)
     // -- Do nothing
@@ -136,6 +155,37 @@ some are not.)
     #endif
 #endif
 
+// ----- PRNG type
+/**
+Version tag of the seed format, sent as a single byte in front of the seed of a seeded ciphertext
+(see: SE_ENABLE_SYM_SEED_CT) so that the receiver expands the seed with the same PRNG (see:
+SE_PRNG_TYPE in user_defines.h).
+
+1 = SHAKE256(seed || le64(counter))
+2 = AES-256-CTR, key = seed[0:32], IV = le64(counter) || be64(0)
+3 = ChaCha20 (RFC 8439), key = seed[0:32], nonce = le64(counter) || le32(0)
+*/
+#  if (SE_PRNG_TYPE == 0)
+    #define SE_PRNG_SHAKE256
+    #define SE_PRNG_SEED_VERSION 1
+#elif (SE_PRNG_TYPE == 1)
+    #define SE_PRNG_AES_CTR
+    #define SE_PRNG_SEED_VERSION 2
+#elif (SE_PRNG_TYPE == 2)
+    #define SE_PRNG_CHACHA20
+    #define SE_PRNG_SEED_VERSION 3
+#else
+    #ifndef SE_CONFIG_ERROR
+    #define SE_CONFIG_ERROR
+    #endif
+#endif
+
+/**
+Number of bytes sent once per message in front of a seeded ciphertext (see: SE_ENABLE_SYM_SEED_CT):
+SE_PRNG_SEED_VERSION (1 byte), followed by the seed of the shareable prng.
+*/
+#define SE_SEED_CT_HEADER_BYTE_COUNT (1 + SE_PRNG_SEED_BYTE_COUNT)
+
 // ----- Inverse FFT type
 #  if (SE_IFFT_TYPE == 0)
     #define SE_IFFT_OTF
@@ -160,6 +210,9 @@ some are not.)
     #define SE_NTT_REG
 #elif (SE_NTT_TYPE == 3)
     #define SE_NTT_FAST
+#elif (SE_NTT_TYPE == 4)
+    #define SE_NTT_FAST
+    #define SE_NTT_FAST_MERGED
 #else
     #ifndef SE_CONFIG_ERROR
     #define SE_CONFIG_ERROR
@@ -190,6 +243,9 @@ some are not.)
     #define SE_SK_PERSISTENT_ACROSS_PRIMES
 #elif (SE_SK_TYPE == 2)
     #define SE_SK_PERSISTENT
+#elif (SE_SK_TYPE == 3)
+    #define SE_SK_PERSISTENT
+    #define SE_SK_PERSISTENT_NTT
 #else
     #ifndef SE_CONFIG_ERROR
     #define SE_CONFIG_ERROR
@@ -344,6 +400,9 @@ FFT type. For now, we only support "on-the-fly" for the FFT type.
     #define se_conj(x) conj(x)
     #define se_creal(x) creal(x)
     #define se_cimag(x) cimag(x)
+    #define se_conjf(x) conjf(x)
+    #define se_crealf(x) crealf(x)
+    #define se_cimagf(x) cimagf(x)
 #else
 static inline double complex se_conj(double complex val)
 {
@@ -360,6 +419,21 @@ static inline double se_cimag(double complex val)
     double *val_double = (double *)(&val);
     return val_double[1];
 }
+static inline float complex se_conjf(float complex val)
+{
+    float *val_float = (float *)(&val);
+    return _complex(val_float[0], -val_float[1]);
+}
+static inline float se_crealf(float complex val)
+{
+    float *val_float = (float *)(&val);
+    return val_float[0];
+}
+static inline float se_cimagf(float complex val)
+{
+    float *val_float = (float *)(&val);
+    return val_float[1];
+}
 #endif
 
 typedef size_t PolySizeType;
@@ -378,6 +452,13 @@ typedef size_t PolySizeType;
     #define PRIiZZ PRIi32
 #endif
 
+// -- Complex type of the encoder's IFFT buffer (see: SE_IFFT_PRECISION_TYPE)
+#ifdef SE_IFFT_SINGLE_PRECISION
+    typedef float complex cflpt;
+#else
+    typedef double complex cflpt;
+#endif
+
 /**
 Utility function to clear an array
 
@@ -414,8 +495,7 @@ static inline void se_secure_zero_memset(void *v, size_t n)
 // --------------------------------------------------------------
 #ifdef SE_ON_NRF5
     #undef SE_RAND_GETRANDOM
-    // #if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
-    #ifndef SE_DATA_FROM_CODE_COPY
+    #if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
     #define SE_DATA_FROM_CODE_COPY
     #endif
 #else
@@ -426,12 +506,15 @@ static inline void se_secure_zero_memset(void *v, size_t n)
 #ifdef SE_ON_SPHERE_M4
     #undef SE_RAND_GETRANDOM
     #undef SE_USE_MALLOC
-    // #if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
-    #ifndef SE_DATA_FROM_CODE_COPY
+    #if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
     #define SE_DATA_FROM_CODE_COPY
     #endif
 #endif
 
+#if !defined(SE_USE_MALLOC) || defined(SE_ON_SPHERE_M4) || defined(SE_ON_NRF5)
+    #undef SE_USE_PTHREADS
+#endif
+
 // -- Only need to check one case since only 2 cases are possible
 #ifdef SE_ASSERT_STANDARD
     #undef SE_ASSERT_CUSTOM
@@ -482,6 +565,11 @@ static inline void se_secure_zero_memset(void *v, size_t n)
     #define SE_FFT_OTF
 #endif
 
+// -- Single precision IFFT is only supported with the "on-the-fly" IFFT
+#ifndef SE_IFFT_OTF
+    #undef SE_IFFT_SINGLE_PRECISION
+#endif
+
 // -- FFT defines checking. (The order of these is important)
 #ifdef SE_FFT_OTF
     #undef SE_FFT_ONE_SHOT
@@ -499,13 +587,16 @@ static inline void se_secure_zero_memset(void *v, size_t n)
     #undef SE_NTT_ONE_SHOT
     #undef SE_NTT_REG
     #undef SE_NTT_FAST
+    #undef SE_NTT_FAST_MERGED
     #define SE_INTT_OTF
 #elif defined(SE_NTT_ONE_SHOT)
     #undef SE_NTT_REG
     #undef SE_NTT_FAST
+    #undef SE_NTT_FAST_MERGED
     #undef SE_INTT_FAST
 #elif defined(SE_NTT_REG)
     #undef SE_NTT_FAST
+    #undef SE_NTT_FAST_MERGED
     #undef SE_INTT_FAST
 #elif defined(SE_NTT_FAST)
     // -- Do nothing
@@ -530,6 +621,49 @@ static inline void se_secure_zero_memset(void *v, size_t n)
     #define SE_INTT_OTF
 #endif
 
+// -- SIMD backends are only implemented for 32-bit ZZ. On ARM, NEON or Helium (MVE) is selected at
+//    build time and covers polynomial arithmetic as well as the "fast" NTT (opt-in, see:
+//    SE_USE_SIMD_ARM). On x86-64, only the "fast" NTT is vectorized (and the instruction set is
+//    selected at runtime). The merged-layer "fast" NTT is always scalar.
+#if !defined(SE_PRIMESIZE_64)
+    #if defined(__ARM_NEON) || (defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1))
+        #ifdef SE_USE_SIMD_ARM
+            #define SE_SIMD_ARM
+            #if defined(SE_NTT_FAST) && !defined(SE_NTT_FAST_MERGED)
+                #define SE_NTT_SIMD_ARM
+            #endif
+        #endif
+    #elif defined(SE_USE_SIMD_NTT) && defined(SE_NTT_FAST) && !defined(SE_NTT_FAST_MERGED) && \
+        (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+        #define SE_NTT_SIMD_X86
+    #endif
+#endif
+
+// -- 4-way Keccak for the PRNG (see: prng_fill_buffer_x4). Selected at runtime on x86-64 hosts.
+#if defined(SE_USE_SIMD_PRNG) && (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define SE_KECCAK_X4_AVX2
+#endif
+
+// -- AES-NI for the AES-256-CTR PRNG (see: aes256ctr.c). Selected at runtime on x86-64 hosts.
+#if defined(SE_USE_SIMD_PRNG) && (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define SE_AES_NI
+#endif
+
+// -- AVX2 reduction in the uniform sampler (see: sample_poly_uniform). Selected at runtime on
+//    x86-64 hosts.
+#if defined(SE_USE_SIMD_PRNG) && !defined(SE_PRIMESIZE_64) && \
+    (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+    #define SE_UNIFORM_AVX2
+#endif
+
+// -- Runtime CPU feature checks for all of the x86-64 kernels above (see: cpu_features.h)
+#if defined(SE_NTT_SIMD_X86) || defined(SE_KECCAK_X4_AVX2) || defined(SE_AES_NI) || \
+    defined(SE_UNIFORM_AVX2)
+    #define SE_CPU_FEATURES_X86
+#endif
+
 // -- This must be after the IFFT sanity checks
 #ifdef SE_REVERSE_CT_GEN_ENABLED
     #if !(defined(SE_IFFT_OTF) && defined(SE_FFT_OTF))
@@ -537,6 +671,11 @@ static inline void se_secure_zero_memset(void *v, size_t n)
     #endif
 #endif
 
+// -- Caching ntt(s) requires s to be persistent
+#if defined(SE_SK_PERSISTENT_NTT) && !defined(SE_SK_PERSISTENT)
+    #define SE_SK_PERSISTENT
+#endif
+
 #ifdef SE_SK_PERSISTENT
     #undef SE_SK_PERSISTENT_ACROSS_PRIMES
     #undef SE_SK_NOT_PERSISTENT
@@ -557,8 +696,6 @@ static inline void se_secure_zero_memset(void *v, size_t n)
         #if defined(SE_INDEX_MAP_LOAD) 
             // -- If sym, we have nowhere to load index_map, so can indicate
             //    memory as persistent
-            // -- Optimization: Index_map and SK can share memory if SK is not
-            //    set as persistent
             #if defined(SE_SK_PERSISTENT)
                 // -- Indicate index map load memory as persistent
                 #undef SE_INDEX_MAP_LOAD
@@ -568,11 +705,32 @@ static inline void se_secure_zero_memset(void *v, size_t n)
                 #undef SE_SK_NOT_PERSISTENT
                 #define SE_SK_PERSISTENT_ACROSS_PRIMES
             #endif
-            #ifdef SE_SK_PERSISTENT_ACROSS_PRIMES
-                #define SE_SK_INDEX_MAP_SHARED
-            #endif
         #endif
     #endif
 #endif
 
+// -- This must be after all of the above. If the data is read from code directly, loading is free
+//    (the loaders return pointers into code memory), so there is no point in keeping a copy of
+//    loaded values in RAM.
+#ifdef SE_DATA_FROM_CODE_DIRECT
+    #if defined(SE_INDEX_MAP_LOAD_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
+        #undef SE_INDEX_MAP_LOAD_PERSIST
+        #undef SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM
+        #define SE_INDEX_MAP_LOAD
+    #endif
+    #ifdef SE_SK_PERSISTENT_ACROSS_PRIMES
+        #undef SE_SK_PERSISTENT_ACROSS_PRIMES
+        #define SE_SK_NOT_PERSISTENT
+    #endif
+    #undef SE_PK_PERSISTENT
+
+    // -- The NTT and INTT read their roots from code for every call (see: ntt_inpl, intt_inpl)
+    #if defined(SE_NTT_REG) || defined(SE_NTT_FAST)
+        #define SE_NTT_ROOTS_FROM_CODE
+    #endif
+    #if defined(SE_INTT_REG) || defined(SE_INTT_FAST)
+        #define SE_INTT_ROOTS_FROM_CODE
+    #endif
+#endif
+
 // clang-format on
@@ -118,16 +118,32 @@ void ifft_inpl(double complex *vec, size_t n, size_t logn, const double complex
     size_t h  = n / 2;                                  // number of groups
     for (size_t i = 0; i < logn; i++, tt *= 2, h /= 2)  // rounds
     {
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
         for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // groups
         {
-#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
             // -- The roots are assumed to be stored in a bit-reversed order
             //    in this case so that memory accesses are consecutive.
             double complex s = roots[root_idx++];
 #elif defined(SE_IFFT_OTF)
-
-            double complex s = se_conj(calc_root_otf(bitrev(h + j, logn), m));  // pairs
+        // -- The root for group j is conj(w^bitrev(h+j, logn)) = conj(w^(tt * (2r + 1))), where
+        //    r = bitrev(j, logn-1-i). Visiting the groups in order of r lets us walk the roots with
+        //    one complex multiplication by conj(w^(2tt)) per group instead of calling cos and sin
+        //    for every group. To bound the accumulated error, the root is recomputed exactly every
+        //    SE_IFFT_OTF_RESYNC_INTERVAL groups.
+        size_t logh           = logn - 1 - i;
+        double complex s_step = se_conj(calc_root_otf(2 * tt, m));
+        double complex s      = 1;
+        for (size_t r = 0; r < h; r++)  // groups
+        {
+            if (r % SE_IFFT_OTF_RESYNC_INTERVAL == 0)
+                s = se_conj(calc_root_otf(tt * (2 * r + 1), m));
+            else
+                s *= s_step;
+            size_t kstart = 2 * tt * bitrev(r, logh);
 #else
+        for (size_t kstart = 0; kstart < n; kstart += 2 * tt)  // groups
+        {
+            double complex s = 1;
             printf("Error! IFFT option not found!\n");
             exit(1);
 #endif
@@ -143,6 +159,115 @@ void ifft_inpl(double complex *vec, size_t n, size_t logn, const double complex
     }
 }
 
+/**
+Single precision version of calc_root_otf
+
+@param[in] k  Index of root to calculate
+@param[in] m  Degree of roots (i.e., 2n, where n is the transform size)
+@returns      The FFT root for index k
+*/
+static inline float complex calc_root_otf_float(size_t k, size_t m)
+{
+    k &= m - 1;
+    float angle = 2 * (float)M_PI * (float)k / (float)m;
+    return (float complex)_complex(cosf(angle), sinf(angle));
+}
+
+void ifft_real_inpl(double *vec, size_t n, size_t logn, const double complex *roots)
+{
+    se_assert(vec && n >= 4);
+    double *re = vec;
+    double *im = &(vec[n / 2]);
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
+    se_assert(roots);
+    size_t root_idx = 1;
+#else
+    SE_UNUSED(roots);
+    size_t m = n << 1;  // Degree of roots
+#endif
+
+    // -- Same as the first logn - 1 rounds of ifft_inpl, restricted to the groups in the first half
+    //    of the vector. (The first half of the vector is the left subtree of the first split of
+    //    X^n + 1, i.e., X^(n/2) - w^(n/2).) The last round of ifft_inpl would only combine the
+    //    first half with its complex conjugate.
+    size_t tt = 1;                                          // size of butterflies
+    size_t h  = n / 4;                                      // number of groups in the first half
+    for (size_t i = 0; i < logn - 1; i++, tt *= 2, h /= 2)  // rounds
+    {
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // groups
+        {
+            double complex s = roots[root_idx + j];
+#else
+        // -- See ifft_inpl. In the first half, r is even, so the roots are conj(w^(tt * (4r + 1)))
+        size_t logh           = logn - 2 - i;
+        double complex s_step = se_conj(calc_root_otf(4 * tt, m));
+        double complex s      = 1;
+        for (size_t r = 0; r < h; r++)  // groups
+        {
+            if (r % SE_IFFT_OTF_RESYNC_INTERVAL == 0)
+                s = se_conj(calc_root_otf(tt * (4 * r + 1), m));
+            else
+                s *= s_step;
+            size_t kstart = 2 * tt * bitrev(r, logh);
+#endif
+            double s_re = se_creal(s);
+            double s_im = se_cimag(s);
+            for (size_t k = kstart; k < (kstart + tt); k++)
+            {
+                double d_re = re[k] - re[k + tt];
+                double d_im = im[k] - im[k + tt];
+                re[k] += re[k + tt];
+                im[k] += im[k + tt];
+                re[k + tt] = d_re * s_re - d_im * s_im;
+                im[k + tt] = d_re * s_im + d_im * s_re;
+            }
+        }
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
+        root_idx += 2 * h;
+#endif
+    }
+}
+
+void ifft_real_float_inpl(float *vec, size_t n, size_t logn)
+{
+    se_assert(vec && n >= 4);
+    float *re = vec;
+    float *im = &(vec[n / 2]);
+    size_t m  = n << 1;  // Degree of roots
+
+    // -- Same as the SE_IFFT_OTF case of ifft_real_inpl. The root recurrence drifts faster in
+    //    single precision, so the roots are recomputed exactly 8 times as often.
+    size_t resync = SE_IFFT_OTF_RESYNC_INTERVAL / 8 ? SE_IFFT_OTF_RESYNC_INTERVAL / 8 : 1;
+    size_t tt     = 1;                                      // size of butterflies
+    size_t h      = n / 4;                                  // number of groups in the first half
+    for (size_t i = 0; i < logn - 1; i++, tt *= 2, h /= 2)  // rounds
+    {
+        size_t logh          = logn - 2 - i;
+        float complex s_step = se_conjf(calc_root_otf_float(4 * tt, m));
+        float complex s      = 1;
+        for (size_t r = 0; r < h; r++)  // groups
+        {
+            if (r % resync == 0)
+                s = se_conjf(calc_root_otf_float(tt * (4 * r + 1), m));
+            else
+                s *= s_step;
+            size_t kstart = 2 * tt * bitrev(r, logh);
+            float s_re    = se_crealf(s);
+            float s_im    = se_cimagf(s);
+            for (size_t k = kstart; k < (kstart + tt); k++)
+            {
+                float d_re = re[k] - re[k + tt];
+                float d_im = im[k] - im[k + tt];
+                re[k] += re[k + tt];
+                im[k] += im[k + tt];
+                re[k + tt] = d_re * s_re - d_im * s_im;
+                im[k + tt] = d_re * s_im + d_im * s_re;
+            }
+        }
+    }
+}
+
 void fft_inpl(double complex *vec, size_t n, size_t logn, const double complex *roots)
 {
     // print_poly_double_complex("vec[3603] ", &(vec[3603]), 1);
@@ -97,6 +97,41 @@ this function.
 */
 void ifft_inpl(double complex *vec, size_t n, size_t logn, const double complex *roots);
 
+/**
+In-place Inverse Fast-Fourier Transform of a conjugate-symmetric input (i.e., as set by the CKKS
+encoder, where the value at (bit-reversed) index n - 1 - i is the complex conjugate of the value at
+index i), whose output is therefore real. Only needs the n/2 input values in the first half of the
+(bit-reversed) input, and computes the n real outputs with an n/2-point transform (i.e., about
+half the work of ifft_inpl).
+
+Input and output are stored as n doubles: The first n/2 hold real parts, the last n/2 hold
+imaginary parts. On input, index i (i < n/2) holds the value at bit-reversed index i. On output,
+vec[j] = out[j] / 2 for all j < n, where out is the output of ifft_inpl on the full input.
+
+'roots' is ignored (and may be null) if SE_IFFT_OTF is chosen. Otherwise, these are the same roots
+as for ifft_inpl.
+
+Note: This function does not divide the final result by n. This step must be performed outside of
+this function.
+
+@param[in,out] vec    Input/Output vector of n double values (see above)
+@param[in]     n      Full IFFT transform size (i.e. polynomial degree)
+@param[in]     logn   Minimum number of bits required to represent n (i.e. log2(n))
+@param[in]     roots  [Optional]. As set by calc_ifft_roots or load_ifft_roots
+*/
+void ifft_real_inpl(double *vec, size_t n, size_t logn, const double complex *roots);
+
+/**
+Single precision version of ifft_real_inpl. Always computes the roots "on-the-fly" (see:
+SE_IFFT_OTF_RESYNC_INTERVAL), using only single precision arithmetic. Used by the encoder if
+SE_IFFT_SINGLE_PRECISION is defined.
+
+@param[in,out] vec   Input/Output vector of n float values (see: ifft_real_inpl)
+@param[in]     n     Full IFFT transform size (i.e. polynomial degree)
+@param[in]     logn  Minimum number of bits required to represent n (i.e. log2(n))
+*/
+void ifft_real_float_inpl(float *vec, size_t n, size_t logn);
+
 /**
 In-place forward Fast-Fourier Transform using the Harvey butterfly.
 'roots' is ignored (and may be null) if SE_FFT_OTF is chosen.
@@ -137,59 +137,68 @@ void read_from_image(const char *fpath, size_t bytes_expected, void *vec)
 }
 #endif
 
-void load_sk(const Parms *parms, ZZ *s)
+const ZZ *load_sk(const Parms *parms, ZZ *s)
 {
-    se_assert(parms && s);
+    se_assert(parms);
     size_t n = parms->coeff_count;
 
     // -- Image will always be in small form (2 bits per coeff)
     size_t bytes_expected = n / 4;
 #if defined(SE_DATA_FROM_CODE_COPY) || defined(SE_DATA_FROM_CODE_DIRECT)
 #ifndef SE_DEFINE_SK_DATA
+    SE_UNUSED(s);
+    SE_UNUSED(bytes_expected);
     printf("Error! Sk data must be defined\n");
     while (1)
         ;
 #elif defined(SE_DATA_FROM_CODE_COPY)
+    se_assert(s);
     // uint8_t *sk_bytes = (uint8_t*)s;
     // for(size_t i = 0; i < bytes_expected; i++) sk_bytes[i] = secret_key[i];
     memcpy(s, &(secret_key[0]), bytes_expected);
-    return;
+    return s;
 #else
-    SE_UNUSED(parms);
-    SE_UNUSED(n);
+    SE_UNUSED(s);
     SE_UNUSED(bytes_expected);
-    s = (ZZ *)(&(secret_key[0]));
-    return;
+    return (const ZZ *)(&(secret_key[0]));
 #endif
 #else
+    se_assert(s);
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/sk_%zu.dat", SE_DATA_PATH, n);
     // printf("Retrieving secret key from file located at: %s\n", fpath);
     read_from_image(fpath, bytes_expected, s);
+    return s;
 #endif
 }
 
-void load_pki(size_t i, const Parms *parms, ZZ *pki)
+const ZZ *load_pki(size_t i, const Parms *parms, ZZ *pki)
 {
     se_assert(i == 0 || i == 1);
-    se_assert(parms && pki);
+    se_assert(parms);
 
     size_t n    = parms->coeff_count;
     size_t midx = parms->curr_modulus_idx;
 #if defined(SE_DATA_FROM_CODE_COPY) || defined(SE_DATA_FROM_CODE_DIRECT)
 #ifndef SE_DEFINE_PK_DATA
+    SE_UNUSED(pki);
     SE_UNUSED(n);
     SE_UNUSED(midx);
     printf("Error! Pk data must be defined\n");
     while (1)
         ;
 #elif defined(SE_DATA_FROM_CODE_COPY)
+    se_assert(pki);
     // for(size_t k = 0; k < n; k++) pki[j] = pk_addr[k];
     memcpy(pki, pk_prime_addr[midx][i], n * sizeof(ZZ));
-#elif defined(SE_DATA_FROM_CODE_DIRECT)
-    pki = pk_prime_addr[midx][i];
+    return pki;
+#else
+    SE_UNUSED(pki);
+    SE_UNUSED(n);
+    return pk_prime_addr[midx][i];
 #endif
 #else
+    se_assert(pki);
     SE_UNUSED(midx);
     char fpath[MAX_FPATH_SIZE];
     ZZ q = parms->curr_modulus->value;
@@ -200,33 +209,39 @@ void load_pki(size_t i, const Parms *parms, ZZ *pki)
 #endif
 
     read_from_image(fpath, n * sizeof(ZZ), pki);
+    return pki;
 #endif
 }
 
 #if defined(SE_INDEX_MAP_LOAD) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
     defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
-void load_index_map(const Parms *parms, uint16_t *index_map)
+const uint16_t *load_index_map(const Parms *parms, uint16_t *index_map)
 {
+    se_assert(parms);
     size_t n = parms->coeff_count;
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(index_map);
     memcpy(index_map, &(index_map_store[0]), n * sizeof(uint16_t));
+    return index_map;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
-    SE_UNUSED(parms);
     SE_UNUSED(n);
-    index_map = (uint16_t *)&(index_map_store[0]);
+    SE_UNUSED(index_map);
+    return (const uint16_t *)&(index_map_store[0]);
 #else
+    se_assert(index_map);
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/index_map_%zu.dat", SE_DATA_PATH, n);
     read_from_image(fpath, n * sizeof(uint16_t), index_map);
+    return index_map;
 #endif
 }
 #endif
 
 #ifdef SE_IFFT_LOAD_FULL
-void load_ifft_roots(size_t n, double complex *ifft_roots)
+const double complex *load_ifft_roots(size_t n, double complex *ifft_roots)
 {
-    se_assert(ifft_roots);
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(ifft_roots);
     /*
     double *ifft_roots_double = (double *)(&(ifft_roots[0]));
     for (size_t i = 0; i < 2 * n; i += 2)
@@ -247,23 +262,27 @@ void load_ifft_roots(size_t n, double complex *ifft_roots)
     }
     */
     memcpy(ifft_roots, ifft_roots_save, n * sizeof(double complex));
+    return ifft_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    ifft_roots = (double complex *)&(ifft_roots_save[0]);
+    SE_UNUSED(ifft_roots);
+    return (const double complex *)&(ifft_roots_save[0]);
 #else
+    se_assert(ifft_roots);
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/ifft_roots_%zu.dat", SE_DATA_PATH, n);
     // printf("Retrieving ifft_roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(double complex), ifft_roots);
+    return ifft_roots;
 #endif
 }
 #endif
 
 #ifdef SE_FFT_LOAD_FULL
-void load_fft_roots(size_t n, double complex *fft_roots)
+const double complex *load_fft_roots(size_t n, double complex *fft_roots)
 {
-    se_assert(fft_roots);
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(fft_roots);
     /*
     double *fft_roots_double = (double *)(fft_roots);
     // -- This could be written more simply, but want to make clear
@@ -275,100 +294,120 @@ void load_fft_roots(size_t n, double complex *fft_roots)
     }
     */
     memcpy(fft_roots, fft_roots_save, n * sizeof(double complex));
+    return fft_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    fft_roots = (double complex *)&(fft_roots_store[0]);
+    SE_UNUSED(fft_roots);
+    return (const double complex *)&(fft_roots_save[0]);
 #else
+    se_assert(fft_roots);
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/fft_roots_%zu.dat", SE_DATA_PATH, n);
     // printf("Retrieving fft_roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(double complex), fft_roots);
+    return fft_roots;
 #endif
 }
 #endif
 
 #ifdef SE_NTT_REG
-void load_ntt_roots(const Parms *parms, ZZ *ntt_roots)
+const ZZ *load_ntt_roots(const Parms *parms, ZZ *ntt_roots)
 {
-    se_assert(parms && ntt_roots);
+    se_assert(parms);
     size_t n    = parms->coeff_count;
     size_t midx = parms->curr_modulus_idx;
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(ntt_roots);
     // for(size_t i = 0; i < n; i++)
     // { ntt_roots[i] = ntt_roots_addr[midx][i]; }
     memcpy(ntt_roots, ntt_roots_addr[midx], n * sizeof(ZZ));
+    return ntt_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    ntt_roots = ntt_roots_addr[midx];
+    SE_UNUSED(ntt_roots);
+    return ntt_roots_addr[midx];
 #else
+    se_assert(ntt_roots);
     SE_UNUSED(midx);
     ZZ q = parms->curr_modulus->value;
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/ntt_roots_%zu_%" PRIuZZ ".dat", SE_DATA_PATH, n, q);
     // printf("Retrieving ntt roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(ZZ), ntt_roots);
+    return ntt_roots;
 #endif
 }
 #endif
 
 #ifdef SE_INTT_REG
-void load_intt_roots(const Parms *parms, ZZ *intt_roots)
+const ZZ *load_intt_roots(const Parms *parms, ZZ *intt_roots)
 {
-    se_assert(parms && intt_roots);
+    se_assert(parms);
     size_t n    = parms->coeff_count;
     size_t midx = parms->curr_modulus_idx;
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(intt_roots);
     // for(size_t i = 0; i < n; i++)
     // { intt_roots[i] = intt_roots_addr[midx][i]; }
     memcpy(intt_roots, intt_roots_addr[midx], n * sizeof(ZZ));
+    return intt_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    intt_roots = intt_roots_addr[midx];
+    SE_UNUSED(intt_roots);
+    return intt_roots_addr[midx];
 #else
+    se_assert(intt_roots);
     SE_UNUSED(midx);
     ZZ q = parms->curr_modulus->value;
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/intt_roots_%zu_%" PRIuZZ ".dat", SE_DATA_PATH, n, q);
     // printf("Retrieving inverse ntt roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(ZZ), intt_roots);
+    return intt_roots;
 #endif
 }
 #endif
 
 #ifdef SE_NTT_FAST
-void load_ntt_fast_roots(const Parms *parms, MUMO *ntt_fast_roots)
+const MUMO *load_ntt_fast_roots(const Parms *parms, MUMO *ntt_fast_roots)
 {
-    se_assert(parms && ntt_fast_roots);
+    se_assert(parms);
     size_t n    = parms->coeff_count;
     size_t midx = parms->curr_modulus_idx;
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(ntt_fast_roots);
     // for (size_t i = 0; i < n; i++)
     // {
     //     ntt_fast_roots[i].operand  = ntt_roots_addr[midx][2 * i];
     //     ntt_fast_roots[i].quotient = ntt_roots_addr[midx][2 * i + 1];
     // }
     memcpy(ntt_fast_roots, ntt_roots_addr[midx], n * sizeof(MUMO));
+    return ntt_fast_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    ntt_fast_roots = ntt_roots_addr[midx];
+    SE_UNUSED(ntt_fast_roots);
+    return (const MUMO *)ntt_roots_addr[midx];
 #else
+    se_assert(ntt_fast_roots);
     SE_UNUSED(midx);
     ZZ q = parms->curr_modulus->value;
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/ntt_fast_roots_%zu_%" PRIuZZ ".dat", SE_DATA_PATH, n, q);
     // printf("Retrieving fast roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(MUMO), ntt_fast_roots);
+    return ntt_fast_roots;
 #endif
 }
 #endif
 
 #ifdef SE_INTT_FAST
-void load_intt_fast_roots(const Parms *parms, MUMO *intt_fast_roots)
+const MUMO *load_intt_fast_roots(const Parms *parms, MUMO *intt_fast_roots)
 {
-    se_assert(parms && intt_fast_roots);
+    se_assert(parms);
     size_t n    = parms->coeff_count;
     size_t midx = parms->curr_modulus_idx;
 #ifdef SE_DATA_FROM_CODE_COPY
+    se_assert(intt_fast_roots);
     /*
     for (size_t i = 0; i < n; i++)
     {
@@ -377,16 +416,20 @@ void load_intt_fast_roots(const Parms *parms, MUMO *intt_fast_roots)
     }
     */
     memcpy(intt_fast_roots, intt_roots_addr[midx], n * sizeof(MUMO));
+    return intt_fast_roots;
 #elif defined(SE_DATA_FROM_CODE_DIRECT)
     SE_UNUSED(n);
-    intt_fast_roots = intt_roots_addr[midx];
+    SE_UNUSED(intt_fast_roots);
+    return (const MUMO *)intt_roots_addr[midx];
 #else
+    se_assert(intt_fast_roots);
     SE_UNUSED(midx);
     ZZ q = parms->curr_modulus->value;
     char fpath[MAX_FPATH_SIZE];
     snprintf(fpath, MAX_FPATH_SIZE, "%s/intt_fast_roots_%zu_%" PRIuZZ ".dat", SE_DATA_PATH, n, q);
     // printf("Retrieving fast inverse ntt roots from file located at: %s\n", fpath);
     read_from_image(fpath, n * sizeof(MUMO), intt_fast_roots);
+    return intt_fast_roots;
 #endif
 }
 #endif
@@ -5,6 +5,10 @@
 @file fileops.h
 
 Load values from storage.
+
+Every loader returns a pointer to the loaded values, which callers should use instead of the buffer
+they passed in. If SE_DATA_FROM_CODE_DIRECT is defined, nothing is copied: the returned pointer
+points straight into the (read-only) arrays in code memory, so no RAM is needed to hold the values.
 */
 
 #pragma once
@@ -13,7 +17,7 @@ Load values from storage.
 #include "parameters.h"
 #include "uintmodarith.h"
 
-#if !defined(SE_DATA_FROM_CODE_COPY) || !defined(SE_DATA_FROM_CODE_DIRECT)
+#if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
 void read_from_image(const char *fpath, size_t bytes_expected, void *vec);
 #endif
 
@@ -34,8 +38,10 @@ bits.
 
 @param[in]  parms  Parameters set by ckks_setup
 @param[out] s      Secret key (in small form)
+@returns           's', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                   is defined (in which case 's' is not written and can be null)
 */
-void load_sk(const Parms *parms, ZZ *s);
+const ZZ *load_sk(const Parms *parms, ZZ *s);
 
 /**
 Loads (one component of) the public key from storage.
@@ -62,8 +68,10 @@ Space req: If SE_DATA_FROM_CODE_DIRECT is not defined, 'pki' should contain spac
 @param[in]  i      Requested polynomial component of the public key for the current modulus prime
 @param[in]  parms  Parameters set by ckks_setup
 @param[out] pki    Public key component
+@returns           'pki', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                   is defined (in which case 'pki' is not written and can be null)
 */
-void load_pki(size_t i, const Parms *parms, ZZ *pki);
+const ZZ *load_pki(size_t i, const Parms *parms, ZZ *pki);
 
 #if defined(SE_INDEX_MAP_LOAD) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
     defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
@@ -83,8 +91,10 @@ uint16_t values.
 
 @param[in]  parms      Parameters set by ckks_setup
 @param[out] index_map  Buffer containing index map values
+@returns               'index_map', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                       is defined (in which case 'index_map' is not written and can be null)
 */
-void load_index_map(const Parms *parms, uint16_t *index_map);
+const uint16_t *load_index_map(const Parms *parms, uint16_t *index_map);
 #endif
 
 #ifdef SE_IFFT_LOAD_FULL
@@ -104,8 +114,10 @@ complex values.
 
 @param[in]  n           Number of roots to load (i.e. polynomial degree)
 @param[out] ifft_roots  IFFT roots
+@returns                'ifft_roots', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                        is defined (in which case 'ifft_roots' is not written and can be null)
 */
-void load_ifft_roots(size_t n, double complex *ifft_roots);
+const double complex *load_ifft_roots(size_t n, double complex *ifft_roots);
 #endif
 
 #ifdef SE_FFT_LOAD_FULL
@@ -125,8 +137,10 @@ complex values.
 
 @param[in]  n          Number of roots to load (i.e. polynomial degree)
 @param[out] fft_roots  FFT roots
+@returns               'fft_roots', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                       is defined (in which case 'fft_roots' is not written and can be null)
 */
-void load_fft_roots(size_t n, double complex *fft_roots);
+const double complex *load_fft_roots(size_t n, double complex *fft_roots);
 #endif
 
 #ifdef SE_NTT_REG
@@ -151,8 +165,10 @@ values.
 
 @param[in]  n          Number of roots to load (i.e. polynomial degree)
 @param[out] ntt_roots  NTT roots
+@returns               'ntt_roots', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                       is defined (in which case 'ntt_roots' is not written and can be null)
 */
-void load_ntt_roots(const Parms *parms, ZZ *ntt_roots);
+const ZZ *load_ntt_roots(const Parms *parms, ZZ *ntt_roots);
 #endif
 
 #ifdef SE_INTT_REG
@@ -177,8 +193,10 @@ values.
 
 @param[in]  n           Number of roots to load (i.e. polynomial degree)
 @param[out] intt_roots  INTT roots
+@returns                'intt_roots', or a pointer into code memory if SE_DATA_FROM_CODE_DIRECT
+                        is defined (in which case 'intt_roots' is not written and can be null)
 */
-void load_intt_roots(const Parms *parms, ZZ *intt_roots);
+const ZZ *load_intt_roots(const Parms *parms, ZZ *intt_roots);
 #endif
 
 #ifdef SE_NTT_FAST
@@ -198,13 +216,16 @@ and in binary form. The file should be called "ntt_fast_roots_<n>_<q>.dat", wher
 of the polynomial degree, and <q> is the value of the modulus prime for the particular NTT
 component. Both of these files can be generated using the SEAL-Embedded adapter.
 
-Space req: If SE_DATA_FROM_CODE_DIRECT is not defined, 'fast_ntt_roots' must contain space
+Space req: If SE_DATA_FROM_CODE_DIRECT is not defined, 'ntt_fast_roots' must contain space
 for 2n ZZ values.
 
 @param[in]  n               Number of roots to load (i.e. polynomial degree)
-@param[out] ntt_roots_fast  "Fast" NTT roots
+@param[out] ntt_fast_roots  "Fast" NTT roots
+@returns                    'ntt_fast_roots', or a pointer into code memory if
+                            SE_DATA_FROM_CODE_DIRECT is defined (in which case 'ntt_fast_roots' is
+                            not written and can be null)
 */
-void load_ntt_fast_roots(const Parms *parms, MUMO *ntt_fast_roots);
+const MUMO *load_ntt_fast_roots(const Parms *parms, MUMO *ntt_fast_roots);
 #endif
 
 #ifdef SE_INTT_FAST
@@ -230,6 +251,9 @@ ZZ values.
 
 @param[in]  n                Number of roots to load (i.e. polynomial degree)
 @param[out] intt_fast_roots  "Fast" INTT roots
+@returns                     'intt_fast_roots', or a pointer into code memory if
+                             SE_DATA_FROM_CODE_DIRECT is defined (in which case 'intt_fast_roots' is
+                             not written and can be null)
 */
-void load_intt_fast_roots(const Parms *parms, MUMO *intt_fast_roots);
+const MUMO *load_intt_fast_roots(const Parms *parms, MUMO *intt_fast_roots);
 #endif
@@ -25,7 +25,7 @@ ZZ get_intt_root(size_t n, ZZ q);  // defined below
 
 void intt_roots_initialize(const Parms *parms, ZZ *intt_roots)
 {
-#ifdef SE_INTT_OTF
+#if defined(SE_INTT_OTF) || defined(SE_INTT_ROOTS_FROM_CODE)
     SE_UNUSED(parms);
     SE_UNUSED(intt_roots);
     return;
@@ -226,6 +226,14 @@ void intt_non_lazy_inpl(const Parms *parms, const ZZ *intt_roots, ZZ inv_n, ZZ l
 void intt_inpl(const Parms *parms, const ZZ *intt_roots, ZZ *vec)
 {
     se_assert(parms && parms->curr_modulus);
+#ifdef SE_INTT_ROOTS_FROM_CODE
+    // -- Read the roots for the current modulus prime from code directly (see: load_intt_roots)
+#ifdef SE_INTT_FAST
+    intt_roots = (const ZZ *)load_intt_fast_roots(parms, NULL);
+#else
+    intt_roots = load_intt_roots(parms, NULL);
+#endif
+#endif
     size_t n     = parms->coeff_count;
     Modulus *mod = parms->curr_modulus;
 
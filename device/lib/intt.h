@@ -28,6 +28,9 @@ If SE_INTT_ONE_SHOT is defined, will calculate INTT roots one by one.
 Else if  SE_INTT_FAST is defined, will load "fast"/"lazy" roots from file.
 Else (if SE_INTT_REG is defined), will load regular roots from file.
 
+If SE_INTT_ROOTS_FROM_CODE is defined (i.e., the roots are loaded and SE_DATA_FROM_CODE_DIRECT is
+defined), will do nothing, since the INTT reads the roots from code directly.
+
 Space req: If SE_DATA_FROM_CODE_DIRECT is not defined, 'intt_roots' should
 have space for n ZZ elements if SE_INTT_ONE_SHOT or SE_INTT_REG is defined,
 or 2n ZZ elements (i.e. n MUMO elements) if SE_INTT_FAST is defined.
@@ -41,7 +44,8 @@ void intt_roots_initialize(const Parms *parms, ZZ *intt_roots);
 Performs a negacyclic inverse NTT using the Harvey butterfly.
 
 @param[in]      parms       Parameters set by ckks_setup
-@param[in]      intt_roots  Roots set by intt_roots_initialize. Ignored if SE_INTT_OTF is defined.
+@param[in]      intt_roots  Roots set by intt_roots_initialize. Ignored if SE_INTT_OTF or
+                            SE_INTT_ROOTS_FROM_CODE is defined.
 @param[in, out] vec         Input/output polynomial of n ZZ elements
 */
 void intt_inpl(const Parms *parms, const ZZ *intt_roots, ZZ *vec);
@@ -0,0 +1,119 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file mempool.c
+*/
+
+#include "mempool.h"
+
+#include <stdio.h>
+
+#include "defines.h"
+#include "util_print.h"
+
+#define SE_MP_DESC(mode, id) SE_MP_DESC_ON(mode, id, SE_MP_##mode##_ON_##id)
+#define SE_MP_DESC_ON(mode, id, on) SE_MP_DESC_ON_(mode, id, on)
+#define SE_MP_DESC_ON_(mode, id, on)                                         \
+    {#id, (size_t)SE_MP_##mode##_OFF_##id, (size_t)SE_MP_##mode##_SIZE_##id, \
+     SE_MP_##mode##_LIVE_##id, SE_MP_ID_##on},
+#define SE_MP_DESC_SYM(id) SE_MP_DESC(SYM, id)
+#define SE_MP_DESC_ASYM(id) SE_MP_DESC(ASYM, id)
+
+// -- Layout tables, in units of n/16 ZZ values (per prime for ntt_s and pk)
+static const SE_MEMPOOL_BUF se_mempool_sym[SE_MP_NBUFS]  = {SE_MP_FOREACH(SE_MP_DESC_SYM)};
+static const SE_MEMPOOL_BUF se_mempool_asym[SE_MP_NBUFS] = {SE_MP_FOREACH(SE_MP_DESC_ASYM)};
+
+size_t se_mempool_layout(size_t n, size_t nprimes, bool sym, SE_MEMPOOL_BUF *bufs)
+{
+    se_assert(n >= 16 && bufs);
+    const SE_MEMPOOL_BUF *table = sym ? se_mempool_sym : se_mempool_asym;
+    size_t unit                 = n / 16;
+
+    size_t mempool_size = 0;
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        bufs[i]        = table[i];
+        bufs[i].offset = table[i].offset * unit;
+        bufs[i].size   = table[i].size * unit;
+        if (i == SE_MP_ID_ntt_s || i == SE_MP_ID_pk) bufs[i].size *= nprimes;
+        if (bufs[i].size && bufs[i].offset + bufs[i].size > mempool_size)
+        { mempool_size = bufs[i].offset + bufs[i].size; }
+    }
+    return mempool_size;
+}
+
+void se_print_mempool_layout(size_t n, size_t nprimes, bool sym)
+{
+    SE_MEMPOOL_BUF bufs[SE_MP_NBUFS];
+    size_t mempool_size = se_mempool_layout(n, nprimes, sym, bufs);
+
+    printf("Memory pool layout (%s, offsets and sizes in units of n = %zu ZZ values):\n",
+           sym ? "symmetric" : "asymmetric", n);
+    printf("\t%17s  %7s  %7s  %s\n", "buffer", "offset", "size", "live during");
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        const SE_MEMPOOL_BUF *buf = &(bufs[i]);
+        if (!buf->size) continue;
+        printf("\t%17s  %7.4f  %7.4f ", buf->name, buf->offset / (double)n, buf->size / (double)n);
+        if (buf->live & SE_MP_ENCODE_MAP) printf(" map");
+        if (buf->live & SE_MP_ENCODE_IFFT) printf(" ifft");
+        if (buf->live & SE_MP_ENCRYPT) printf(" encrypt");
+        if (buf->on != SE_MP_ID_none) printf(" (in place on %s)", bufs[buf->on].name);
+        printf("\n");
+    }
+    printf("Peak footprint: %zu bytes (%0.4f * n ZZ values)\n\n", mempool_size * sizeof(ZZ),
+           mempool_size / (double)n);
+}
+
+// -- Parameter sets of set_parms_ckks: degree and maximum number of primes
+static const size_t se_mempool_parms[][2] = {
+    {1024, 1}, {2048, 1}, {4096, 3}, {8192, 6}, {16384, 13}};
+
+/**
+Prints one row of the table of se_print_mempool_savings.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  Number of primes
+@param[in] sym      Set to 1 for the symmetric mode layout, 0 for the asymmetric one
+@param[in] curr     Set to 1 to mark the row as the current configuration
+*/
+static void se_print_mempool_savings_row(size_t n, size_t nprimes, bool sym, bool curr)
+{
+    SE_MEMPOOL_BUF bufs[SE_MP_NBUFS];
+    size_t mempool_size = se_mempool_layout(n, nprimes, sym, bufs);
+
+    // -- Without reuse, only buffers that are computed in place on another one would share memory
+    size_t no_reuse_size = 0;
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        if (bufs[i].on == SE_MP_ID_none) no_reuse_size += bufs[i].size;
+    }
+    se_assert(no_reuse_size >= mempool_size);
+    size_t saved = no_reuse_size - mempool_size;
+
+    printf("\t%6zu  %7zu  %10zu  %10zu  %10zu  %5.1f%%%s\n", n, nprimes, no_reuse_size * sizeof(ZZ),
+           mempool_size * sizeof(ZZ), saved * sizeof(ZZ), 100.0 * saved / (double)no_reuse_size,
+           curr ? "  (current)" : "");
+}
+
+void se_print_mempool_savings(size_t n, size_t nprimes, bool sym)
+{
+    size_t nparms = sizeof(se_mempool_parms) / sizeof(se_mempool_parms[0]);
+    bool found    = 0;
+    for (size_t i = 0; i < nparms; i++)
+    { found |= (se_mempool_parms[i][0] == n && se_mempool_parms[i][1] == nprimes); }
+
+    printf("Memory pool savings from buffer reuse (%s, in bytes):\n",
+           sym ? "symmetric" : "asymmetric");
+    printf("\t%6s  %7s  %10s  %10s  %10s  %6s\n", "n", "nprimes", "no reuse", "pool", "saved",
+           "saved");
+    if (!found) se_print_mempool_savings_row(n, nprimes, sym, 1);
+    for (size_t i = 0; i < nparms; i++)
+    {
+        size_t n_i       = se_mempool_parms[i][0];
+        size_t nprimes_i = se_mempool_parms[i][1];
+        se_print_mempool_savings_row(n_i, nprimes_i, sym, n_i == n && nprimes_i == nprimes);
+    }
+    printf("\n");
+}
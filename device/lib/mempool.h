@@ -0,0 +1,392 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file mempool.h
+
+Layout of the memory pool used for CKKS encode/encryption (see: SE_PTRS), as a table of buffers that
+is evaluated at compile time.
+
+Every buffer has a size, a set of phases during which it is live, and optionally another buffer that
+it is computed in place on top of (e.g., conj_vals_int is converted in place from conj_vals). The
+phases of one encode-encrypt sequence are:
+
+    SE_MP_ENCODE_MAP   Values are written to conj_vals (reads values and the index map)
+    SE_MP_ENCODE_IFFT  Inverse fft of conj_vals (reads the ifft roots)
+    SE_MP_ENCRYPT      Encryption w.r.t. each prime of the modulus chain (reads conj_vals_int)
+
+Buffers that must persist across calls (e.g., a persistent index map or secret key) are live in all
+phases. Buffers are placed in table order: each buffer is placed either on the buffer it is
+computed in place on, or on top of every buffer placed before it that is live in any of the same
+phases. Two buffers therefore only share memory if their lifetimes are disjoint or if one is
+computed in place on the other, and the pool size is the highest point reached by any buffer.
+Buffers that are needed in all phases come last, so that the ones that only live during encode can
+reuse the memory of the ones that only live during encryption (e.g., the ifft roots reuse the memory
+of c0 and c1, and the values reuse the memory of c1).
+
+All sizes and offsets are in units of n/16 ZZ values, so the layout does not depend on the ring
+degree. The only buffers whose size also depends on the number of primes (the ntt(s) cache in
+symmetric mode and the public key cache in asymmetric mode) go at the very end of the pool.
+
+To add a buffer, give it a size, phases, and an 'on' buffer (or 'none') for both modes below, and
+add it to SE_MP_FOREACH and SE_MP_LAYOUT.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "defines.h"
+
+// -- Phases of an encode-encrypt sequence (bit mask)
+#define SE_MP_ENCODE_MAP 0x1
+#define SE_MP_ENCODE_IFFT 0x2
+#define SE_MP_ENCRYPT 0x4
+#define SE_MP_PERSIST (SE_MP_ENCODE_MAP | SE_MP_ENCODE_IFFT | SE_MP_ENCRYPT)
+
+// -- Sizes of the buffers that depend on the configuration (in units of n/16 ZZ values). Values
+//    that are read from code directly (see: fileops.h) need no memory.
+#if defined(SE_IFFT_OTF) || (defined(SE_IFFT_LOAD_FULL) && defined(SE_DATA_FROM_CODE_DIRECT))
+#define SE_MP_IFFT_ROOTS_SIZE 0
+#else
+#define SE_MP_IFFT_ROOTS_SIZE 64  // n double complex values
+#endif
+
+#ifdef SE_NTT_ROOTS_FROM_CODE
+#define SE_MP_NTT_ROOTS_SIZE 0
+#elif defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
+#define SE_MP_NTT_ROOTS_SIZE 16
+#elif defined(SE_NTT_FAST)
+#define SE_MP_NTT_ROOTS_SIZE 32
+#else
+#define SE_MP_NTT_ROOTS_SIZE 0
+#endif
+
+#ifdef SE_MEMPOOL_ALLOC_VALUES
+#define SE_MP_VALUES_SIZE 8  // n/2 flpt values
+#else
+#define SE_MP_VALUES_SIZE 0
+#endif
+
+// ----------------------------------------------------------------------------------------------
+//   Symmetric mode: size, phases, and buffer computed in place on (or 'none')
+// ----------------------------------------------------------------------------------------------
+#define SE_MP_SYM_SIZE_conj_vals 32  // n/2 cflpt values
+#define SE_MP_SYM_LIVE_conj_vals (SE_MP_ENCODE_MAP | SE_MP_ENCODE_IFFT)
+#define SE_MP_SYM_ON_conj_vals none
+
+#define SE_MP_SYM_SIZE_conj_vals_int 32  // n int64_t values
+#define SE_MP_SYM_LIVE_conj_vals_int SE_MP_ENCRYPT
+#define SE_MP_SYM_ON_conj_vals_int conj_vals
+
+#define SE_MP_SYM_SIZE_c1 16
+#define SE_MP_SYM_LIVE_c1 SE_MP_ENCRYPT
+#define SE_MP_SYM_ON_c1 none
+
+#define SE_MP_SYM_SIZE_c0 16
+#define SE_MP_SYM_LIVE_c0 SE_MP_ENCRYPT
+#define SE_MP_SYM_ON_c0 none
+
+#define SE_MP_SYM_SIZE_ifft_roots SE_MP_IFFT_ROOTS_SIZE
+#define SE_MP_SYM_LIVE_ifft_roots SE_MP_ENCODE_IFFT
+#define SE_MP_SYM_ON_ifft_roots none
+
+#if defined(SE_INDEX_MAP_LOAD) && !defined(SE_DATA_FROM_CODE_DIRECT)
+#define SE_MP_SYM_SIZE_index_map 8  // n uint16_t values, loaded for every encode
+#else
+#define SE_MP_SYM_SIZE_index_map 0
+#endif
+#define SE_MP_SYM_LIVE_index_map SE_MP_ENCODE_MAP
+#define SE_MP_SYM_ON_index_map none
+
+// -- Values are copied in for every encode (see: se_encode_init) and only read by the map
+#define SE_MP_SYM_SIZE_values SE_MP_VALUES_SIZE
+#define SE_MP_SYM_LIVE_values SE_MP_ENCODE_MAP
+#define SE_MP_SYM_ON_values none
+
+#define SE_MP_SYM_SIZE_ntt_roots SE_MP_NTT_ROOTS_SIZE
+#define SE_MP_SYM_LIVE_ntt_roots SE_MP_ENCRYPT
+#define SE_MP_SYM_ON_ntt_roots none
+
+// -- If there is no ifft roots memory to reuse, ntt(pte) is computed on top of c1 (see:
+//    ckks_encode_encrypt_sym), which is then consumed before ntt(pte) is written
+#define SE_MP_SYM_SIZE_ntt_pte 16
+#define SE_MP_SYM_LIVE_ntt_pte SE_MP_ENCRYPT
+#if SE_MP_IFFT_ROOTS_SIZE == 0
+#define SE_MP_SYM_ON_ntt_pte c1
+#else
+#define SE_MP_SYM_ON_ntt_pte none
+#endif
+
+#define SE_MP_SYM_SIZE_e1 0  // unused in symmetric mode
+#define SE_MP_SYM_LIVE_e1 SE_MP_ENCRYPT
+#define SE_MP_SYM_ON_e1 none
+
+// -- s in small form. If it is loaded for every prime, it is loaded into c0 and expanded in place.
+#ifdef SE_SK_PERSISTENT
+#define SE_MP_SYM_SIZE_ternary 0
+#else
+#define SE_MP_SYM_SIZE_ternary 1
+#endif
+#define SE_MP_SYM_LIVE_ternary SE_MP_ENCRYPT
+#ifdef SE_SK_NOT_PERSISTENT
+#define SE_MP_SYM_ON_ternary c0
+#else
+#define SE_MP_SYM_ON_ternary none
+#endif
+
+#if defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
+    defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
+#define SE_MP_SYM_SIZE_index_map_persist 8
+#else
+#define SE_MP_SYM_SIZE_index_map_persist 0
+#endif
+#define SE_MP_SYM_LIVE_index_map_persist SE_MP_PERSIST
+#define SE_MP_SYM_ON_index_map_persist none
+
+#ifdef SE_SK_PERSISTENT
+#define SE_MP_SYM_SIZE_ternary_persist 1
+#else
+#define SE_MP_SYM_SIZE_ternary_persist 0
+#endif
+#define SE_MP_SYM_LIVE_ternary_persist SE_MP_PERSIST
+#define SE_MP_SYM_ON_ternary_persist none
+
+// -- Per prime
+#ifdef SE_SK_PERSISTENT_NTT
+#define SE_MP_SYM_SIZE_ntt_s 16
+#else
+#define SE_MP_SYM_SIZE_ntt_s 0
+#endif
+#define SE_MP_SYM_LIVE_ntt_s SE_MP_PERSIST
+#define SE_MP_SYM_ON_ntt_s none
+
+#define SE_MP_SYM_SIZE_pk 0  // unused in symmetric mode
+#define SE_MP_SYM_LIVE_pk SE_MP_PERSIST
+#define SE_MP_SYM_ON_pk none
+
+// ----------------------------------------------------------------------------------------------
+//   Asymmetric mode: size, phases, and buffer computed in place on (or 'none')
+// ----------------------------------------------------------------------------------------------
+#define SE_MP_ASYM_SIZE_conj_vals 32
+#define SE_MP_ASYM_LIVE_conj_vals (SE_MP_ENCODE_MAP | SE_MP_ENCODE_IFFT)
+#define SE_MP_ASYM_ON_conj_vals none
+
+#define SE_MP_ASYM_SIZE_conj_vals_int 32
+#define SE_MP_ASYM_LIVE_conj_vals_int SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_conj_vals_int conj_vals
+
+#define SE_MP_ASYM_SIZE_c1 16
+#define SE_MP_ASYM_LIVE_c1 SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_c1 none
+
+#define SE_MP_ASYM_SIZE_c0 16
+#define SE_MP_ASYM_LIVE_c0 SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_c0 none
+
+#define SE_MP_ASYM_SIZE_ifft_roots SE_MP_IFFT_ROOTS_SIZE
+#define SE_MP_ASYM_LIVE_ifft_roots SE_MP_ENCODE_IFFT
+#define SE_MP_ASYM_ON_ifft_roots none
+
+#if (defined(SE_INDEX_MAP_LOAD) || defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)) && \
+    !defined(SE_DATA_FROM_CODE_DIRECT)
+#define SE_MP_ASYM_SIZE_index_map 8
+#else
+#define SE_MP_ASYM_SIZE_index_map 0
+#endif
+#define SE_MP_ASYM_LIVE_index_map SE_MP_ENCODE_MAP
+#define SE_MP_ASYM_ON_index_map none
+
+#define SE_MP_ASYM_SIZE_values SE_MP_VALUES_SIZE
+#define SE_MP_ASYM_LIVE_values SE_MP_ENCODE_MAP
+#define SE_MP_ASYM_ON_values none
+
+#define SE_MP_ASYM_SIZE_ntt_roots SE_MP_NTT_ROOTS_SIZE
+#define SE_MP_ASYM_LIVE_ntt_roots SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_ntt_roots none
+
+// -- Holds ntt(u), then ntt(e1), then ntt(pte)
+#define SE_MP_ASYM_SIZE_ntt_pte 16
+#define SE_MP_ASYM_LIVE_ntt_pte SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_ntt_pte none
+
+#define SE_MP_ASYM_SIZE_e1 4  // n int8_t values
+#define SE_MP_ASYM_LIVE_e1 SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_e1 none
+
+#define SE_MP_ASYM_SIZE_ternary 1  // u in small form
+#define SE_MP_ASYM_LIVE_ternary SE_MP_ENCRYPT
+#define SE_MP_ASYM_ON_ternary none
+
+#if defined(SE_INDEX_MAP_PERSIST) || defined(SE_INDEX_MAP_LOAD_PERSIST)
+#define SE_MP_ASYM_SIZE_index_map_persist 8
+#else
+#define SE_MP_ASYM_SIZE_index_map_persist 0
+#endif
+#define SE_MP_ASYM_LIVE_index_map_persist SE_MP_PERSIST
+#define SE_MP_ASYM_ON_index_map_persist none
+
+#define SE_MP_ASYM_SIZE_ternary_persist 0
+#define SE_MP_ASYM_LIVE_ternary_persist SE_MP_PERSIST
+#define SE_MP_ASYM_ON_ternary_persist none
+
+#define SE_MP_ASYM_SIZE_ntt_s 0  // unused in asymmetric mode
+#define SE_MP_ASYM_LIVE_ntt_s SE_MP_PERSIST
+#define SE_MP_ASYM_ON_ntt_s none
+
+// -- Per prime (pk0 and pk1)
+#ifdef SE_PK_PERSISTENT
+#define SE_MP_ASYM_SIZE_pk 32
+#else
+#define SE_MP_ASYM_SIZE_pk 0
+#endif
+#define SE_MP_ASYM_LIVE_pk SE_MP_PERSIST
+#define SE_MP_ASYM_ON_pk none
+
+// ----------------------------------------------------------------------------------------------
+//   Placement
+// ----------------------------------------------------------------------------------------------
+/**
+Calls X(id) for every buffer, in placement order. The per-prime buffers must come last.
+*/
+#define SE_MP_FOREACH(X)                                                                         \
+    X(conj_vals) X(conj_vals_int) X(c1) X(c0) X(ifft_roots) X(index_map) X(values) X(ntt_roots) \
+        X(ntt_pte) X(e1) X(ternary) X(index_map_persist) X(ternary_persist) X(ntt_s) X(pk)
+
+#define SE_MP_ID_ENUM(id) SE_MP_ID_##id,
+typedef enum
+{
+    SE_MP_ID_none = -1,
+    SE_MP_FOREACH(SE_MP_ID_ENUM) SE_MP_NBUFS
+} SE_MP_ID;
+
+#define SE_MP_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define SE_MP_IN(mode, id, p) ((SE_MP_##mode##_LIVE_##id >> (p)) & 1)
+
+// -- Highest point reached so far (i.e., up to and including 'prev') in the phases of 'id'
+#define SE_MP_TOP_OF(mode, id, prev)                                             \
+    SE_MP_MAX(SE_MP_MAX(SE_MP_IN(mode, id, 0) ? SE_MP_##mode##_TOP0_##prev : 0,  \
+                        SE_MP_IN(mode, id, 1) ? SE_MP_##mode##_TOP1_##prev : 0), \
+              SE_MP_IN(mode, id, 2) ? SE_MP_##mode##_TOP2_##prev : 0)
+
+#define SE_MP_NEXT_TOP(mode, id, prev, p)                                \
+    ((SE_MP_IN(mode, id, p) && SE_MP_##mode##_SIZE_##id)                 \
+         ? SE_MP_MAX(SE_MP_##mode##_TOP##p##_##prev,                     \
+                     SE_MP_##mode##_OFF_##id + SE_MP_##mode##_SIZE_##id) \
+         : SE_MP_##mode##_TOP##p##_##prev)
+
+// -- Places 'id' after 'prev' (expands to enumerators). 'on' is expanded first, so the extra level.
+#define SE_MP_PLACE(mode, id, prev) SE_MP_PLACE_ON(mode, id, prev, SE_MP_##mode##_ON_##id)
+#define SE_MP_PLACE_ON(mode, id, prev, on) SE_MP_PLACE_ON_(mode, id, prev, on)
+#define SE_MP_PLACE_ON_(mode, id, prev, on)                                                   \
+    SE_MP_##mode##_OFF_##id = (SE_MP_##mode##_OFF_##on >= 0) ? SE_MP_##mode##_OFF_##on        \
+                                                              : SE_MP_TOP_OF(mode, id, prev), \
+    SE_MP_##mode##_TOP0_##id = SE_MP_NEXT_TOP(mode, id, prev, 0),                             \
+    SE_MP_##mode##_TOP1_##id = SE_MP_NEXT_TOP(mode, id, prev, 1),                             \
+    SE_MP_##mode##_TOP2_##id = SE_MP_NEXT_TOP(mode, id, prev, 2)
+
+// -- Expands to the offsets of every buffer, and SE_MP_<mode>_UNITS: the size of the pool without
+//    the per-prime buffers. The per-prime buffers are placed at the very end.
+#define SE_MP_LAYOUT(mode)                                                     \
+    enum                                                                       \
+    {                                                                          \
+        SE_MP_##mode##_OFF_none = -1,                                          \
+        SE_MP_##mode##_TOP0_start = 0,                                         \
+        SE_MP_##mode##_TOP1_start = 0,                                         \
+        SE_MP_##mode##_TOP2_start = 0,                                         \
+        SE_MP_PLACE(mode, conj_vals, start),                                   \
+        SE_MP_PLACE(mode, conj_vals_int, conj_vals),                           \
+        SE_MP_PLACE(mode, c1, conj_vals_int),                                  \
+        SE_MP_PLACE(mode, c0, c1),                                             \
+        SE_MP_PLACE(mode, ifft_roots, c0),                                     \
+        SE_MP_PLACE(mode, index_map, ifft_roots),                              \
+        SE_MP_PLACE(mode, values, index_map),                                  \
+        SE_MP_PLACE(mode, ntt_roots, values),                                  \
+        SE_MP_PLACE(mode, ntt_pte, ntt_roots),                                 \
+        SE_MP_PLACE(mode, e1, ntt_pte),                                        \
+        SE_MP_PLACE(mode, ternary, e1),                                        \
+        SE_MP_PLACE(mode, index_map_persist, ternary),                         \
+        SE_MP_PLACE(mode, ternary_persist, index_map_persist),                 \
+        SE_MP_##mode##_UNITS = SE_MP_MAX(                                      \
+            SE_MP_MAX(SE_MP_##mode##_TOP0_ternary_persist,                     \
+                      SE_MP_##mode##_TOP1_ternary_persist),                    \
+            SE_MP_##mode##_TOP2_ternary_persist),                              \
+        SE_MP_##mode##_OFF_ntt_s = SE_MP_##mode##_UNITS,                       \
+        SE_MP_##mode##_OFF_pk    = SE_MP_##mode##_UNITS                        \
+    }
+
+SE_MP_LAYOUT(SYM);
+SE_MP_LAYOUT(ASYM);
+
+/**
+Returns a pointer to a buffer of the memory pool, or NULL if the buffer is not used.
+
+@param[in] mempool  Memory pool
+@param[in] n        Polynomial ring degree
+@param[in] size     Size of the buffer (in units of n/16 ZZ values)
+@param[in] offset   Offset of the buffer (in units of n/16 ZZ values)
+@returns            Pointer to the buffer, or NULL if size is 0
+*/
+static inline void *se_mempool_ptr(ZZ *mempool, size_t n, size_t size, size_t offset)
+{
+    return size ? (void *)&(mempool[offset * (n / 16)]) : NULL;
+}
+
+/**
+Typed pointer to buffer 'id' of the memory pool for 'mode' (SYM or ASYM), or NULL if unused.
+*/
+#define SE_MP_PTR(mode, type, id, mempool, n) \
+    ((type *)se_mempool_ptr(mempool, n, SE_MP_##mode##_SIZE_##id, SE_MP_##mode##_OFF_##id))
+
+/**
+Description of a buffer of the memory pool, for a particular ring degree and number of primes.
+
+@param name    Name of the buffer
+@param offset  Offset of the buffer from the start of the memory pool (in ZZ values)
+@param size    Size of the buffer (in ZZ values), or 0 if the buffer is not used
+@param live    Phases during which the buffer is live (SE_MP_* bit mask)
+@param on      Buffer that this buffer is computed in place on top of, or SE_MP_ID_none
+*/
+typedef struct
+{
+    const char *name;
+    size_t offset;
+    size_t size;
+    uint8_t live;
+    SE_MP_ID on;
+} SE_MEMPOOL_BUF;
+
+/**
+Returns the layout of the memory pool.
+
+Size req: bufs must contain space for SE_MP_NBUFS SE_MEMPOOL_BUF values (indexed by SE_MP_ID)
+
+@param[in]  n        Polynomial ring degree
+@param[in]  nprimes  Number of primes
+@param[in]  sym      Set to 1 for the symmetric mode layout, 0 for the asymmetric one
+@param[out] bufs     Description of each buffer
+@returns             Size of the memory pool (in ZZ values)
+*/
+size_t se_mempool_layout(size_t n, size_t nprimes, bool sym, SE_MEMPOOL_BUF *bufs);
+
+/**
+Prints the layout of the memory pool, one buffer per line, followed by the peak footprint.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  Number of primes
+@param[in] sym      Set to 1 for the symmetric mode layout, 0 for the asymmetric one
+*/
+void se_print_mempool_layout(size_t n, size_t nprimes, bool sym);
+
+/**
+Prints a table of how much memory the layout saves by reusing the memory of buffers whose lifetimes
+are disjoint, compared to giving every buffer its own memory. Has one row for each parameter set of
+set_parms_ckks (with the maximum number of primes), and one for n and nprimes if they differ.
+
+@param[in] n        Polynomial ring degree of the current configuration
+@param[in] nprimes  Number of primes of the current configuration
+@param[in] sym      Set to 1 for the symmetric mode layout, 0 for the asymmetric one
+*/
+void se_print_mempool_savings(size_t n, size_t nprimes, bool sym);
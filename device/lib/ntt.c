@@ -12,6 +12,7 @@
 #include "defines.h"
 #include "fft.h"
 #include "fileops.h"
+#include "ntt_simd.h"
 #include "parameters.h"
 #include "polymodarith.h"
 #include "uintmodarith.h"
@@ -29,7 +30,7 @@ void ntt_roots_initialize(const Parms *parms, ZZ *ntt_roots)
     if (parms->skip_ntt_load) return;
 #endif
 
-#ifdef SE_NTT_OTF
+#if defined(SE_NTT_OTF) || defined(SE_NTT_ROOTS_FROM_CODE)
     SE_UNUSED(parms);
     SE_UNUSED(ntt_roots);
     return;
@@ -139,15 +140,19 @@ void ntt_non_lazy_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
 
     for (size_t i = 0; i < logn; i++, h *= 2, tt /= 2)  // rounds
     {
-        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // groups
-        {
 #ifdef SE_NTT_OTF
-            // printf("h+j: %zu\n", h+j);
-            // ZZ power = bitrev(h+j, logn);
-            // ZZ s     = exponentiate_uint_mod(root, power, mod);
-            ZZ power = h + j;
-            ZZ s = exponentiate_uint_mod_bitrev(root, power, logn, mod);
+        // -- The root for group j is w^bitrev(h+j, logn) = w_i * (w_i^2)^bitrev(j, i), where
+        //    w_i = w^(n/(2h)). Visiting the groups in bit-reversed order lets us walk the roots
+        //    with one multiplication per group instead of one exponentiation per group.
+        ZZ s = root;
+        for (size_t l = i + 1; l < logn; l++) s = mul_mod(s, s, mod);
+        const ZZ s_step = mul_mod(s, s, mod);
+        for (size_t m = 0; m < h; m++, s = mul_mod(s, s_step, mod))  // groups
+        {
+            size_t kstart = 2 * tt * bitrev(m, i);
 #else
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // groups
+        {
             se_assert(ntt_roots);
             ZZ s = ntt_roots[h + j];
 #endif
@@ -165,12 +170,11 @@ void ntt_non_lazy_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
 }
 #endif
 
-void ntt_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
-{
-    se_assert(parms && parms->curr_modulus && vec);
 #ifdef SE_NTT_FAST
-    se_assert(ntt_roots);
-    ntt_lazy_inpl(parms, (MUMO *)ntt_roots, vec);
+void ntt_fast_ref_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec)
+{
+    se_assert(parms && parms->curr_modulus && ntt_fast_roots && vec);
+    ntt_lazy_inpl(parms, ntt_fast_roots, vec);
     // print_poly_full("vec", vec, parms->coeff_count);
 
     // -- Finally, we might need to reduce coefficients modulo q, but we know each
@@ -183,11 +187,166 @@ void ntt_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
         if (vec[i] >= two_q) vec[i] -= two_q;
         if (vec[i] >= q) vec[i] -= q;
     }
+}
+#endif
+
+#ifdef SE_NTT_FAST_MERGED
+/**
+The Harvey butterfly (see: ntt_lazy_inpl). Assumes x, y in [0, 4q). Returns x, y in [0, 4q).
+
+@param[in,out] x      In: vec[k]; Out: vec[k] + s * vec[k+tt]
+@param[in,out] y      In: vec[k+tt]; Out: vec[k] - s * vec[k+tt]
+@param[in]     s      NTT root
+@param[in]     mod    Modulus
+@param[in]     two_q  2 * modulus value
+*/
+static inline void ntt_lazy_butterfly(ZZ *x, ZZ *y, const MUMO *s, const Modulus *mod, ZZ two_q)
+{
+    ZZ u = *x - (two_q & (ZZ)(-(ZZsign)(*x >= two_q)));
+    ZZ v = mul_mod_mumo_lazy(*y, s, mod);
+    *x   = u + v;
+    *y   = u + two_q - v;
+}
+
+/**
+Reduces a value in [0, 4q) to [0, q) (see: ntt_fast_ref_inpl).
+*/
+static inline ZZ ntt_lazy_reduce(ZZ x, ZZ q, ZZ two_q)
+{
+    if (x >= two_q) x -= two_q;
+    if (x >= q) x -= q;
+    return x;
+}
+
+void ntt_fast_merged_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec)
+{
+    se_assert(parms && parms->curr_modulus && ntt_fast_roots && vec);
+    size_t n     = parms->coeff_count;
+    Modulus *mod = parms->curr_modulus;
+    ZZ q         = mod->value;
+    ZZ two_q     = q << 1;
+    se_assert(n >= 4);
+
+    size_t h  = 1;
+    size_t tt = n / 2;
+
+    // -- If logn is odd, do the first level on its own so that the remaining levels pair up
+    if (parms->logn & 1)
+    {
+        for (size_t k = 0; k < tt; k++)
+        { ntt_lazy_butterfly(&(vec[k]), &(vec[k + tt]), &(ntt_fast_roots[1]), mod, two_q); }
+        h  = 2;
+        tt = n / 4;
+    }
+
+    // -- Two levels per pass: (h, tt) followed by (2h, tt/2). Group j of the first level is split
+    //    into groups 2j and 2j+1 of the second level, which use roots[2(h+j)] and roots[2(h+j)+1].
+    //    The 4 values of each (radix-4) butterfly stay in registers between the two levels.
+    for (; tt > 2; h *= 4, tt /= 4)
+    {
+        size_t half = tt / 2;
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)
+        {
+            const MUMO *s1  = &(ntt_fast_roots[h + j]);
+            const MUMO *s2a = &(ntt_fast_roots[2 * (h + j)]);
+            const MUMO *s2b = &(ntt_fast_roots[2 * (h + j) + 1]);
+            for (size_t k = kstart; k < (kstart + half); k++)
+            {
+                ZZ a = vec[k], b = vec[k + half], c = vec[k + tt], d = vec[k + tt + half];
+                ntt_lazy_butterfly(&a, &c, s1, mod, two_q);
+                ntt_lazy_butterfly(&b, &d, s1, mod, two_q);
+                ntt_lazy_butterfly(&a, &b, s2a, mod, two_q);
+                ntt_lazy_butterfly(&c, &d, s2b, mod, two_q);
+                vec[k]             = a;
+                vec[k + half]      = b;
+                vec[k + tt]        = c;
+                vec[k + tt + half] = d;
+            }
+        }
+    }
+
+    // -- Last pass (tt = 2), with the final reduction to [0, q) folded in
+    se_assert(tt == 2 && h == n / 4);
+    for (size_t j = 0, k = 0; j < h; j++, k += 4)
+    {
+        ZZ a = vec[k], b = vec[k + 1], c = vec[k + 2], d = vec[k + 3];
+        ntt_lazy_butterfly(&a, &c, &(ntt_fast_roots[h + j]), mod, two_q);
+        ntt_lazy_butterfly(&b, &d, &(ntt_fast_roots[h + j]), mod, two_q);
+        ntt_lazy_butterfly(&a, &b, &(ntt_fast_roots[2 * (h + j)]), mod, two_q);
+        ntt_lazy_butterfly(&c, &d, &(ntt_fast_roots[2 * (h + j) + 1]), mod, two_q);
+        vec[k]     = ntt_lazy_reduce(a, q, two_q);
+        vec[k + 1] = ntt_lazy_reduce(b, q, two_q);
+        vec[k + 2] = ntt_lazy_reduce(c, q, two_q);
+        vec[k + 3] = ntt_lazy_reduce(d, q, two_q);
+    }
+}
+#endif
+
+#ifdef SE_NTT_ROOTS_FROM_CODE
+/**
+Returns the NTT roots for the current modulus prime, read from code directly (see: load_ntt_roots).
+
+@param[in] parms  Parameters set by ckks_setup
+@returns          NTT roots (2n ZZ values if SE_NTT_FAST is defined, else n ZZ values)
+*/
+static inline const ZZ *ntt_roots_from_code(const Parms *parms)
+{
+#ifdef SE_NTT_FAST
+    return (const ZZ *)load_ntt_fast_roots(parms, NULL);
+#else
+    return load_ntt_roots(parms, NULL);
+#endif
+}
+#endif
+
+void ntt_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
+{
+    se_assert(parms && parms->curr_modulus && vec);
+#ifdef SE_NTT_ROOTS_FROM_CODE
+    ntt_roots = ntt_roots_from_code(parms);
+#endif
+#ifdef SE_NTT_FAST
+    se_assert(ntt_roots);
+#ifdef SE_NTT_FAST_MERGED
+    ntt_fast_merged_inpl(parms, (const MUMO *)ntt_roots, vec);
+    return;
+#elif defined(SE_NTT_SIMD_X86)
+    // -- Use the widest SIMD backend supported by the CPU (the output is the same either way)
+    SE_SIMD_LEVEL simd_level = ntt_simd_level();
+    if (simd_level == SE_SIMD_AVX512 && parms->coeff_count >= 32)
+    {
+        ntt_fast_avx512_inpl(parms, (const MUMO *)ntt_roots, vec);
+        return;
+    }
+    if (simd_level >= SE_SIMD_AVX2 && parms->coeff_count >= 16)
+    {
+        ntt_fast_avx2_inpl(parms, (const MUMO *)ntt_roots, vec);
+        return;
+    }
+#elif defined(SE_NTT_SIMD_ARM)
+    ntt_fast_arm_inpl(parms, (const MUMO *)ntt_roots, vec);
+    return;
+#endif
+    ntt_fast_ref_inpl(parms, (const MUMO *)ntt_roots, vec);
 #else
     ntt_non_lazy_inpl(parms, ntt_roots, vec);
 #endif
 }
 
+void ntt_lazy_out_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec)
+{
+#if defined(SE_NTT_FAST) && !defined(SE_NTT_FAST_MERGED) && !defined(SE_NTT_SIMD_X86) && \
+    !defined(SE_NTT_SIMD_ARM)
+#ifdef SE_NTT_ROOTS_FROM_CODE
+    ntt_roots = ntt_roots_from_code(parms);
+#endif
+    se_assert(parms && parms->curr_modulus && ntt_roots && vec);
+    ntt_lazy_inpl(parms, (const MUMO *)ntt_roots, vec);
+#else
+    ntt_inpl(parms, ntt_roots, vec);
+#endif
+}
+
 #if defined(SE_NTT_OTF) || defined(SE_NTT_ONE_SHOT)
 /**
 Helper function to return root for certain modulus prime values if SE_NTT_OTF or SE_NTT_ONE_SHOT is
@@ -232,6 +391,11 @@ ZZ get_ntt_root(size_t n, ZZ q)
                 case 1053818881: root = 503422; break;  // 30 bit
                 case 1054015489: root = 16768; break;   // 30 bit
                 case 1054212097: root = 7305; break;    // 30 bit
+                case 1055260673: root = 567297; break;  // 30 bit
+                case 1056178177: root = 505662; break;  // 30 bit
+                case 1056440321: root = 489258; break;  // 30 bit
+                case 1058209793: root = 100079; break;  // 30 bit
+                case 1060175873: root = 784333; break;  // 30 bit
 
                 default: {
                     printf("Error! Need first power of root for ntt, n = 4K\n");
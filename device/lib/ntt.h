@@ -31,6 +31,9 @@ Else, if SE_NTT_REG is defined, will load regular roots from file.
 Else, if SE_NTT_ONE_SHOT is defined, will calculate NTT roots one by one.
 Else, (SE_NTT_OTF), will do nothing ('ntt_roots' can be null and will be ignored).
 
+If SE_NTT_ROOTS_FROM_CODE is defined (i.e., the roots are loaded and SE_DATA_FROM_CODE_DIRECT is
+defined), will also do nothing, since the NTT reads the roots from code directly.
+
 Space req: 'ntt_roots' should have space for 2n ZZ elements if SE_NTT_FAST is defined or n ZZ
 elements if SE_NTT_ONE_SHOT or SE_NTT_REG is defined.
 
@@ -39,20 +42,88 @@ elements if SE_NTT_ONE_SHOT or SE_NTT_REG is defined.
 */
 void ntt_roots_initialize(const Parms *parms, ZZ *ntt_roots);
 
+/**
+Returns the number of ZZ elements required to store the NTT roots for a single modulus prime (i.e.,
+the space required by 'ntt_roots' in ntt_roots_initialize).
+
+@param[in] n  Polynomial ring degree
+@returns      0 if SE_NTT_ROOTS_FROM_CODE is defined, else 2n if SE_NTT_FAST is defined, n if
+              SE_NTT_ONE_SHOT or SE_NTT_REG is defined, else 0
+*/
+static inline size_t ntt_roots_size(size_t n)
+{
+#ifdef SE_NTT_ROOTS_FROM_CODE
+    SE_UNUSED(n);
+    return 0;
+#elif defined(SE_NTT_FAST)
+    return 2 * n;
+#elif defined(SE_NTT_ONE_SHOT) || defined(SE_NTT_REG)
+    return n;
+#else
+    SE_UNUSED(n);
+    return 0;
+#endif
+}
+
 /**
 Negacyclic in-place NTT using the Harvey butterfly.
 
-If SE_NTT_FAST is defined, will use "fast"(a.k.a. "lazy") NTT computation.
+If SE_NTT_FAST is defined, will use "fast"(a.k.a. "lazy") NTT computation. In this case, if
+SE_NTT_FAST_MERGED is defined, will merge two butterfly levels per pass. Otherwise, if
+SE_USE_SIMD_NTT (x86-64) or SE_USE_SIMD_ARM (ARM) is defined and the platform supports it, will use
+a SIMD implementation.
 Else, if SE_NTT_REG or SE_NTT_ONE_SHOT is defined, will use regular NTT computation.
 Else, (SE_NTT_OTF is defined), will use truly "on-the-fly" NTT computation. In this last
 case, 'ntt_roots' may be null (and will be ignored).
 
 @param[in]     parms      Parameters set by ckks_setup
-@param[in]     ntt_roots  NTT roots set by ntt_roots_initialize. Ignored if SE_NTT_OTF is defined.
+@param[in]     ntt_roots  NTT roots set by ntt_roots_initialize. Ignored if SE_NTT_OTF or
+                          SE_NTT_ROOTS_FROM_CODE is defined.
 @param[in,out] vec        Input/output polynomial of n ZZ elements
 */
 void ntt_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec);
 
+/**
+Same as ntt_inpl, but the output coefficients are only guaranteed to be in [0, 4q) instead of
+[0, q). If the scalar "fast" NTT is used, this skips the final reduction pass over 'vec', so that
+the reduction can be fused into a later pass (see: poly_mul_neg_add_mod). Otherwise, this is the
+same as ntt_inpl (i.e., if the final reduction is already folded into the last level).
+
+@param[in]     parms      Parameters set by ckks_setup
+@param[in]     ntt_roots  NTT roots set by ntt_roots_initialize. Ignored if SE_NTT_OTF or
+                          SE_NTT_ROOTS_FROM_CODE is defined.
+@param[in,out] vec        Input/output polynomial of n ZZ elements
+*/
+void ntt_lazy_out_inpl(const Parms *parms, const ZZ *ntt_roots, ZZ *vec);
+
+#ifdef SE_NTT_FAST
+/**
+Negacyclic in-place "fast" (a.k.a. "lazy") NTT using the Harvey butterfly, followed by a final
+reduction to [0, q). This is the portable scalar implementation, which ntt_inpl uses when no SIMD
+backend is available. Always available when SE_NTT_FAST is defined, so that SIMD backends can be
+checked against it.
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     ntt_fast_roots  NTT roots set by ntt_roots_initialize
+@param[in,out] vec             Input/output polynomial of n ZZ elements
+*/
+void ntt_fast_ref_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec);
+#endif
+
+#ifdef SE_NTT_FAST_MERGED
+/**
+Negacyclic in-place "fast" NTT that computes two butterfly levels per pass over 'vec' (i.e., a
+radix-4 butterfly on each set of 4 values), so it makes ceil(logn / 2) passes instead of logn + 1
+(including the final reduction, which is folded into the last pass). Uses the same roots and
+produces the same output as ntt_fast_ref_inpl.
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     ntt_fast_roots  NTT roots set by ntt_roots_initialize
+@param[in,out] vec             Input/output polynomial of n ZZ elements
+*/
+void ntt_fast_merged_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec);
+#endif
+
 /**
 Polynomial multiplication for inputs already in NTT form. 'res' and 'a' may share the same starting
 address (see: poly_mult_mod_ntt_form_inpl)
@@ -70,6 +141,25 @@ static inline void poly_mult_mod_ntt_form(const ZZ *a, const ZZ *b, size_t n, co
     poly_pointwise_mul_mod(a, b, n, mod, res);
 }
 
+/**
+Multiplies two polynomials by a common polynomial, all already in NTT form, in a single pass over
+the common polynomial 'b'. 'res0' and 'a0' (or 'res1' and 'a1') may share the same starting address.
+
+@param[in]  a0    Input polynomial 1, in NTT form, with n ZZ coefficients
+@param[in]  a1    Input polynomial 2, in NTT form, with n ZZ coefficients
+@param[in]  b     Common input polynomial, in NTT form, with n ZZ coefficients
+@param[in]  n     Number of coefficients in each polynomial
+@param[in]  mod   Modulus
+@param[out] res0  Result polynomial [a0 . b], in NTT form, with n ZZ coefficients
+@param[out] res1  Result polynomial [a1 . b], in NTT form, with n ZZ coefficients
+*/
+static inline void poly_mult_mod_ntt_form_pair(const ZZ *a0, const ZZ *a1, const ZZ *b, size_t n,
+                                               const Modulus *mod, ZZ *res0, ZZ *res1)
+{
+    // -- Inputs in NTT form can be multiplied component-wise
+    poly_pointwise_mul_mod_pair(a0, a1, b, n, mod, res0, res1);
+}
+
 /**
 In-place polynomial multiplication for inputs already in NTT form.
 
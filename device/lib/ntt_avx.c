@@ -0,0 +1,285 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file ntt_avx.c
+
+AVX2 and AVX-512 implementations of the "fast" (a.k.a. "lazy") NTT for x86-64 hosts. Each kernel is
+compiled with a function-level target attribute and selected at runtime (see: ntt_simd_level), so
+the rest of the library does not need to be compiled with any x86 extension flags.
+
+All kernels follow ntt_lazy_inpl exactly (the same Harvey butterfly on the same value ranges), so
+the output is bit-identical to the scalar implementation.
+*/
+
+#include "ntt_simd.h"
+
+#ifdef SE_NTT_SIMD_X86
+#include <immintrin.h>
+
+#include "cpu_features.h"
+#include "defines.h"
+#include "parameters.h"
+#include "uintmodarith.h"
+
+#define SE_TARGET_AVX2 __attribute__((target("avx2")))
+#define SE_TARGET_AVX512 __attribute__((target("avx512f")))
+
+SE_SIMD_LEVEL ntt_simd_level(void)
+{
+    if (se_cpu_has_avx512f()) return SE_SIMD_AVX512;
+    if (se_cpu_has_avx2()) return SE_SIMD_AVX2;
+    return SE_SIMD_NONE;
+}
+
+// ==============================================================================
+//                                    AVX2
+// ==============================================================================
+
+/**
+Returns the high 32 bits of the 32 x 32-bit product of each pair of lanes (see: mul_uint_high).
+*/
+static inline SE_TARGET_AVX2 __m256i mul_uint_high_avx2(__m256i a, __m256i b)
+{
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+    __m256i odd  = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/**
+The Harvey butterfly on 8 lanes (see: ntt_lazy_inpl). Assumes x, y in [0, 4q). Returns x, y in
+[0, 4q).
+
+@param[in,out] x      In: vec[k] values; Out: vec[k] + w * vec[k+tt] values
+@param[in,out] y      In: vec[k+tt] values; Out: vec[k] - w * vec[k+tt] values
+@param[in]     w      Root operands
+@param[in]     wq     Root quotients
+@param[in]     q      Modulus value (in every lane)
+@param[in]     two_q  2 * modulus value (in every lane)
+*/
+static inline SE_TARGET_AVX2 void butterfly_avx2(__m256i *x, __m256i *y, __m256i w, __m256i wq,
+                                                 __m256i q, __m256i two_q)
+{
+    // -- u = (x >= 2q) ? x - 2q : x. (If x < 2q, x - 2q wraps around to a value > x.)
+    __m256i u = _mm256_min_epu32(*x, _mm256_sub_epi32(*x, two_q));
+
+    // -- v = mul_mod_mumo_lazy(y, w)
+    __m256i op2 = mul_uint_high_avx2(*y, wq);
+    __m256i v   = _mm256_sub_epi32(_mm256_mullo_epi32(*y, w), _mm256_mullo_epi32(op2, q));
+
+    *x = _mm256_add_epi32(u, v);
+    *y = _mm256_sub_epi32(_mm256_add_epi32(u, two_q), v);
+}
+
+/**
+Loads the operands and quotients of 8 roots, where lane i uses root 'roots[idx[i]]'.
+*/
+static inline SE_TARGET_AVX2 void load_roots_avx2(const MUMO *roots, __m256i idx, __m256i *w,
+                                                  __m256i *wq)
+{
+    // -- Each MUMO is an (operand, quotient) pair of ZZ values
+    __m256i idx2 = _mm256_add_epi32(idx, idx);
+    *w           = _mm256_i32gather_epi32((const int *)roots, idx2, 4);
+    *wq = _mm256_i32gather_epi32((const int *)roots, _mm256_add_epi32(idx2, _mm256_set1_epi32(1)),
+                                 4);
+}
+
+void SE_TARGET_AVX2 ntt_fast_avx2_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec)
+{
+    se_assert(parms && ntt_fast_roots && vec);
+    size_t n = parms->coeff_count;
+    se_assert(n >= 16);
+    __m256i q     = _mm256_set1_epi32((int)parms->curr_modulus->value);
+    __m256i two_q = _mm256_add_epi32(q, q);
+    __m256i w, wq;
+
+    // -- Rounds with tt >= 8: all 8 lanes of a vector belong to the same group
+    size_t h  = 1;
+    size_t tt = n / 2;
+    for (; tt >= 8; h *= 2, tt /= 2)  // Rounds
+    {
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // Groups
+        {
+            const MUMO *s = &(ntt_fast_roots[h + j]);
+            w             = _mm256_set1_epi32((int)s->operand);
+            wq            = _mm256_set1_epi32((int)s->quotient);
+            for (size_t k = kstart; k < (kstart + tt); k += 8)  // Pairs
+            {
+                __m256i x = _mm256_loadu_si256((__m256i *)&(vec[k]));
+                __m256i y = _mm256_loadu_si256((__m256i *)&(vec[k + tt]));
+                butterfly_avx2(&x, &y, w, wq, q, two_q);
+                _mm256_storeu_si256((__m256i *)&(vec[k]), x);
+                _mm256_storeu_si256((__m256i *)&(vec[k + tt]), y);
+            }
+        }
+    }
+
+    // -- The last 3 rounds: each iteration loads 16 values (x0, x1) and rearranges them into
+    //    (a, b), where a holds the first and b the second element of each butterfly pair.
+
+    // -- tt = 4: 2 groups of 8 values. a = (x0.lo, x1.lo), b = (x0.hi, x1.hi)
+    __m256i idx4 = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+    for (size_t j = 0; j < h; j += 2)
+    {
+        ZZ *p      = &(vec[8 * j]);
+        __m256i x0 = _mm256_loadu_si256((__m256i *)p);
+        __m256i x1 = _mm256_loadu_si256((__m256i *)(p + 8));
+        __m256i a  = _mm256_permute2x128_si256(x0, x1, 0x20);
+        __m256i b  = _mm256_permute2x128_si256(x0, x1, 0x31);
+        load_roots_avx2(&(ntt_fast_roots[h + j]), idx4, &w, &wq);
+        butterfly_avx2(&a, &b, w, wq, q, two_q);
+        _mm256_storeu_si256((__m256i *)p, _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(p + 8), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    h *= 2;
+
+    // -- tt = 2: 4 groups of 4 values. a = 64-bit unpacklo(x0, x1), b = 64-bit unpackhi(x0, x1)
+    __m256i idx2 = _mm256_setr_epi32(0, 0, 2, 2, 1, 1, 3, 3);
+    for (size_t j = 0; j < h; j += 4)
+    {
+        ZZ *p      = &(vec[4 * j]);
+        __m256i x0 = _mm256_loadu_si256((__m256i *)p);
+        __m256i x1 = _mm256_loadu_si256((__m256i *)(p + 8));
+        __m256i a  = _mm256_unpacklo_epi64(x0, x1);
+        __m256i b  = _mm256_unpackhi_epi64(x0, x1);
+        load_roots_avx2(&(ntt_fast_roots[h + j]), idx2, &w, &wq);
+        butterfly_avx2(&a, &b, w, wq, q, two_q);
+        _mm256_storeu_si256((__m256i *)p, _mm256_unpacklo_epi64(a, b));
+        _mm256_storeu_si256((__m256i *)(p + 8), _mm256_unpackhi_epi64(a, b));
+    }
+    h *= 2;
+
+    // -- tt = 1: 8 groups of 2 values. Swapping the middle two values of each 128-bit lane turns
+    //    this into the tt = 2 case. (The swap is its own inverse.)
+    __m256i idx1 = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+    for (size_t j = 0; j < h; j += 8)
+    {
+        ZZ *p      = &(vec[2 * j]);
+        __m256i x0 = _mm256_shuffle_epi32(_mm256_loadu_si256((__m256i *)p), 0xD8);
+        __m256i x1 = _mm256_shuffle_epi32(_mm256_loadu_si256((__m256i *)(p + 8)), 0xD8);
+        __m256i a  = _mm256_unpacklo_epi64(x0, x1);
+        __m256i b  = _mm256_unpackhi_epi64(x0, x1);
+        load_roots_avx2(&(ntt_fast_roots[h + j]), idx1, &w, &wq);
+        butterfly_avx2(&a, &b, w, wq, q, two_q);
+        x0 = _mm256_shuffle_epi32(_mm256_unpacklo_epi64(a, b), 0xD8);
+        x1 = _mm256_shuffle_epi32(_mm256_unpackhi_epi64(a, b), 0xD8);
+
+        // -- Values are in [0, 4q). Reduce them to [0, q) while they are still in registers.
+        x0 = _mm256_min_epu32(x0, _mm256_sub_epi32(x0, two_q));
+        x0 = _mm256_min_epu32(x0, _mm256_sub_epi32(x0, q));
+        x1 = _mm256_min_epu32(x1, _mm256_sub_epi32(x1, two_q));
+        x1 = _mm256_min_epu32(x1, _mm256_sub_epi32(x1, q));
+        _mm256_storeu_si256((__m256i *)p, x0);
+        _mm256_storeu_si256((__m256i *)(p + 8), x1);
+    }
+}
+
+// ==============================================================================
+//                                   AVX-512
+// ==============================================================================
+
+/**
+Returns the high 32 bits of the 32 x 32-bit product of each pair of lanes (see: mul_uint_high).
+*/
+static inline SE_TARGET_AVX512 __m512i mul_uint_high_avx512(__m512i a, __m512i b)
+{
+    __m512i even = _mm512_srli_epi64(_mm512_mul_epu32(a, b), 32);
+    __m512i odd  = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+/**
+The Harvey butterfly on 16 lanes. See: butterfly_avx2.
+*/
+static inline SE_TARGET_AVX512 void butterfly_avx512(__m512i *x, __m512i *y, __m512i w,
+                                                     __m512i wq, __m512i q, __m512i two_q)
+{
+    __m512i u   = _mm512_min_epu32(*x, _mm512_sub_epi32(*x, two_q));
+    __m512i op2 = mul_uint_high_avx512(*y, wq);
+    __m512i v   = _mm512_sub_epi32(_mm512_mullo_epi32(*y, w), _mm512_mullo_epi32(op2, q));
+
+    *x = _mm512_add_epi32(u, v);
+    *y = _mm512_sub_epi32(_mm512_add_epi32(u, two_q), v);
+}
+
+void SE_TARGET_AVX512 ntt_fast_avx512_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec)
+{
+    se_assert(parms && ntt_fast_roots && vec);
+    size_t n = parms->coeff_count;
+    se_assert(n >= 32);
+    __m512i q     = _mm512_set1_epi32((int)parms->curr_modulus->value);
+    __m512i two_q = _mm512_add_epi32(q, q);
+    __m512i one   = _mm512_set1_epi32(1);
+
+    // -- Rounds with tt >= 16: all 16 lanes of a vector belong to the same group
+    size_t h  = 1;
+    size_t tt = n / 2;
+    for (; tt >= 16; h *= 2, tt /= 2)  // Rounds
+    {
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)  // Groups
+        {
+            const MUMO *s = &(ntt_fast_roots[h + j]);
+            __m512i w     = _mm512_set1_epi32((int)s->operand);
+            __m512i wq    = _mm512_set1_epi32((int)s->quotient);
+            for (size_t k = kstart; k < (kstart + tt); k += 16)  // Pairs
+            {
+                __m512i x = _mm512_loadu_si512((void *)&(vec[k]));
+                __m512i y = _mm512_loadu_si512((void *)&(vec[k + tt]));
+                butterfly_avx512(&x, &y, w, wq, q, two_q);
+                _mm512_storeu_si512((void *)&(vec[k]), x);
+                _mm512_storeu_si512((void *)&(vec[k + tt]), y);
+            }
+        }
+    }
+
+    // -- The last 4 rounds: each iteration loads 32 values (x0, x1) and gathers the first element
+    //    of each butterfly pair into 'a' and the second into 'b' with two-source permutes.
+    for (; tt >= 1; h *= 2, tt /= 2)
+    {
+        // -- Lane i of 'a' holds value a_pos[i] of (x0, x1), and uses root i / tt (relative to
+        //    the first group in (x0, x1)). Output value p comes from lane p_pos[p] of (a, b).
+        int32_t a_pos[16], r_idx[16], p_pos[32];
+        for (int i = 0; i < 16; i++)
+        {
+            a_pos[i]                  = (i / (int)tt) * 2 * (int)tt + (i % (int)tt);
+            r_idx[i]                  = 2 * (i / (int)tt);
+            p_pos[a_pos[i]]           = i;
+            p_pos[a_pos[i] + (int)tt] = i + 16;
+        }
+        __m512i perm_a  = _mm512_loadu_si512((void *)a_pos);
+        __m512i perm_b  = _mm512_add_epi32(perm_a, _mm512_set1_epi32((int)tt));
+        __m512i perm_x0 = _mm512_loadu_si512((void *)&(p_pos[0]));
+        __m512i perm_x1 = _mm512_loadu_si512((void *)&(p_pos[16]));
+        __m512i w_idx   = _mm512_loadu_si512((void *)r_idx);
+        __m512i wq_idx  = _mm512_add_epi32(w_idx, one);
+
+        for (size_t j = 0; j < h; j += 16 / tt)
+        {
+            ZZ *p      = &(vec[2 * tt * j]);
+            __m512i x0 = _mm512_loadu_si512((void *)p);
+            __m512i x1 = _mm512_loadu_si512((void *)(p + 16));
+            __m512i a  = _mm512_permutex2var_epi32(x0, perm_a, x1);
+            __m512i b  = _mm512_permutex2var_epi32(x0, perm_b, x1);
+
+            const int *roots = (const int *)&(ntt_fast_roots[h + j]);
+            __m512i w        = _mm512_i32gather_epi32(w_idx, roots, 4);
+            __m512i wq       = _mm512_i32gather_epi32(wq_idx, roots, 4);
+            butterfly_avx512(&a, &b, w, wq, q, two_q);
+
+            x0 = _mm512_permutex2var_epi32(a, perm_x0, b);
+            x1 = _mm512_permutex2var_epi32(a, perm_x1, b);
+            if (tt == 1)
+            {
+                // -- Values are in [0, 4q). Reduce them to [0, q) while they are still in
+                //    registers.
+                x0 = _mm512_min_epu32(x0, _mm512_sub_epi32(x0, two_q));
+                x0 = _mm512_min_epu32(x0, _mm512_sub_epi32(x0, q));
+                x1 = _mm512_min_epu32(x1, _mm512_sub_epi32(x1, two_q));
+                x1 = _mm512_min_epu32(x1, _mm512_sub_epi32(x1, q));
+            }
+            _mm512_storeu_si512((void *)p, x0);
+            _mm512_storeu_si512((void *)(p + 16), x1);
+        }
+    }
+}
+#endif
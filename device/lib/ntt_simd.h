@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file ntt_simd.h
+
+SIMD backends for the "fast" (a.k.a. "lazy") NTT. Each backend must produce output that is
+bit-identical to the scalar implementation (see: ntt_fast_ref_inpl).
+
+x86-64 backends (AVX2, AVX-512) are selected at runtime. The ARM backend (NEON or Helium) is selected
+at build time based on the target's compile flags.
+*/
+
+#pragma once
+
+#include "defines.h"
+#include "parameters.h"
+#include "uintmodarith.h"
+
+#ifdef SE_NTT_SIMD_X86
+/**
+SIMD instruction set levels available for the NTT on x86-64 hosts.
+*/
+typedef enum { SE_SIMD_NONE = 0, SE_SIMD_AVX2 = 1, SE_SIMD_AVX512 = 2 } SE_SIMD_LEVEL;
+
+/**
+Returns the widest SIMD instruction set supported by the CPU that can be used for the NTT. The
+check is performed at runtime, so the library does not need to be compiled with -mavx2 or
+-mavx512f.
+
+@returns  Widest supported SIMD level
+*/
+SE_SIMD_LEVEL ntt_simd_level(void);
+
+/**
+Negacyclic in-place "fast" NTT using AVX2 (8 x 32-bit lanes). Rounds with a stride of at least 8
+are vectorized across butterflies of the same group, and the last 3 rounds are computed with
+in-register shuffles. Requires that the CPU supports AVX2 (see: ntt_simd_level).
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     ntt_fast_roots  NTT roots set by ntt_roots_initialize
+@param[in,out] vec             Input/output polynomial of n ZZ elements
+*/
+void ntt_fast_avx2_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec);
+
+/**
+Negacyclic in-place "fast" NTT using AVX-512 (16 x 32-bit lanes). Rounds with a stride of at
+least 16 are vectorized across butterflies of the same group, and the last 4 rounds are computed
+with in-register shuffles. Requires that the CPU supports AVX-512F (see: ntt_simd_level).
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     ntt_fast_roots  NTT roots set by ntt_roots_initialize
+@param[in,out] vec             Input/output polynomial of n ZZ elements
+*/
+void ntt_fast_avx512_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec);
+#endif
+
+#ifdef SE_NTT_SIMD_ARM
+/**
+Negacyclic in-place "fast" NTT using NEON or Helium (MVE) (4 x 32-bit lanes), whichever the target
+is compiled for. Rounds with a stride of at least 4 are vectorized across butterflies of the same
+group, the last 2 rounds are scalar, and the final reduction is vectorized.
+
+@param[in]     parms           Parameters set by ckks_setup
+@param[in]     ntt_fast_roots  NTT roots set by ntt_roots_initialize
+@param[in,out] vec             Input/output polynomial of n ZZ elements
+*/
+void ntt_fast_arm_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec);
+#endif
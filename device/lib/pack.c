@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file pack.c
+*/
+
+#include "pack.h"
+
+#include "defines.h"
+
+size_t poly_pack_inpl(ZZ *poly, PolySizeType n, size_t nbits)
+{
+    se_assert(poly);
+    se_assert(nbits >= 1 && nbits <= 32);
+
+    // -- Bits of coefficient i are written at or after bit i * nbits <= 32 * i, so the bytes written
+    //    so far never go past the coefficient that was just read
+    uint8_t *out  = (uint8_t *)poly;
+    uint64_t acc  = 0;  // Bits that have not been written yet, least significant bit first
+    size_t nacc   = 0;  // Number of bits in acc (always less than 32 between iterations)
+    size_t nbytes = 0;
+    for (PolySizeType i = 0; i < n; i++)
+    {
+        acc |= (uint64_t)poly[i] << nacc;
+        nacc += nbits;
+        if (nacc >= 32)
+        {
+            out[nbytes]     = (uint8_t)acc;
+            out[nbytes + 1] = (uint8_t)(acc >> 8);
+            out[nbytes + 2] = (uint8_t)(acc >> 16);
+            out[nbytes + 3] = (uint8_t)(acc >> 24);
+            nbytes += 4;
+            acc >>= 32;
+            nacc -= 32;
+        }
+    }
+    for (; nacc > 0; nacc = (nacc > 8) ? nacc - 8 : 0)
+    {
+        out[nbytes++] = (uint8_t)acc;
+        acc >>= 8;
+    }
+    se_assert(nbytes == poly_packed_byte_count(n, nbits));
+    return nbytes;
+}
+
+void poly_unpack_inpl(ZZ *poly, PolySizeType n, size_t nbits)
+{
+    se_assert(poly);
+    se_assert(nbits >= 1 && nbits <= 32);
+
+    // -- Going backwards, coefficient i is read from bytes below 4 * (i + 1) before it is written
+    //    to bytes [4 * i, 4 * (i + 1)), which no coefficient below i is read from
+    const uint8_t *in = (const uint8_t *)poly;
+    uint64_t mask     = ((uint64_t)1 << nbits) - 1;
+    for (PolySizeType i = n; i-- > 0;)
+    {
+        size_t bit_pos  = i * nbits;
+        size_t byte_pos = bit_pos / 8;
+        size_t shift    = bit_pos % 8;
+        size_t nread    = (shift + nbits + 7) / 8;  // At most 5 bytes
+
+        uint64_t val = 0;
+        for (size_t k = 0; k < nread; k++) val |= (uint64_t)in[byte_pos + k] << (8 * k);
+        poly[i] = (ZZ)((val >> shift) & mask);
+    }
+}
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file pack.h
+
+Functions to pack the coefficients of a ciphertext component to the bit width of the current
+modulus for network transmission (see: SE_ENABLE_PACKED_CT), and to unpack them again.
+
+Packed format: coefficient i occupies bits [i * nbits, (i + 1) * nbits) of the packed byte string,
+least significant bit first, where bit k is bit (k % 8) of byte k / 8. The last byte is padded with
+zeros.
+*/
+
+#pragma once
+
+#include "defines.h"
+#include "modulus.h"
+
+/**
+Returns the bit width used to pack polynomials modulo 'mod', i.e., the number of bits of mod->value.
+
+@param[in] mod  Modulus
+@returns        Number of bits of mod->value
+*/
+static inline size_t packed_bit_count(const Modulus *mod)
+{
+    se_assert(mod && mod->value);
+    size_t nbits = 0;
+    for (ZZ val = mod->value; val; val >>= 1) nbits++;
+    return nbits;
+}
+
+/**
+Returns the number of bytes of a packed polynomial.
+
+@param[in] n      Number of coefficients
+@param[in] nbits  Bit width of each coefficient
+@returns          Number of bytes of the packed polynomial
+*/
+static inline size_t poly_packed_byte_count(PolySizeType n, size_t nbits)
+{
+    return (n * nbits + 7) / 8;
+}
+
+/**
+Packs the n coefficients of 'poly' to nbits bits each, in place. The packed bytes are written to the
+start of poly's memory. Works in a single pass with no extra buffer, since the packed form of the
+first i coefficients is never longer than their unpacked form.
+
+Req: Each coefficient of poly must be less than 2^nbits, and 1 <= nbits <= 32.
+
+@param[in,out] poly   In: Polynomial to pack. Out: Packed polynomial (returned number of bytes)
+@param[in]     n      Number of coefficients
+@param[in]     nbits  Bit width of each coefficient (see: packed_bit_count)
+@returns              Number of bytes of the packed polynomial
+*/
+size_t poly_pack_inpl(ZZ *poly, PolySizeType n, size_t nbits);
+
+/**
+Unpacks a polynomial packed with poly_pack_inpl, in place. Works in a single backwards pass with no
+extra buffer.
+
+Space req: poly must have space for n ZZ elements.
+
+@param[in,out] poly   In: Packed polynomial. Out: Unpacked polynomial (n coefficients)
+@param[in]     n      Number of coefficients
+@param[in]     nbits  Bit width of each coefficient
+*/
+void poly_unpack_inpl(ZZ *poly, PolySizeType n, size_t nbits);
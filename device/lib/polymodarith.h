@@ -10,6 +10,34 @@
 #include "defines.h"
 #include "uintmodarith.h"
 
+#ifdef SE_SIMD_ARM
+// -- NEON / Helium (MVE) versions of the polynomial functions below (see: simd_arm.c). Each has the
+//    same arguments and produces the same output as its scalar counterpart.
+void poly_add_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod, ZZ *res);
+void poly_neg_mod_arm(const ZZ *p1, PolySizeType n, const Modulus *mod, ZZ *res);
+void poly_pointwise_mul_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod,
+                                ZZ *res);
+void poly_pointwise_mul_mod_pair_arm(const ZZ *p1a, const ZZ *p1b, const ZZ *p2, PolySizeType n,
+                                     const Modulus *mod, ZZ *res_a, ZZ *res_b);
+void poly_mul_neg_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod, ZZ *res);
+void poly_mul_neg_add_mod_arm(const ZZ *p1, const ZZ *p2, const ZZ *p3, PolySizeType n,
+                              const Modulus *mod, ZZ *res);
+#endif
+
+/**
+Reduces a lazily-reduced value (e.g., an output of ntt_lazy_out_inpl) from [0, 4q) to [0, q).
+
+@param[in] val  Value in [0, 4q)
+@param[in] q    Modulus value
+@returns        'val' mod q
+*/
+static inline ZZ reduce_lazy_4q(ZZ val, ZZ q)
+{
+    ZZ two_q = q << 1;
+    val -= two_q & (ZZ)(-(ZZsign)(val >= two_q));
+    return val - (q & (ZZ)(-(ZZsign)(val >= q)));
+}
+
 /**
 Modular polynomial addition. 'p1' and 'res' may share the same starting address for in-place
 computation.
@@ -25,7 +53,11 @@ Space req: 'res' must have space for n ZZ values.
 static inline void poly_add_mod(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod,
                                 ZZ *res)
 {
+#ifdef SE_SIMD_ARM
+    poly_add_mod_arm(p1, p2, n, mod, res);
+#else
     for (PolySizeType i = 0; i < n; i++) { res[i] = add_mod(p1[i], p2[i], mod); }
+#endif
 }
 
 /**
@@ -38,7 +70,11 @@ In-place modular polynomial addition.
 */
 static inline void poly_add_mod_inpl(ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod)
 {
+#ifdef SE_SIMD_ARM
+    poly_add_mod_arm(p1, p2, n, mod, p1);
+#else
     for (PolySizeType i = 0; i < n; i++) { add_mod_inpl(&(p1[i]), p2[i], mod); }
+#endif
 }
 
 /**
@@ -54,7 +90,11 @@ Space req: 'res' must have space for n ZZ values.
 */
 static inline void poly_neg_mod(const ZZ *p1, PolySizeType n, const Modulus *mod, ZZ *res)
 {
+#ifdef SE_SIMD_ARM
+    poly_neg_mod_arm(p1, n, mod, res);
+#else
     for (PolySizeType i = 0; i < n; i++) { res[i] = neg_mod(p1[i], mod); }
+#endif
 }
 
 /**
@@ -66,7 +106,11 @@ In-place modular polynomial negation.
 */
 static inline void poly_neg_mod_inpl(ZZ *p1, PolySizeType n, const Modulus *mod)
 {
+#ifdef SE_SIMD_ARM
+    poly_neg_mod_arm(p1, n, mod, p1);
+#else
     for (PolySizeType i = 0; i < n; i++) { neg_mod_inpl(&(p1[i]), mod); }
+#endif
 }
 
 /**
@@ -83,7 +127,42 @@ Space req: 'res' must have space for n ZZ values.
 static inline void poly_pointwise_mul_mod(const ZZ *p1, const ZZ *p2, PolySizeType n,
                                           const Modulus *mod, ZZ *res)
 {
+#ifdef SE_SIMD_ARM
+    poly_pointwise_mul_mod_arm(p1, p2, n, mod, res);
+#else
     for (PolySizeType i = 0; i < n; i++) { res[i] = mul_mod(p1[i], p2[i], mod); }
+#endif
+}
+
+/**
+Pointwise multiplies two polynomials by the same polynomial in a single pass, so that 'p2' is only
+read once. 'p1a' and 'res_a' (or 'p1b' and 'res_b') may share the same starting address for in-place
+computation.
+
+Space req: 'res_a' and 'res_b' must each have space for n ZZ values.
+
+@param[in]  p1a    Input polynomial 1a
+@param[in]  p1b    Input polynomial 1b
+@param[in]  p2     Input polynomial 2 (shared multiplicand)
+@param[in]  n      Number of elements (ZZ coefficients) in each polynomial
+@param[in]  mod    Modulus
+@param[out] res_a  Result polynomial [p1a . p2]_mod
+@param[out] res_b  Result polynomial [p1b . p2]_mod
+*/
+static inline void poly_pointwise_mul_mod_pair(const ZZ *p1a, const ZZ *p1b, const ZZ *p2,
+                                               PolySizeType n, const Modulus *mod, ZZ *res_a,
+                                               ZZ *res_b)
+{
+#ifdef SE_SIMD_ARM
+    poly_pointwise_mul_mod_pair_arm(p1a, p1b, p2, n, mod, res_a, res_b);
+#else
+    for (PolySizeType i = 0; i < n; i++)
+    {
+        ZZ val   = p2[i];
+        res_a[i] = mul_mod(p1a[i], val, mod);
+        res_b[i] = mul_mod(p1b[i], val, mod);
+    }
+#endif
 }
 
 /**
@@ -99,3 +178,52 @@ static inline void poly_pointwise_mul_mod_inpl(ZZ *p1, const ZZ *p2, PolySizeTyp
 {
     poly_pointwise_mul_mod(p1, p2, n, mod, p1);
 }
+
+/**
+Computes [p3 - p1 . p2]_mod (i.e., pointwise multiplication, negation, and addition) in a single
+pass. 'p3' may be lazily reduced (e.g., the output of ntt_lazy_out_inpl), and is reduced as part of
+the same pass. 'p1' (or 'p2') and 'res' may share the same starting address for in-place
+computation.
+
+Space req: 'res' must have space for n ZZ values.
+
+@param[in]  p1   Input polynomial 1, with coefficients in [0, q)
+@param[in]  p2   Input polynomial 2, with coefficients in [0, q)
+@param[in]  p3   Input polynomial 3, with coefficients in [0, 4q)
+@param[in]  n    Number of elements (ZZ coefficients) in each polynomial
+@param[in]  mod  Modulus
+@param[out] res  Result polynomial [p3 - p1 . p2]_mod
+*/
+static inline void poly_mul_neg_add_mod(const ZZ *p1, const ZZ *p2, const ZZ *p3, PolySizeType n,
+                                        const Modulus *mod, ZZ *res)
+{
+#ifdef SE_SIMD_ARM
+    poly_mul_neg_add_mod_arm(p1, p2, p3, n, mod, res);
+#else
+    for (PolySizeType i = 0; i < n; i++)
+    { res[i] = sub_mod(reduce_lazy_4q(p3[i], mod->value), mul_mod(p1[i], p2[i], mod), mod); }
+#endif
+}
+
+/**
+Computes [-(p1 . p2)]_mod (i.e., pointwise multiplication and negation) in a single pass. 'p1' (or
+'p2') and 'res' may share the same starting address for in-place computation.
+
+Space req: 'res' must have space for n ZZ values.
+
+@param[in]  p1   Input polynomial 1, with coefficients in [0, q)
+@param[in]  p2   Input polynomial 2, with coefficients in [0, q)
+@param[in]  n    Number of elements (ZZ coefficients) in each polynomial
+@param[in]  mod  Modulus
+@param[out] res  Result polynomial [-(p1 . p2)]_mod
+*/
+static inline void poly_mul_neg_mod(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod,
+                                    ZZ *res)
+{
+#ifdef SE_SIMD_ARM
+    poly_mul_neg_mod_arm(p1, p2, n, mod, res);
+#else
+    for (PolySizeType i = 0; i < n; i++) { res[i] = neg_mod(mul_mod(p1[i], p2[i], mod), mod); }
+#endif
+}
+
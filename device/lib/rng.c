@@ -14,5 +14,11 @@ Pseudo-random number generator.
 // -- Need these to avoid duplicate symbols error
 
 extern inline void prng_randomize_reset(SE_PRNG *prng, uint8_t *seed_in);
+extern inline void prng_state_init(const SE_PRNG *prng, SE_PRNG_STATE *state);
+extern inline void prng_state_squeezeblocks(uint8_t *out, size_t nblocks, SE_PRNG_STATE *state);
+extern inline void prng_increment_counter(SE_PRNG *prng);
 extern inline void prng_fill_buffer(size_t byte_count, SE_PRNG *prng, void *buffer);
+extern inline void prng_fill_buffer_x4(size_t byte_count, SE_PRNG *prng, void *buffer);
+extern inline void prng_stream_init(SE_PRNG *prng, SE_PRNG_STREAM *stream);
+extern inline void prng_stream_squeeze(size_t byte_count, SE_PRNG_STREAM *stream, void *buffer);
 extern inline void prng_clear(SE_PRNG *prng);
@@ -16,6 +16,13 @@ Pseudo-random number generator.
 #include "defines.h"
 #include "inttypes.h"
 #include "shake256/fips202.h"
+#include "shake256/fips202x4.h"
+
+#if defined(SE_PRNG_AES_CTR)
+#include "aes256ctr.h"
+#elif defined(SE_PRNG_CHACHA20)
+#include "chacha20.h"
+#endif
 
 #ifdef SE_RAND_GETRANDOM
 #include <sys/random.h>  // getrandom
@@ -29,6 +36,35 @@ typedef struct SE_PRNG
     uint64_t counter;
 } SE_PRNG;
 
+// -- State of the seed expansion for the configured PRNG type (see: SE_PRNG_SEED_VERSION), and the
+//    number of bytes it outputs per block
+#if defined(SE_PRNG_AES_CTR)
+typedef aes256ctr_ctx SE_PRNG_STATE;
+#define SE_PRNG_BLOCK_BYTES AES256CTR_BLOCKBYTES
+#elif defined(SE_PRNG_CHACHA20)
+typedef chacha20_ctx SE_PRNG_STATE;
+#define SE_PRNG_BLOCK_BYTES CHACHA20_BLOCKBYTES
+#else
+typedef shake256ctx SE_PRNG_STATE;
+#define SE_PRNG_BLOCK_BYTES SHAKE256_RATE
+#endif
+
+/**
+An open output stream of a SE_PRNG (see: prng_stream_init). Keeps the PRNG state alive between
+requests and buffers the unused part of the last squeezed block, so small or repeated requests
+(e.g., for rejection sampling) do not need a new absorb (or key setup) step.
+
+@param state   PRNG state (after absorbing seed and counter)
+@param buffer  Last squeezed block
+@param pos     Number of bytes of buffer already returned (SE_PRNG_BLOCK_BYTES if buffer is empty)
+*/
+typedef struct SE_PRNG_STREAM
+{
+    SE_PRNG_STATE state;
+    uint8_t buffer[SE_PRNG_BLOCK_BYTES];
+    size_t pos;
+} SE_PRNG_STREAM;
+
 /**
 Randomizes the seed of a PRNG object and resets its internal counter.
 
@@ -68,19 +104,54 @@ inline void prng_randomize_reset(SE_PRNG *prng, uint8_t *seed_in)
 }
 
 /**
-Fills a buffer with random bytes expanded from a SE_PRNG's seed (and counter).
-A call to this function updates the prng object's internal counter.
+Starts the expansion of a SE_PRNG's seed (and counter) with the configured PRNG type (see:
+SE_PRNG_SEED_VERSION). Does not update the prng object's internal counter.
 
-@param[in]      byte_count  Number of random bytes to generate
-@param[in,out]  prng        PRNG instance
-@param[out]     buffer      Buffer to store the random bytes
+@param[in]  prng   PRNG instance
+@param[out] state  PRNG state to initialize
 */
-inline void prng_fill_buffer(size_t byte_count, SE_PRNG *prng, void *buffer)
+inline void prng_state_init(const SE_PRNG *prng, SE_PRNG_STATE *state)
 {
+#if defined(SE_PRNG_AES_CTR) || defined(SE_PRNG_CHACHA20)
+    // -- Both ciphers take a 32-byte key (the first half of the seed). The counter is the nonce.
+#ifdef SE_PRNG_AES_CTR
+    aes256ctr_init(state, &(prng->seed[0]), prng->counter);
+#else
+    chacha20_init(state, &(prng->seed[0]), prng->counter);
+#endif
+#else
     uint8_t seed_ext[SE_PRNG_SEED_BYTE_COUNT + 8];
     memcpy(&(seed_ext[0]), &(prng->seed[0]), SE_PRNG_SEED_BYTE_COUNT);
     memcpy(&(seed_ext[SE_PRNG_SEED_BYTE_COUNT]), &(prng->counter), 8);
-    shake256(buffer, byte_count, &(seed_ext[0]), SE_PRNG_SEED_BYTE_COUNT + 8);
+    shake256_absorb(state, &(seed_ext[0]), SE_PRNG_SEED_BYTE_COUNT + 8);
+#endif
+}
+
+/**
+Writes the next nblocks blocks of SE_PRNG_BLOCK_BYTES random bytes each.
+
+@param[out]    out      Buffer to store the random bytes
+@param[in]     nblocks  Number of blocks to generate
+@param[in,out] state    PRNG state initialized with prng_state_init
+*/
+inline void prng_state_squeezeblocks(uint8_t *out, size_t nblocks, SE_PRNG_STATE *state)
+{
+#if defined(SE_PRNG_AES_CTR)
+    aes256ctr_squeezeblocks(out, nblocks, state);
+#elif defined(SE_PRNG_CHACHA20)
+    chacha20_squeezeblocks(out, nblocks, state);
+#else
+    shake256_squeezeblocks(out, nblocks, state);
+#endif
+}
+
+/**
+Increments a SE_PRNG's internal counter. Re-randomizes the seed if the counter overflows.
+
+@param[in,out] prng  PRNG instance
+*/
+inline void prng_increment_counter(SE_PRNG *prng)
+{
     prng->counter++;
     if (prng->counter == 0)  // overflow!
     {
@@ -90,6 +161,121 @@ inline void prng_fill_buffer(size_t byte_count, SE_PRNG *prng, void *buffer)
     }
 }
 
+/**
+Fills a buffer with random bytes expanded from a SE_PRNG's seed (and counter).
+A call to this function updates the prng object's internal counter.
+
+@param[in]      byte_count  Number of random bytes to generate
+@param[in,out]  prng        PRNG instance
+@param[out]     buffer      Buffer to store the random bytes
+*/
+inline void prng_fill_buffer(size_t byte_count, SE_PRNG *prng, void *buffer)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    SE_PRNG_STATE state;
+    prng_state_init(prng, &state);
+
+    size_t nblocks = byte_count / SE_PRNG_BLOCK_BYTES;
+    prng_state_squeezeblocks(out, nblocks, &state);
+    if (byte_count % SE_PRNG_BLOCK_BYTES)
+    {
+        uint8_t block[SE_PRNG_BLOCK_BYTES];
+        prng_state_squeezeblocks(&(block[0]), 1, &state);
+        memcpy(&(out[nblocks * SE_PRNG_BLOCK_BYTES]), &(block[0]),
+               byte_count % SE_PRNG_BLOCK_BYTES);
+    }
+    prng_increment_counter(prng);
+}
+
+/**
+Opens a random byte stream expanded from a SE_PRNG's seed (and counter). Uses the same seed
+expansion (and updates the prng object's internal counter in the same way) as a single call to
+prng_fill_buffer, so the stream begins with the same bytes that prng_fill_buffer would return.
+
+@param[in,out] prng    PRNG instance
+@param[out]    stream  Stream to open
+*/
+inline void prng_stream_init(SE_PRNG *prng, SE_PRNG_STREAM *stream)
+{
+    prng_state_init(prng, &(stream->state));
+    stream->pos = SE_PRNG_BLOCK_BYTES;
+    prng_increment_counter(prng);
+}
+
+/**
+Returns the next byte_count bytes of a random byte stream. Only computes a new block (e.g., a
+Keccak permutation) when the buffered output runs out (i.e., once every SE_PRNG_BLOCK_BYTES bytes).
+
+@param[in]     byte_count  Number of random bytes to generate
+@param[in,out] stream      Stream opened with prng_stream_init
+@param[out]    buffer      Buffer to store the random bytes
+*/
+inline void prng_stream_squeeze(size_t byte_count, SE_PRNG_STREAM *stream, void *buffer)
+{
+    uint8_t *out = (uint8_t *)buffer;
+    while (byte_count)
+    {
+        if (stream->pos == SE_PRNG_BLOCK_BYTES)
+        {
+            // -- Squeeze whole blocks directly into the output
+            size_t nblocks = byte_count / SE_PRNG_BLOCK_BYTES;
+            if (nblocks)
+            {
+                prng_state_squeezeblocks(out, nblocks, &(stream->state));
+                out += nblocks * SE_PRNG_BLOCK_BYTES;
+                byte_count -= nblocks * SE_PRNG_BLOCK_BYTES;
+                continue;
+            }
+            prng_state_squeezeblocks(&(stream->buffer[0]), 1, &(stream->state));
+            stream->pos = 0;
+        }
+        size_t len = SE_PRNG_BLOCK_BYTES - stream->pos;
+        if (len > byte_count) len = byte_count;
+        memcpy(out, &(stream->buffer[stream->pos]), len);
+        stream->pos += len;
+        out += len;
+        byte_count -= len;
+    }
+}
+
+/**
+Fills a buffer with 4 * byte_count random bytes. Output (and the prng object's internal counter
+afterwards) is identical to 4 consecutive calls to prng_fill_buffer, each filling the next
+byte_count bytes of buffer, but for SHAKE256 the 4 calls are computed at once (see: shake256x4).
+
+@param[in]      byte_count  Number of random bytes to generate per call to prng_fill_buffer
+@param[in,out]  prng        PRNG instance
+@param[out]     buffer      Buffer to store the 4 * byte_count random bytes
+*/
+inline void prng_fill_buffer_x4(size_t byte_count, SE_PRNG *prng, void *buffer)
+{
+    uint8_t *out = (uint8_t *)buffer;
+
+#ifndef SE_PRNG_SHAKE256
+    // -- Stream ciphers are already fast per call, so there is nothing to batch
+    for (size_t i = 0; i < 4; i++) prng_fill_buffer(byte_count, prng, &(out[i * byte_count]));
+#else
+    // -- The counter would overflow (and the seed would be re-randomized) within the batch
+    if (prng->counter > UINT64_MAX - 4)
+    {
+        for (size_t i = 0; i < 4; i++) prng_fill_buffer(byte_count, prng, &(out[i * byte_count]));
+        return;
+    }
+
+    uint8_t seed_ext[4][SE_PRNG_SEED_BYTE_COUNT + 8];
+    for (size_t i = 0; i < 4; i++)
+    {
+        uint64_t counter = prng->counter + i;
+        memcpy(&(seed_ext[i][0]), &(prng->seed[0]), SE_PRNG_SEED_BYTE_COUNT);
+        memcpy(&(seed_ext[i][SE_PRNG_SEED_BYTE_COUNT]), &counter, 8);
+    }
+    shake256x4(&(out[0]), &(out[byte_count]), &(out[2 * byte_count]), &(out[3 * byte_count]),
+               byte_count, &(seed_ext[0][0]), &(seed_ext[1][0]), &(seed_ext[2][0]),
+               &(seed_ext[3][0]), SE_PRNG_SEED_BYTE_COUNT + 8);
+    prng->counter += 4;
+#endif
+}
+
 /**
 Clears the values (both seed and counter) of a prng instance to 0.
 Clears the bit that ties prng to a custom seed (so next prng_randomize_reset *will* generate a
@@ -15,6 +15,12 @@
 #include "nrf_crypto.h"
 #endif
 
+#ifdef SE_UNIFORM_AVX2
+#include <immintrin.h>
+
+#include "cpu_features.h"
+#endif
+
 //#define DEBUG_EASYMOD
 
 // ----------------------------  Randomness ------------------------------
@@ -36,6 +42,231 @@ void se_randomness_init()
 
 // -----------------------------  Uniform ---------------------------------
 
+// -- Marks a rejected candidate in sample_poly_uniform (never a value mod q, since q < 2^31)
+#define SE_UNIFORM_REJECTED ((ZZ)0xFFFFFFFFUL)
+
+// -- Number of candidates drawn at a time to replace rejected coefficients in sample_poly_uniform
+#define SE_UNIFORM_EXTRA_COUNT 32
+
+/**
+Reduces each candidate that is below max_multiple modulo q, and replaces each other (i.e.,
+rejected) candidate with SE_UNIFORM_REJECTED. Branch-free.
+
+@param[in,out] vals          In: Random candidates; Out: Reduced values or SE_UNIFORM_REJECTED
+@param[in]     len           Number of values in vals
+@param[in]     max_multiple  Bound for accepted candidates
+@param[in]     q             Modulus
+@returns                     Number of rejected candidates
+*/
+static size_t sample_uniform_reduce_scalar(ZZ *vals, size_t len, ZZ max_multiple, const Modulus *q)
+{
+    size_t nrejected = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        ZZ rand_val = vals[i];
+        ZZ accept   = (ZZ)(rand_val < max_multiple);
+        ZZ mask     = (ZZ)(-(ZZsign)accept);
+        vals[i]     = (barrett_reduce_32input_32modulus(rand_val, q) & mask) | ~mask;
+        nrejected += 1 - accept;
+    }
+    return nrejected;
+}
+
+#ifdef SE_UNIFORM_AVX2
+#define SE_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+
+/**
+AVX2 version of sample_uniform_reduce_scalar. Handles 8 candidates at a time.
+*/
+static SE_TARGET_AVX2 size_t sample_uniform_reduce_avx2(ZZ *vals, size_t len, ZZ max_multiple,
+                                                        const Modulus *q)
+{
+    const __m256i vq       = _mm256_set1_epi32((int)q->value);
+    const __m256i vratio   = _mm256_set1_epi32((int)q->const_ratio[1]);
+    const __m256i vmax     = _mm256_set1_epi32((int)(max_multiple - 1));
+    const __m256i all_ones = _mm256_set1_epi32(-1);
+
+    size_t nrejected = 0;
+    size_t i         = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)&(vals[i]));
+
+        // -- Barrett reduction (see: barrett_reduce_32input_32modulus). If r >= q, r - q is the
+        //    smaller value. Otherwise, r - q wraps around.
+        __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, vratio), 32);
+        __m256i odd  = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), vratio);
+        __m256i tmp  = _mm256_blend_epi32(even, odd, 0xAA);
+        __m256i r    = _mm256_sub_epi32(x, _mm256_mullo_epi32(tmp, vq));
+        r            = _mm256_min_epu32(r, _mm256_sub_epi32(r, vq));
+
+        // -- Accept iff x <= max_multiple - 1 (i.e., min(x, max_multiple - 1) == x)
+        __m256i accept = _mm256_cmpeq_epi32(_mm256_min_epu32(x, vmax), x);
+        r              = _mm256_or_si256(r, _mm256_xor_si256(accept, all_ones));
+        _mm256_storeu_si256((__m256i *)&(vals[i]), r);
+
+        int accept_bits = _mm256_movemask_ps(_mm256_castsi256_ps(accept));
+        nrejected += 8 - (size_t)__builtin_popcount((unsigned)accept_bits);
+    }
+    return nrejected + sample_uniform_reduce_scalar(&(vals[i]), len - i, max_multiple, q);
+}
+#endif
+
+/**
+Dispatches to the AVX2 or the scalar version of sample_uniform_reduce_scalar. 'use_avx2' must only
+be set if the CPU supports AVX2 (see: se_cpu_has_avx2).
+*/
+static size_t sample_uniform_reduce(ZZ *vals, size_t len, ZZ max_multiple, const Modulus *q,
+                                    bool use_avx2)
+{
+#ifdef SE_UNIFORM_AVX2
+    if (use_avx2) return sample_uniform_reduce_avx2(vals, len, max_multiple, q);
+#endif
+    SE_UNUSED(use_avx2);
+    return sample_uniform_reduce_scalar(vals, len, max_multiple, q);
+}
+
+/**
+Queue of replacement values for the rejected coefficients in sample_poly_uniform, i.e., the accepted
+(and reduced) values among the next values of the PRNG stream, in stream order.
+
+@param stream        PRNG stream to draw candidates from
+@param max_multiple  Bound for accepted candidates
+@param q             Modulus
+@param use_avx2      Set to 1 to use the AVX2 kernels (see: sample_uniform_reduce)
+@param vals          Queue storage. Has room for 8 more values than one refill can add, so that 8
+                     values can always be loaded at once.
+@param head          Index in vals of the next replacement value
+@param count         Number of replacement values left
+*/
+typedef struct UniformExtra
+{
+    SE_PRNG_STREAM *stream;
+    ZZ max_multiple;
+    const Modulus *q;
+    bool use_avx2;
+    ZZ vals[SE_UNIFORM_EXTRA_COUNT + 8];
+    size_t head;
+    size_t count;
+} UniformExtra;
+
+/**
+Draws the next SE_UNIFORM_EXTRA_COUNT candidates and appends the accepted ones to the queue.
+Requires that fewer than 8 values are left in the queue.
+
+@param[in,out] extra  Queue to refill
+*/
+static void sample_uniform_extra_refill(UniformExtra *extra)
+{
+    se_assert(extra->count < 8);
+    memmove(&(extra->vals[0]), &(extra->vals[extra->head]), extra->count * sizeof(ZZ));
+    extra->head = 0;
+
+    ZZ *cand = &(extra->vals[extra->count]);
+    prng_stream_squeeze(SE_UNIFORM_EXTRA_COUNT * sizeof(ZZ), extra->stream, (void *)cand);
+    sample_uniform_reduce(cand, SE_UNIFORM_EXTRA_COUNT, extra->max_multiple, extra->q,
+                          extra->use_avx2);
+
+    // -- Compact the accepted values to the front
+    size_t j = 0;
+    for (size_t k = 0; k < SE_UNIFORM_EXTRA_COUNT; k++)
+    {
+        ZZ val  = cand[k];
+        cand[j] = val;
+        j += (size_t)(val != SE_UNIFORM_REJECTED);
+    }
+    extra->count += j;
+}
+
+/**
+Replaces the rejected coefficients (i.e., SE_UNIFORM_REJECTED values) of poly, in order, with the
+values of the queue. Branch-free, apart from refilling the queue.
+
+@param[in,out] poly       Polynomial with rejected coefficients
+@param[in]     n          Number of coefficients in poly
+@param[in]     nrejected  Number of rejected coefficients in poly
+@param[in,out] extra      Queue of replacement values
+*/
+static void sample_uniform_fill_scalar(ZZ *poly, size_t n, size_t nrejected, UniformExtra *extra)
+{
+    for (size_t i = 0; nrejected && i < n; i++)
+    {
+        if (!extra->count) sample_uniform_extra_refill(extra);
+        ZZ is_rejected = (ZZ)(poly[i] == SE_UNIFORM_REJECTED);
+        ZZ mask        = (ZZ)(-(ZZsign)is_rejected);
+        poly[i]        = (extra->vals[extra->head] & mask) | (poly[i] & ~mask);
+        extra->head += is_rejected;
+        extra->count -= is_rejected;
+        nrejected -= is_rejected;
+    }
+}
+
+#ifdef SE_UNIFORM_AVX2
+/**
+AVX2 version of sample_uniform_fill_scalar. Handles 8 coefficients at a time: the replacement for
+each rejected lane is found with a prefix count of the rejected lanes and a lane permutation.
+*/
+static SE_TARGET_AVX2 void sample_uniform_fill_avx2(ZZ *poly, size_t n, size_t nrejected,
+                                                    UniformExtra *extra)
+{
+    const __m256i all_ones = _mm256_set1_epi32(-1);
+    const __m256i one      = _mm256_set1_epi32(1);
+
+    // -- Permutations that shift the lanes up by 1, 2, and 4, and masks that clear the lanes
+    //    shifted in
+    const __m256i shift1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i shift2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+    const __m256i shift4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+    const __m256i keep1  = _mm256_setr_epi32(0, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i keep2  = _mm256_setr_epi32(0, 0, -1, -1, -1, -1, -1, -1);
+    const __m256i keep4  = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+
+    // -- Keep the queue position in registers (the compiler cannot tell that poly and extra differ)
+    size_t head  = extra->head;
+    size_t count = extra->count;
+    size_t i     = 0;
+    for (; nrejected && i + 8 <= n; i += 8)
+    {
+        if (count < 8)
+        {
+            extra->head  = head;
+            extra->count = count;
+            while (extra->count < 8) sample_uniform_extra_refill(extra);
+            head  = extra->head;
+            count = extra->count;
+        }
+
+        __m256i x        = _mm256_loadu_si256((const __m256i *)&(poly[i]));
+        __m256i rejected = _mm256_cmpeq_epi32(x, all_ones);
+
+        // -- Exclusive prefix count of the rejected lanes, i.e., the queue index of the replacement
+        //    value for each rejected lane
+        __m256i r   = _mm256_and_si256(rejected, one);
+        __m256i idx = r;
+        __m256i tmp = _mm256_and_si256(_mm256_permutevar8x32_epi32(idx, shift1), keep1);
+        idx         = _mm256_add_epi32(idx, tmp);
+        tmp         = _mm256_and_si256(_mm256_permutevar8x32_epi32(idx, shift2), keep2);
+        idx         = _mm256_add_epi32(idx, tmp);
+        tmp         = _mm256_and_si256(_mm256_permutevar8x32_epi32(idx, shift4), keep4);
+        idx         = _mm256_add_epi32(idx, tmp);
+        idx         = _mm256_sub_epi32(idx, r);
+
+        __m256i vals = _mm256_loadu_si256((const __m256i *)&(extra->vals[head]));
+        x = _mm256_blendv_epi8(x, _mm256_permutevar8x32_epi32(vals, idx), rejected);
+        _mm256_storeu_si256((__m256i *)&(poly[i]), x);
+
+        size_t nfilled = (size_t)__builtin_popcount(
+            (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(rejected)));
+        head += nfilled;
+        count -= nfilled;
+        nrejected -= nfilled;
+    }
+    extra->head  = head;
+    extra->count = count;
+    sample_uniform_fill_scalar(&(poly[i]), n - i, nrejected, extra);
+}
+#endif
+
 void sample_poly_uniform(const Parms *parms, SE_PRNG *prng, ZZ *poly)
 {
     PolySizeType n   = parms->coeff_count;
@@ -45,15 +276,36 @@ void sample_poly_uniform(const Parms *parms, SE_PRNG *prng, ZZ *poly)
     ZZ max_random   = (ZZ)0xFFFFFFFFUL;
     ZZ max_multiple = max_random - barrett_reduce_32input_32modulus(max_random, q) - 1;
 
-    prng_fill_buffer(n * sizeof(ZZ), prng, (void *)poly);
+#ifdef SE_UNIFORM_AVX2
+    bool use_avx2 = se_cpu_has_avx2();
+#else
+    bool use_avx2 = false;
+#endif
 
-    for (size_t i = 0; i < n; i++)
+    // -- Reduce all n candidates at once, and mark the rejected ones
+    SE_PRNG_STREAM stream;
+    prng_stream_init(prng, &stream);
+    prng_stream_squeeze(n * sizeof(ZZ), &stream, (void *)poly);
+    size_t nrejected = sample_uniform_reduce(poly, n, max_multiple, q, use_avx2);
+    if (!nrejected) return;
+
+    // -- Rejected values are replaced, in order, with the accepted values among the next values of
+    //    the same stream. This matches drawing replacements one at a time, so the output does not
+    //    depend on how many candidates are drawn at once.
+    UniformExtra extra;
+    memset(&extra, 0, sizeof(extra));
+    extra.stream       = &stream;
+    extra.max_multiple = max_multiple;
+    extra.q            = q;
+    extra.use_avx2     = use_avx2;
+#ifdef SE_UNIFORM_AVX2
+    if (use_avx2)
     {
-        // -- Rejection sampling
-        ZZ rand_val = poly[i];
-        while (rand_val >= max_multiple) { prng_fill_buffer(sizeof(ZZ), prng, (void *)&rand_val); }
-        poly[i] = barrett_reduce_32input_32modulus(rand_val, q);
+        sample_uniform_fill_avx2(poly, n, nrejected, &extra);
+        return;
     }
+#endif
+    sample_uniform_fill_scalar(poly, n, nrejected, &extra);
 }
 
 // ----------------------------  Ternary ---------------------------------
@@ -165,13 +417,17 @@ void sample_poly_ternary(const Parms *parms, SE_PRNG *prng, ZZ *poly)
     //                     = 0xFFFF_FFFEULL
     ZZ max_multiple = (ZZ)0xFFFFFFFEUL;
 
-    prng_fill_buffer(n * sizeof(ZZ), prng, (void *)poly);
+    // -- Rejected values are replaced with the next values of the same stream
+    SE_PRNG_STREAM stream;
+    prng_stream_init(prng, &stream);
+    prng_stream_squeeze(n * sizeof(ZZ), &stream, (void *)poly);
 
     for (size_t i = 0; i < n; i++)
     {
         // -- Rejection sampling
         ZZ rand_val = poly[i];
-        while (rand_val >= max_multiple) { prng_fill_buffer(sizeof(ZZ), prng, (void *)&rand_val); }
+        while (rand_val >= max_multiple)
+        { prng_stream_squeeze(sizeof(ZZ), &stream, (void *)&rand_val); }
 #ifdef DEBUG_EASYMOD
         // -- If debugging, want an easy mapping: 0 -> 0, 1 -> 1, 2 -> q-1
         //    We also don't need constant-time
@@ -220,17 +476,21 @@ void sample_small_poly_ternary_prng_96(PolySizeType n, SE_PRNG *prng, ZZ *poly)
     se_assert(96 <= n);
     se_assert(prng && poly);
     uint8_t max_multiple = (uint8_t)(0xFE);
+
+    // -- All 96-byte chunks (and rejected values) come from a single stream
+    SE_PRNG_STREAM stream;
+    prng_stream_init(prng, &stream);
     for (size_t j = 0; j < n; j += 96)
     {
         uint8_t buffer[96];
-        prng_fill_buffer(96, prng, &(buffer[0]));
+        prng_stream_squeeze(96, &stream, &(buffer[0]));
 
         size_t i_stop = ((j + 95) < n) ? 96 : (n - j);
 
         for (size_t i = 0; i < i_stop; i++)
         {
             uint8_t rand_val = buffer[i];
-            while (rand_val >= max_multiple) { prng_fill_buffer(1, prng, (void *)&rand_val); }
+            while (rand_val >= max_multiple) { prng_stream_squeeze(1, &stream, (void *)&rand_val); }
 #ifdef DEBUG_EASYMOD
             uint8_t rand_ternary = rand_val % 3;
 #else
@@ -255,38 +515,46 @@ void sample_small_poly_ternary_prng_96(PolySizeType n, SE_PRNG *prng, ZZ *poly)
 //    However, we never actually need to reduce the error polynomial in this library.
 
 /**
-Helper function to return the hamming weight of a byte value
+Helper function to get the cbd sample (from a cbd w/ stddev 3.24) from 6 random bytes (non-modulo
+reduced). The sample is the Hamming weight of the low 21 bits of bytes 0-2 minus the Hamming weight
+of the low 21 bits of bytes 3-5 (both read as little-endian values).
 
-@param[in] value  A byte-sized value
-@returns          Hamming weight of value
-*/
-static inline int8_t hamming_weight(uint8_t value)
-{
-    int t = (int)value;
-    t -= (t >> 1) & 0x55;
-    t = (t & 0x33) + ((t >> 2) & 0x33);
-    return (int8_t)(t + (t >> 4)) & 0x0F;
-}
+Both Hamming weights are computed at once on a single 64-bit word (with the 21-bit halves in bits
+0-20 and 24-44), using per-byte bit counts and adding the bytes of each half. Branch-free and does
+not require a popcount instruction.
 
-/**
-Helper function to get the cbd sample (from a cbd w/ stddev 3.24) from 6 random bytes (non-modulo
-reduced)
+Size req: 'x' must be readable for 8 bytes (only the first 6 are used).
 
 @param[in] x  Six random bytes
 @returns      A (non-modulo-reduced) cbd sample
 */
-static inline int8_t get_cbd_val(uint8_t x[6])
+static inline int8_t get_cbd_val(const uint8_t *x)
 {
-    x[2] &= 0x1F;
-    x[5] &= 0x1F;
-    return (int8_t)(hamming_weight(x[0]) + hamming_weight(x[1]) + hamming_weight(x[2]) -
-                    hamming_weight(x[3]) - hamming_weight(x[4]) - hamming_weight(x[5]));
+    uint64_t w;
+    memcpy(&w, x, sizeof(w));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    w = __builtin_bswap64(w);
+#endif
+    w &= 0x00001FFFFF1FFFFFULL;
+
+    // -- Bit count of each byte
+    w -= (w >> 1) & 0x5555555555555555ULL;
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    // -- Byte 0 = bit count of bytes 0-2, byte 3 = bit count of bytes 3-5 (at most 21, no carries)
+    w += (w >> 8) + (w >> 16);
+    return (int8_t)((int)(w & 0xFF) - (int)((w >> 24) & 0xFF));
 }
 
+// -- Extra bytes at the end of a cbd randomness buffer, so that get_cbd_val can read 8 bytes for
+//    the last sample
+#define SE_CBD_BUFFER_PAD 2
+
 void sample_poly_cbd_generic(PolySizeType n, SE_PRNG *prng, int8_t *poly)
 {
     // -- Every 42 bits (6 bytes) generates a sample
-    uint8_t buffer[6];
+    uint8_t buffer[6 + SE_CBD_BUFFER_PAD];
     for (size_t i = 0; i < n; i++)
     {
         prng_fill_buffer(6, prng, (void *)buffer);
@@ -300,7 +568,7 @@ void sample_poly_cbd_generic_prng_k(size_t k, PolySizeType n, SE_PRNG *prng, int
     for (size_t j = 0; j < n; j += k)
     {
         // -- Every 42 bits (6 bytes) generates a sample
-        uint8_t buffer[6 * k]; // Generate k samples at once
+        uint8_t buffer[6 * k + SE_CBD_BUFFER_PAD]; // Generate k samples at once
         prng_fill_buffer(6 * k, prng, (void *)buffer);
 
         for (size_t i = 0; i < k; i++) { poly[i + j] = get_cbd_val(buffer + 6 * i); }
@@ -310,10 +578,19 @@ void sample_poly_cbd_generic_prng_k(size_t k, PolySizeType n, SE_PRNG *prng, int
 
 void sample_poly_cbd_generic_prng_16(PolySizeType n, SE_PRNG *prng, int8_t *poly)
 {
-    for (size_t j = 0; j < n; j += 16)
+    size_t j = 0;
+    for (; j + 64 <= n; j += 64)
+    {
+        // -- Same as below, but 4 prng calls (64 samples) at once
+        uint8_t buffer[4 * 96 + SE_CBD_BUFFER_PAD];
+        prng_fill_buffer_x4(96, prng, (void *)buffer);
+
+        for (size_t i = 0; i < 64; i++) { poly[i + j] = get_cbd_val(buffer + 6 * i); }
+    }
+    for (; j < n; j += 16)
     {
         // -- Every 42 bits (6 bytes) generates a sample
-        uint8_t buffer[96];  // Generate 16 samples at once (6 * 16 = 96 bytes)
+        uint8_t buffer[96 + SE_CBD_BUFFER_PAD];  // Generate 16 samples at once (6 * 16 = 96 bytes)
         prng_fill_buffer(96, prng, (void *)buffer);
 
         for (size_t i = 0; i < 16; i++) { poly[i + j] = get_cbd_val(buffer + 6 * i); }
@@ -323,7 +600,7 @@ void sample_poly_cbd_generic_prng_16(PolySizeType n, SE_PRNG *prng, int8_t *poly
 void sample_add_poly_cbd_generic_inpl(int64_t *poly, PolySizeType n, SE_PRNG *prng)
 {
     // -- Every 42 bits (6 bytes) generates a sample
-    uint8_t buffer[6];
+    uint8_t buffer[6 + SE_CBD_BUFFER_PAD];
     for (size_t i = 0; i < n; i++)
     {
         prng_fill_buffer(6, prng, (void *)buffer);
@@ -337,7 +614,7 @@ void sample_add_poly_cbd_generic_inpl_prng_k(int64_t *poly, size_t k, PolySizeTy
     for (size_t j = 0; j < n; j += k)
     {
         // -- Every 42 bits (6 bytes) generates a sample
-        uint8_t buffer[6 * k]; // Generate k samples at once
+        uint8_t buffer[6 * k + SE_CBD_BUFFER_PAD]; // Generate k samples at once
         prng_fill_buffer(6 * k, prng, (void *)buffer);
         for (size_t i = 0; i < k; i++) { poly[i + j] += get_cbd_val(buffer + 6 * i); }
     }
@@ -346,10 +623,18 @@ void sample_add_poly_cbd_generic_inpl_prng_k(int64_t *poly, size_t k, PolySizeTy
 
 void sample_add_poly_cbd_generic_inpl_prng_16(int64_t *poly, PolySizeType n, SE_PRNG *prng)
 {
-    for (size_t j = 0; j < n; j += 16)
+    size_t j = 0;
+    for (; j + 64 <= n; j += 64)
+    {
+        // -- Same as below, but 4 prng calls (64 samples) at once
+        uint8_t buffer[4 * 96 + SE_CBD_BUFFER_PAD];
+        prng_fill_buffer_x4(96, prng, (void *)buffer);
+        for (size_t i = 0; i < 64; i++) { poly[i + j] += get_cbd_val(buffer + 6 * i); }
+    }
+    for (; j < n; j += 16)
     {
         // -- Every 42 bits (6 bytes) generates a sample
-        uint8_t buffer[96];  // Generate 16 samples at once (6 * 16 = 96 bytes)
+        uint8_t buffer[96 + SE_CBD_BUFFER_PAD];  // Generate 16 samples at once (6 * 16 = 96 bytes)
         prng_fill_buffer(96, prng, (void *)buffer);
         for (size_t i = 0; i < 16; i++) { poly[i + j] += get_cbd_val(buffer + 6 * i); }
     }
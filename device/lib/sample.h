@@ -128,7 +128,11 @@ static inline double random_double(void)
 /**
 Samples a polynomial with coefficients from the uniform distribution over [0, q).
 Used to sample the second element of a ciphertext for symmetric encryption.
-Internally samples from the udev device using getrandom(). Uses rejection sampling.
+Internally samples from the udev device using getrandom(). Uses rejection sampling, where rejected
+values are replaced with the next values of the same PRNG stream (see: prng_stream_squeeze).
+All n candidates are reduced at once without branches (with AVX2 where available), and the rejected
+ones are then replaced in a second pass. The output is the same as when rejection sampling one
+coefficient at a time, so the receiver can regenerate the polynomial from the seed.
 
 Space req: 'poly' must have space for n ZZ elements.
 
@@ -223,8 +227,9 @@ void convert_poly_ternary_inpl(ZZ *poly, const Parms *parms);
 /**
 Samples an (expanded) polynomial from the uniform ternary distribution over {-q-1, 0, 1}, where q is
 the value of the current modulus. This function is mainly useful for testing, since most of the time
-we would want to sample the polynomial in compressed form (see: sample_small_poly_ternary). PRNG
-instance is used to generate randomness for 1 coefficient at a time.
+we would want to sample the polynomial in compressed form (see: sample_small_poly_ternary). All
+coefficients (and rejection re-samples) are drawn from a single PRNG stream (see:
+prng_stream_squeeze).
 
 Space req: 'poly' must have space for n ZZ values
 
@@ -265,9 +270,9 @@ Space req: 'poly' must have space for n uin8_t values
 
 /**
 Samples a small (compressed) polynomial from the uniform ternary distribution over {-q-1, 0, 1},
-where q is the value of the current modulus, while leaving the polynomial in compressed form. PRNG
-instance is used to generate randomness for 96 coefficients at a time (prior to any required
-rejection re-sampling, which occurs 1 coefficient at a time).
+where q is the value of the current modulus, while leaving the polynomial in compressed form. Draws
+randomness for 96 coefficients at a time (prior to any required rejection re-sampling, which occurs
+1 coefficient at a time) from a single PRNG stream (see: prng_stream_squeeze).
 
 Space req: 'poly' must have space for n uin8_t values
 
@@ -304,7 +309,8 @@ PRNG instance is used to generate randomness for k coefficients at a time.
 
 /**
 Samples coefficients of a polynomial from a centered binomial distribution (non-modulo-reduced).
-PRNG instance is used to generate randomness for 16 coefficients at a time.
+PRNG instance is used to generate randomness for 16 coefficients at a time (in batches of 4 calls,
+see: prng_fill_buffer_x4).
 
 @param[in]     n     Number of coefficients to sample (e.g. degree of 'poly')
 @param[in,out] prng  PRNG instance (will update counter)
@@ -339,7 +345,7 @@ coefficients at a time.
 /**
 Samples coefficients of a polynomial from a centered binomial distribution (non-modulo-reduced) and
 adds them in-place to the polynomial 'poly'. PRNG instance is used to generate randomness for 16
-coefficients at a time.
+coefficients at a time (in batches of 4 calls, see: prng_fill_buffer_x4).
 
 @param[in, out] poly  In: Initial polynomial; Out: Initial polynomial + cbd error polynomial
 @param[in]      n     Number of coefficients to sample (e.g. degree of 'poly')
@@ -12,25 +12,29 @@
 #include "ckks_sym.h"
 #include "defines.h"
 #include "fileops.h"
+#include "ntt.h"
+#include "pack.h"
 #include "parameters.h"
+#include "polymodarith.h"
+#include "sample.h"
 #include "util_print.h"
 
-static Parms se_encr_params_global;
-static SE_PTRS se_ptrs_global;
+#ifndef SE_USE_MALLOC
 static SE_PARMS se_parms_global;
-static SE_PRNG se_shareable_prng_global;
-static SE_PRNG se_prng_global;
+static ZZ se_mempool_global[MEMPOOL_SIZE];
+#endif
 
-SE_PARMS *se_setup_custom(size_t degree, size_t nprimes, const ZZ *modulus_vals, const ZZ *ratios,
-                          double scale, EncryptType encrypt_type)
+void se_setup_context(size_t degree, size_t nprimes, const ZZ *modulus_vals, const ZZ *ratios,
+                      double scale, EncryptType encrypt_type, ZZ *mempool, SE_PARMS *se_parms)
 {
-    SE_PARMS *se_parms = &se_parms_global;
-    Parms *parms       = &se_encr_params_global;
-    SE_PTRS *se_ptrs   = &se_ptrs_global;
+    se_assert(se_parms && mempool);
+    memset(se_parms, 0, sizeof(SE_PARMS));
+    se_parms->parms   = &(se_parms->parms_store);
+    se_parms->se_ptrs = &(se_parms->se_ptrs_store);
+    se_parms->mempool = mempool;
 
-    se_assert(se_parms && parms && se_ptrs);
-    se_parms->parms   = parms;
-    se_parms->se_ptrs = se_ptrs;
+    Parms *parms     = se_parms->parms;
+    SE_PTRS *se_ptrs = se_parms->se_ptrs;
 
     size_t n             = degree;
     parms->scale         = scale;
@@ -39,46 +43,66 @@ SE_PARMS *se_setup_custom(size_t degree, size_t nprimes, const ZZ *modulus_vals,
     parms->sample_s      = 0;
     parms->small_u       = 1;
     parms->small_s       = 1;
-    se_parms->parms      = parms;
 
-#ifdef SE_USE_MALLOC
-    ZZ *mempool;
-    if (encrypt_type == SE_ASYM_ENCR)
+    if (encrypt_type == SE_ASYM_ENCR) { ckks_set_ptrs_asym(n, mempool, se_ptrs); }
+    else
     {
-        print_ckks_mempool_size(n, 0);
-        mempool = ckks_mempool_setup_asym(n);
+        ckks_set_ptrs_sym(n, mempool, se_ptrs);
     }
+
+    if (!modulus_vals || !ratios) { ckks_setup(n, nprimes, se_ptrs->index_map_ptr, parms); }
     else
     {
-        print_ckks_mempool_size(n, 1);
-        mempool = ckks_mempool_setup_sym(n);
+        ckks_setup_custom(n, nprimes, modulus_vals, ratios, se_ptrs->index_map_ptr, parms);
     }
-    se_assert(mempool);
-#else
-    print_ckks_mempool_size();
-    printf("In se_setup_custom, no malloc\n");
-    // ZZ *mempool = &(mempool_ptr_global[0]);
-    ZZ *mempool = *mempool_ptr_global;
-    printf("Address of mempool_ptr_global: %p\n", &mempool_ptr_global);
-    printf("Value of mempool_ptr_global (should be address of mempool_local): %p\n",
-           mempool_ptr_global);
-    printf("Value of mempool (should be equal to value of mempool_ptr_global): %p\n", mempool);
-#endif
 
-    if (encrypt_type == SE_ASYM_ENCR) { ckks_set_ptrs_asym(n, mempool, se_ptrs); }
+    if (encrypt_type == SE_SYM_ENCR)
+    {
+        ckks_setup_s(parms, NULL, NULL, se_ptrs->ternary);
+#ifdef SE_SK_PERSISTENT_NTT
+        ckks_setup_ntt_s(parms, se_ptrs->ternary, se_ptrs->ntt_roots_ptr, se_ptrs->ntt_s_ptr);
+#endif
+    }
+#ifdef SE_PK_PERSISTENT
     else
     {
-        ckks_set_ptrs_sym(n, mempool, se_ptrs);
+        ckks_setup_pk(parms, se_ptrs->pk_ptr);
     }
+#endif
+}
 
-    if (!modulus_vals || !ratios) { ckks_setup(n, nprimes, se_ptrs->index_map_ptr, parms); }
+SE_PARMS *se_setup_custom(size_t degree, size_t nprimes, const ZZ *modulus_vals, const ZZ *ratios,
+                          double scale, EncryptType encrypt_type)
+{
+    size_t n = degree;
+#ifdef SE_USE_MALLOC
+    SE_PARMS *se_parms = calloc(1, sizeof(SE_PARMS));
+    se_assert(se_parms);
+    if (!se_parms) return NULL;
+
+    ZZ *mempool;
+    if (encrypt_type == SE_ASYM_ENCR)
+    {
+        print_ckks_mempool_size(n, nprimes, 0);
+        mempool = ckks_mempool_setup_asym(n, nprimes);
+    }
     else
     {
-        ckks_setup_custom(n, nprimes, modulus_vals, ratios, se_ptrs->index_map_ptr, parms);
+        print_ckks_mempool_size(n, nprimes, 1);
+        mempool = ckks_mempool_setup_sym(n, nprimes);
     }
+    se_assert(mempool);
+#else
+    SE_PARMS *se_parms = &se_parms_global;
+    ZZ *mempool        = &(se_mempool_global[0]);
+    print_ckks_mempool_size();
+    se_assert(n == SE_DEGREE_N);
+#endif
 
-    if (encrypt_type == SE_SYM_ENCR) { ckks_setup_s(parms, NULL, NULL, se_ptrs->ternary); }
-
+    se_setup_context(n, nprimes, modulus_vals, ratios, scale, encrypt_type, mempool, se_parms);
+#ifdef SE_USE_MALLOC
+    se_parms->owns_memory = 1;
+#endif
     return se_parms;
 }
 
@@ -95,8 +119,97 @@ SE_PARMS *se_setup_default(EncryptType encrypt_type)
     return se_setup(4096, 3, scale, encrypt_type);
 }
 
-bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR network_send_function,
-                       void *v, size_t vlen_bytes, bool print, SE_PARMS *se_parms)
+/**
+Helper function to send the ciphertext for the current prime using network_send_function.
+
+If SE_ENABLE_SYM_SEED_CT is defined, only sends c0 in symmetric mode (see: se_send_seed). If
+SE_ENABLE_PACKED_CT is defined, packs each component in place before sending it.
+
+@param[in]     network_send_function  Function to send each ciphertext component
+@param[in]     parms                  Parameters instance
+@param[in,out] c0                     First ciphertext component
+@param[in,out] c1                     Second ciphertext component
+*/
+static void se_send_ciphertext(SEND_FNCT_PTR network_send_function, const Parms *parms, ZZ *c0,
+                               ZZ *c1)
+{
+    size_t n = parms->coeff_count;
+    size_t nbytes_send, nbytes_recv;
+
+#ifdef SE_ENABLE_PACKED_CT
+    size_t nbits = packed_bit_count(parms->curr_modulus);
+    nbytes_send  = poly_pack_inpl(c0, n, nbits);
+#else
+    nbytes_send = n * sizeof(ZZ);
+#endif
+    nbytes_recv = network_send_function(c0, nbytes_send);
+    se_assert(nbytes_recv == nbytes_send);
+
+#ifdef SE_ENABLE_SYM_SEED_CT
+    // -- In symmetric mode, the receiver regenerates c1 from the seed instead
+    if (parms->is_asymmetric)
+#endif
+    {
+#ifdef SE_ENABLE_PACKED_CT
+        nbytes_send = poly_pack_inpl(c1, n, nbits);
+#endif
+        nbytes_recv = network_send_function(c1, nbytes_send);
+        se_assert(nbytes_recv == nbytes_send);
+    }
+    SE_UNUSED(nbytes_recv);
+}
+
+#ifdef SE_ENABLE_SYM_SEED_CT
+/**
+Helper function to set the header of a seeded symmetric ciphertext (see: se_send_seed).
+
+@param[in]  shareable_prng  Shareable prng, before sampling 'a' for the first prime
+@param[out] header          Header (SE_SEED_CT_HEADER_BYTE_COUNT bytes)
+*/
+static void se_set_seed_header(const SE_PRNG *shareable_prng, uint8_t *header)
+{
+    header[0] = SE_PRNG_SEED_VERSION;
+    memcpy(&(header[1]), &(shareable_prng->seed[0]), SE_PRNG_SEED_BYTE_COUNT);
+
+    // -- The counter of the shareable prng must start at 0 for the receiver to regenerate c1
+    se_assert(shareable_prng->counter == 0);
+}
+
+/**
+Helper function to send the header of a seeded symmetric ciphertext using network_send_function:
+SE_PRNG_SEED_VERSION, followed by the seed of the shareable prng. Must be called once per message,
+after ckks_sym_init and before sending c0 for the first prime. The receiver regenerates c1 for the
+i-th prime sent by expanding this seed with the prng counter set to i.
+
+@param[in] network_send_function  Function to send the header
+@param[in] shareable_prng         Shareable prng, before sampling 'a' for the first prime
+*/
+static void se_send_seed(SEND_FNCT_PTR network_send_function, const SE_PRNG *shareable_prng)
+{
+    uint8_t header[SE_SEED_CT_HEADER_BYTE_COUNT];
+    se_set_seed_header(shareable_prng, header);
+    size_t nbytes_recv = network_send_function(&(header[0]), SE_SEED_CT_HEADER_BYTE_COUNT);
+    se_assert(nbytes_recv == SE_SEED_CT_HEADER_BYTE_COUNT);
+    SE_UNUSED(nbytes_recv);
+}
+#endif
+
+/**
+Helper function to encode a vector of values and sample the errors (and 'u' in asymmetric mode) for
+a new encode-encrypt sequence. If SE_ENABLE_SYM_SEED_CT is defined, also sends the seed header in
+symmetric mode. Resets the parameters to the first prime.
+
+@param[in] shareable_seed         [Optional]. Seed for the shareable prng
+@param[in] seed                   [Optional]. Seed for the (non-shareable) prng
+@param[in] network_send_function  [Optional]. Function to send the seed header
+@param[in] v                      Values to encode
+@param[in] vlen_bytes             Number of bytes in v
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+static bool se_encode_init(uint8_t *shareable_seed, uint8_t *seed,
+                           SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                           SE_PARMS *se_parms)
 {
     se_assert(se_parms);
     se_assert(se_parms && se_parms->se_ptrs);
@@ -104,10 +217,13 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
     Parms *parms     = se_parms->parms;
     SE_PTRS *se_ptrs = se_parms->se_ptrs;
     size_t n         = parms->coeff_count;
+    SE_UNUSED(network_send_function);
 
-    size_t copy_size_bytes = (n / 2) * sizeof(ZZ);
+    // -- Zero-pad the entire values buffer so short inputs do not pick up stale values
+    size_t values_size_bytes = (n / 2) * sizeof(flpt);
+    size_t copy_size_bytes   = values_size_bytes;
     if (vlen_bytes < copy_size_bytes) copy_size_bytes = vlen_bytes;
-    memset(se_ptrs->values, 0, copy_size_bytes);
+    memset(se_ptrs->values, 0, values_size_bytes);
     memcpy(se_ptrs->values, v, copy_size_bytes);
 
     ckks_reset_primes(parms);
@@ -125,15 +241,17 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
 
     if (parms->is_asymmetric)
     {
-        ckks_asym_init(parms, seed, &se_prng_global, se_ptrs->conj_vals_int_ptr, se_ptrs->ternary,
-                       se_ptrs->e1_ptr);
-        load_pki(0, parms, se_ptrs->c0_ptr);
-        load_pki(1, parms, se_ptrs->c1_ptr);
+        // -- Note: pk is loaded (or read from the resident copy) by ckks_encode_encrypt_asym
+        ckks_asym_init(parms, seed, &(se_parms->prng), se_ptrs->conj_vals_int_ptr,
+                       se_ptrs->ternary, se_ptrs->e1_ptr);
     }
     else
     {
-        ckks_sym_init(parms, shareable_seed, seed, &se_shareable_prng_global, &se_prng_global,
-                      se_ptrs->conj_vals_int_ptr);
+        ckks_sym_init(parms, shareable_seed, seed, &(se_parms->shareable_prng),
+                      &(se_parms->prng), se_ptrs->conj_vals_int_ptr);
+#ifdef SE_ENABLE_SYM_SEED_CT
+        if (network_send_function) se_send_seed(network_send_function, &(se_parms->shareable_prng));
+#endif
     }
     // -- Debugging
     // print_poly_int64("pte, reg", se_ptrs->conj_vals_int_ptr, n);
@@ -141,21 +259,34 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
     // -- Uncomment this line and the similar line above to check against
     //    expected values with adapter
     // print_poly_int64_full("pte, reg", se_ptrs->conj_vals_int_ptr, n);
+    return true;
+}
+
+bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR network_send_function,
+                       void *v, size_t vlen_bytes, bool print, SE_PARMS *se_parms)
+{
+    bool ret = se_encode_init(shareable_seed, seed, network_send_function, v, vlen_bytes, se_parms);
+    if (!ret) return ret;
+    Parms *parms     = se_parms->parms;
+    SE_PTRS *se_ptrs = se_parms->se_ptrs;
+    size_t n         = parms->coeff_count;
 
     for (size_t i = 0; i < parms->nprimes; i++)
     {
         if (parms->is_asymmetric)
         {
             ckks_encode_encrypt_asym(parms, se_ptrs->conj_vals_int_ptr, se_ptrs->ternary,
-                                     se_ptrs->e1_ptr, se_ptrs->ntt_roots_ptr, se_ptrs->ntt_pte_ptr,
-                                     NULL, NULL, se_ptrs->c0_ptr, se_ptrs->c1_ptr);
+                                     se_ptrs->e1_ptr, se_ptrs->pk_ptr, se_ptrs->ntt_roots_ptr,
+                                     se_ptrs->ntt_pte_ptr, NULL, NULL, se_ptrs->c0_ptr,
+                                     se_ptrs->c1_ptr);
         }
         else
         {
             ckks_encode_encrypt_sym(parms, se_ptrs->conj_vals_int_ptr, NULL,
-                                    &se_shareable_prng_global, se_ptrs->ternary,
-                                    se_ptrs->ntt_pte_ptr, se_ptrs->ntt_roots_ptr, se_ptrs->c0_ptr,
-                                    se_ptrs->c1_ptr, NULL, NULL);
+                                    &(se_parms->shareable_prng), se_ptrs->ternary,
+                                    se_ptrs->ntt_s_ptr, se_ptrs->ntt_pte_ptr,
+                                    se_ptrs->ntt_roots_ptr, se_ptrs->c0_ptr, se_ptrs->c1_ptr, NULL,
+                                    NULL);
         }
 
         if (print)
@@ -168,6 +299,10 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
 #ifndef SE_REVERSE_CT_GEN_ENABLED
         // -- Sanity check
         se_assert(se_parms->parms->curr_modulus_idx == i);
+#endif
+#ifdef SE_ENABLE_SYM_SEED_CT
+        // -- c1 of the i-th prime sent must be expanded from the seed with counter i
+        se_assert(parms->is_asymmetric || se_parms->shareable_prng.counter == i + 1);
 #endif
         // -- Sanity checks
         for (size_t i = 0; i < n; i++)
@@ -178,58 +313,571 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
 #endif
 
         if (network_send_function)
+            se_send_ciphertext(network_send_function, parms, se_ptrs->c0_ptr, se_ptrs->c1_ptr);
+
+        if ((i + 1) < parms->nprimes)
+        {
+            if (parms->is_asymmetric)
+                ckks_next_prime_asym(parms, se_ptrs->ternary);
+            else
+                ckks_next_prime_sym(parms, se_ptrs->ternary);
+        }
+    }
+    return true;
+}
+
+bool se_encrypt(SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes, bool print,
+                SE_PARMS *se_parms)
+{
+    return se_encrypt_seeded(NULL, NULL, network_send_function, v, vlen_bytes, print, se_parms);
+}
+
+#ifdef SE_USE_MALLOC
+/**
+Helper function to send 'len' coefficients of a ciphertext component through a non-blocking stream.
+If SE_ENABLE_PACKED_CT is defined, packs them in place first.
+
+Req: Unless this is the last block of the component, len must be a multiple of 8.
+
+@param[in]     stream  Non-blocking send interface
+@param[in]     parms   Parameters instance
+@param[in,out] poly    Coefficients to send. Must not be modified until stream->wait returns.
+@param[in]     len     Number of coefficients to send
+*/
+static void se_stream_send_poly(const SE_SEND_STREAM *stream, const Parms *parms, ZZ *poly,
+                                size_t len)
+{
+#ifdef SE_ENABLE_PACKED_CT
+    size_t nbytes_send = poly_pack_inpl(poly, len, packed_bit_count(parms->curr_modulus));
+#else
+    size_t nbytes_send = len * sizeof(ZZ);
+    SE_UNUSED(parms);
+#endif
+    size_t nbytes_recv = stream->send(stream->ctx, poly, nbytes_send);
+    se_assert(nbytes_recv == nbytes_send);
+    SE_UNUSED(nbytes_recv);
+}
+
+/**
+Helper function to symmetrically encrypt the current prime and send the ciphertext through a
+non-blocking stream (see: se_encrypt_stream_seeded). Computes ntt(m + e) and 'a' before waiting for
+the previous prime's ciphertext to finish sending, so 'a' must not be the buffer that was sent as c1
+for the previous prime.
+
+@param[in] stream     Non-blocking send interface
+@param[in] se_parms   SE_PARMS instance
+@param[in] ntt_s      Secret key in NTT form w.r.t. the current prime
+@param[in] ntt_roots  NTT roots for the current prime. Ignored if SE_NTT_OTF is defined.
+@param     ntt_pte    Scratch space for ntt(m + e). Must not overlap with c0, c1, or 'a'.
+@param     a          Scratch space for 'a', which is sent as c1. Must not overlap with c0.
+*/
+static void se_stream_encrypt_prime(const SE_SEND_STREAM *stream, SE_PARMS *se_parms,
+                                    const ZZ *ntt_s, const ZZ *ntt_roots, ZZ *ntt_pte, ZZ *a)
+{
+    Parms *parms       = se_parms->parms;
+    ZZ *c0             = se_parms->se_ptrs->c0_ptr;
+    size_t n           = parms->coeff_count;
+    size_t chunk_count = stream->chunk_count ? stream->chunk_count : n;
+    se_assert(chunk_count % 8 == 0);
+
+    // -- These overlap the send of the previous prime's ciphertext
+    ckks_calc_ntt_pte_sym(parms, se_parms->se_ptrs->conj_vals_int_ptr, ntt_roots, ntt_pte);
+    sample_poly_uniform(parms, &(se_parms->shareable_prng), a);
+
+    // -- c0 may still be in use by the stream until now
+    stream->wait(stream->ctx);
+    for (size_t k = 0; k < n; k += chunk_count)
+    {
+        size_t len = (n - k < chunk_count) ? n - k : chunk_count;
+        poly_mul_neg_add_mod(&(ntt_s[k]), &(a[k]), &(ntt_pte[k]), len, parms->curr_modulus,
+                             &(c0[k]));
+        se_stream_send_poly(stream, parms, &(c0[k]), len);
+    }
+#ifndef SE_ENABLE_SYM_SEED_CT
+    se_stream_send_poly(stream, parms, a, n);
+#endif
+}
+
+/**
+Helper function for se_encrypt_batch_seeded and se_encrypt_stream_seeded. Sends each ciphertext with
+network_send_function if stream is NULL, and through the stream otherwise.
+*/
+static bool se_encrypt_batch_base(uint8_t *shareable_seeds, uint8_t *seeds,
+                                  SEND_FNCT_PTR network_send_function,
+                                  const SE_SEND_STREAM *stream, const void **vecs, size_t count,
+                                  size_t vlen_bytes, SE_PARMS *se_parms)
+{
+    se_assert(se_parms && se_parms->parms && se_parms->se_ptrs);
+    se_assert(vecs || !count);
+    Parms *parms     = se_parms->parms;
+    SE_PTRS *se_ptrs = se_parms->se_ptrs;
+
+    if (parms->is_asymmetric)
+    {
+        se_assert(!stream);
+        if (stream) return false;
+        for (size_t b = 0; b < count; b++)
+        {
+            uint8_t *seed = seeds ? &(seeds[b * SE_PRNG_SEED_BYTE_COUNT]) : NULL;
+            bool ret = se_encrypt_seeded(NULL, seed, network_send_function, (void *)vecs[b],
+                                         vlen_bytes, false, se_parms);
+            if (!ret) return ret;
+        }
+        return true;
+    }
+
+    se_assert(parms->small_s);
+    size_t n              = parms->coeff_count;
+    size_t nprimes        = parms->nprimes;
+    size_t roots_size     = ntt_roots_size(n);
+    size_t full_vlen_size = (n / 2) * sizeof(flpt);
+
+    // -- Resident per-prime state: ntt(s) and ntt roots for each prime, plus scratch for ntt(pte).
+    //    (ntt_pte_ptr may alias c1 in the memory pool, so we cannot use it here.)
+    //    If SE_SK_PERSISTENT_NTT is defined, ntt(s) is already resident in the memory pool.
+#ifdef SE_SK_PERSISTENT_NTT
+    size_t ntt_s_all_size = 0;
+#else
+    size_t ntt_s_all_size = nprimes * n;
+#endif
+    //    If streaming, 'a' alternates between c1 and one more buffer, so that the next prime's 'a'
+    //    can be sampled while the previous one is sent.
+    size_t a_buf_size = stream ? n : 0;
+    ZZ *batch_mem = calloc(ntt_s_all_size + nprimes * roots_size + n + a_buf_size, sizeof(ZZ));
+    se_assert(batch_mem);
+    if (!batch_mem) return false;
+    ZZ *ntt_s_all     = batch_mem;
+    ZZ *ntt_roots_all = &(batch_mem[ntt_s_all_size]);
+    ZZ *ntt_pte       = &(batch_mem[ntt_s_all_size + nprimes * roots_size]);
+    ZZ *a_bufs[2]     = {se_ptrs->c1_ptr, &(ntt_pte[n])};
+#ifdef SE_ENABLE_SYM_SEED_CT
+    uint8_t seed_header[SE_SEED_CT_HEADER_BYTE_COUNT];
+#endif
+
+    // -- Load s if it does not persist in the memory pool across calls
+    const ZZ *s = se_ptrs->ternary;
+#if defined(SE_SK_NOT_PERSISTENT) || defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
+    s = load_sk(parms, se_ptrs->ternary);
+#endif
+    ckks_reset_primes(parms);
+    for (size_t i = 0; i < nprimes; i++)
+    {
+        ZZ *ntt_roots = roots_size ? &(ntt_roots_all[i * roots_size]) : NULL;
+#ifdef SE_SK_PERSISTENT_NTT
+        SE_UNUSED(s);
+        ntt_roots_initialize(parms, ntt_roots);
+#else
+        ckks_calc_ntt_s_sym(parms, s, ntt_roots, &(ntt_s_all[i * n]));
+#endif
+        if ((i + 1) < nprimes) ckks_next_prime_sym(parms, se_ptrs->ternary);
+    }
+#ifdef SE_SK_PERSISTENT_NTT
+    ntt_s_all = se_ptrs->ntt_s_ptr;
+#endif
+
+    bool ret = true;
+    for (size_t b = 0; b < count && ret; b++)
+    {
+        // -- The encoder shares memory with c0 and c1, so they must be done sending
+        if (stream) stream->wait(stream->ctx);
+
+        // -- Encode directly from the input vector if it is full-length
+        const flpt *values = (const flpt *)vecs[b];
+        if (vlen_bytes < full_vlen_size)
         {
-            size_t nbytes_send, nbytes_recv;
+            se_assert(se_ptrs->values);
+            memset(se_ptrs->values, 0, full_vlen_size);
+            memcpy(se_ptrs->values, vecs[b], vlen_bytes);
+            values = se_ptrs->values;
+        }
 
-            // TODO: Finish this feature, add to defines
+        ckks_reset_primes(parms);
+        ret = ckks_encode_base(parms, values, n / 2, se_ptrs->index_map_ptr, se_ptrs->ifft_roots,
+                               se_ptrs->conj_vals);
+        se_assert(ret);
+        if (!ret) break;
+
+        uint8_t *share_seed = shareable_seeds ? &(shareable_seeds[b * SE_PRNG_SEED_BYTE_COUNT]) : 0;
+        uint8_t *seed       = seeds ? &(seeds[b * SE_PRNG_SEED_BYTE_COUNT]) : 0;
+        ckks_sym_init(parms, share_seed, seed, &(se_parms->shareable_prng), &(se_parms->prng),
+                      se_ptrs->conj_vals_int_ptr);
 #ifdef SE_ENABLE_SYM_SEED_CT
-            if (!parms->is_asymmetric)
+        if (stream)
+        {
+            se_set_seed_header(&(se_parms->shareable_prng), seed_header);
+            size_t nbytes_recv = stream->send(stream->ctx, seed_header, sizeof(seed_header));
+            se_assert(nbytes_recv == sizeof(seed_header));
+            SE_UNUSED(nbytes_recv);
+        }
+        else if (network_send_function)
+            se_send_seed(network_send_function, &(se_parms->shareable_prng));
+#endif
+
+        for (size_t i = 0; i < nprimes; i++)
+        {
+            size_t idx    = parms->curr_modulus_idx;
+            ZZ *ntt_roots = roots_size ? &(ntt_roots_all[idx * roots_size]) : NULL;
+            if (stream)
             {
-                nbytes_send = SE_PRNG_SEED_BYTE_COUNT;
-                nbytes_recv =
-                    network_send_function(&(se_shareable_prng_global.seed[0]), nbytes_send);
-                se_assert(nbytes_recv == nbytes_send);
+                se_stream_encrypt_prime(stream, se_parms, &(ntt_s_all[idx * n]), ntt_roots,
+                                        ntt_pte, a_bufs[i & 1]);
             }
             else
-#endif
             {
-                nbytes_send = n * sizeof(ZZ);
-                nbytes_recv = network_send_function(se_ptrs->c0_ptr, nbytes_send);
-                se_assert(nbytes_recv == nbytes_send);
+                ckks_encrypt_sym_ntt_s(parms, se_ptrs->conj_vals_int_ptr,
+                                       &(se_parms->shareable_prng), &(ntt_s_all[idx * n]),
+                                       ntt_roots, ntt_pte, se_ptrs->c0_ptr, se_ptrs->c1_ptr);
+                if (network_send_function)
+                {
+                    se_send_ciphertext(network_send_function, parms, se_ptrs->c0_ptr,
+                                       se_ptrs->c1_ptr);
+                }
             }
-
-            nbytes_send = n * sizeof(ZZ);
-            nbytes_recv = network_send_function(se_ptrs->c1_ptr, nbytes_send);
-            se_assert(nbytes_recv == nbytes_send);
+            if ((i + 1) < nprimes) ckks_next_prime_sym(parms, se_ptrs->ternary);
         }
+    }
 
-        if ((i + 1) < parms->nprimes)
+    // -- Do not free the scratch memory (or return) while it may still be in use by the stream
+    if (stream) stream->wait(stream->ctx);
+    free(batch_mem);
+    return ret;
+}
+
+bool se_encrypt_batch_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                             SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                             size_t vlen_bytes, SE_PARMS *se_parms)
+{
+    return se_encrypt_batch_base(shareable_seeds, seeds, network_send_function, NULL, vecs, count,
+                                 vlen_bytes, se_parms);
+}
+
+bool se_encrypt_batch(SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                      size_t vlen_bytes, SE_PARMS *se_parms)
+{
+    return se_encrypt_batch_seeded(NULL, NULL, network_send_function, vecs, count, vlen_bytes,
+                                   se_parms);
+}
+
+bool se_encrypt_stream_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                              const SE_SEND_STREAM *stream, const void **vecs, size_t count,
+                              size_t vlen_bytes, SE_PARMS *se_parms)
+{
+    se_assert(stream && stream->send && stream->wait);
+    return se_encrypt_batch_base(shareable_seeds, seeds, NULL, stream, vecs, count, vlen_bytes,
+                                 se_parms);
+}
+
+bool se_encrypt_stream(const SE_SEND_STREAM *stream, const void **vecs, size_t count,
+                       size_t vlen_bytes, SE_PARMS *se_parms)
+{
+    return se_encrypt_stream_seeded(NULL, NULL, stream, vecs, count, vlen_bytes, se_parms);
+}
+
+/**
+Helper function to point a copy of the parameters at the i-th prime of the modulus chain, in the
+forward direction.
+
+@param[in,out] parms  Parameters instance
+@param[in]     i      Index of the prime in the modulus chain
+*/
+static void se_set_curr_prime(Parms *parms, size_t i)
+{
+    se_assert(i < parms->nprimes);
+    parms->curr_modulus_idx = i;
+    parms->curr_modulus     = &(parms->moduli[i]);
+#ifdef SE_REVERSE_CT_GEN_ENABLED
+    parms->curr_param_direction = 0;
+    parms->skip_ntt_load        = 0;
+#endif
+}
+
+bool se_prime_tasks_alloc(const SE_PARMS *se_parms, SE_PRIME_TASKS *tasks)
+{
+    se_assert(se_parms && se_parms->parms && tasks);
+    size_t n          = se_parms->parms->coeff_count;
+    size_t nprimes    = se_parms->parms->nprimes;
+    size_t roots_size = ntt_roots_size(n);
+
+    memset(tasks, 0, sizeof(SE_PRIME_TASKS));
+    tasks->tasks = calloc(nprimes, sizeof(SE_PRIME_TASK));
+    tasks->mem   = calloc(nprimes * (3 * n + roots_size), sizeof(ZZ));
+    se_assert(tasks->tasks && tasks->mem);
+    if (!tasks->tasks || !tasks->mem)
+    {
+        se_prime_tasks_free(tasks);
+        return false;
+    }
+    tasks->ntasks = nprimes;
+
+    for (size_t i = 0; i < nprimes; i++)
+    {
+        SE_PRIME_TASK *task = &(tasks->tasks[i]);
+        ZZ *task_mem        = &(tasks->mem[i * (3 * n + roots_size)]);
+        task->c0            = task_mem;
+        task->c1            = &(task_mem[n]);
+        task->ntt_pte       = &(task_mem[2 * n]);
+        task->ntt_roots     = roots_size ? &(task_mem[3 * n]) : NULL;
+    }
+    return true;
+}
+
+void se_prime_tasks_free(SE_PRIME_TASKS *tasks)
+{
+    se_assert(tasks);
+    if (tasks->tasks) free(tasks->tasks);
+    if (tasks->mem) free(tasks->mem);
+    memset(tasks, 0, sizeof(SE_PRIME_TASKS));
+}
+
+bool se_prime_tasks_setup(uint8_t *shareable_seed, uint8_t *seed,
+                          SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                          SE_PARMS *se_parms, SE_PRIME_TASKS *tasks)
+{
+    se_assert(se_parms && se_parms->parms && tasks && tasks->tasks);
+    Parms *parms = se_parms->parms;
+    se_assert(tasks->ntasks == parms->nprimes);
+    if (tasks->ntasks != parms->nprimes) return false;
+
+    bool ret = se_encode_init(shareable_seed, seed, network_send_function, v, vlen_bytes, se_parms);
+    if (!ret) return ret;
+
+    // -- Load s if it does not persist in the memory pool across calls. The encoder shares memory
+    //    with s in this case, so this must happen after encoding.
+    const ZZ *s = se_parms->se_ptrs->ternary;
+#if defined(SE_SK_NOT_PERSISTENT) || defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
+    if (!parms->is_asymmetric) s = load_sk(parms, se_parms->se_ptrs->ternary);
+#endif
+
+    for (size_t i = 0; i < tasks->ntasks; i++)
+    {
+        SE_PRIME_TASK *task = &(tasks->tasks[i]);
+        task->se_parms      = se_parms;
+        task->s             = s;
+        task->parms         = *parms;
+        se_set_curr_prime(&(task->parms), i);
+        // -- The i-th prime's 'a' is sampled with the shareable prng counter set to i
+        task->shareable_prng         = se_parms->shareable_prng;
+        task->shareable_prng.counter = i;
+    }
+    return true;
+}
+
+void se_prime_task_run(SE_PRIME_TASK *task)
+{
+    se_assert(task && task->se_parms);
+    const Parms *parms = &(task->parms);
+    SE_PTRS *se_ptrs   = task->se_parms->se_ptrs;
+
+    if (parms->is_asymmetric)
+    {
+        se_assert(parms->small_u);
+        se_assert(se_ptrs->pk_ptr || parms->pk_from_file);
+        ckks_encode_encrypt_asym(parms, se_ptrs->conj_vals_int_ptr, se_ptrs->ternary,
+                                 se_ptrs->e1_ptr, se_ptrs->pk_ptr, task->ntt_roots, task->ntt_pte,
+                                 NULL, NULL, task->c0, task->c1);
+        return;
+    }
+
+    se_assert(parms->small_s);
+#ifdef SE_SK_PERSISTENT_NTT
+    const ZZ *ntt_s = &(se_ptrs->ntt_s_ptr[parms->curr_modulus_idx * parms->coeff_count]);
+    ntt_roots_initialize(parms, task->ntt_roots);
+#else
+    // -- ntt(s) is stored in c0, which is then overwritten in place with c0 = -a*s + (m + e)
+    ckks_calc_ntt_s_sym(parms, task->s, task->ntt_roots, task->c0);
+    const ZZ *ntt_s = task->c0;
+#endif
+    ckks_encrypt_sym_ntt_s(parms, se_ptrs->conj_vals_int_ptr, &(task->shareable_prng), ntt_s,
+                           task->ntt_roots, task->ntt_pte, task->c0, task->c1);
+}
+
+void se_prime_task_send(SEND_FNCT_PTR network_send_function, SE_PRIME_TASK *task)
+{
+    se_assert(network_send_function && task);
+    se_send_ciphertext(network_send_function, &(task->parms), task->c0, task->c1);
+}
+
+bool se_pipeline_alloc(SE_PARMS *se_parms, size_t nslots, SE_PIPELINE *pipe)
+{
+    se_assert(se_parms && se_parms->parms && se_parms->se_ptrs && pipe && nslots);
+    Parms *parms      = se_parms->parms;
+    SE_PTRS *se_ptrs  = se_parms->se_ptrs;
+    size_t n          = parms->coeff_count;
+    size_t nprimes    = parms->nprimes;
+    size_t roots_size = ntt_roots_size(n);
+    bool asym         = parms->is_asymmetric;
+
+    // -- Each slot holds m + e, plus e1 and 'u' (in small form) in asymmetric mode
+    size_t slot_size = 2 * n + (asym ? n / 4 + n / 16 : 0);
+#ifdef SE_SK_PERSISTENT_NTT
+    size_t ntt_s_all_size = 0;
+#else
+    size_t ntt_s_all_size = asym ? 0 : nprimes * n;
+#endif
+    memset(pipe, 0, sizeof(SE_PIPELINE));
+    pipe->slots = calloc(nslots, sizeof(SE_PIPELINE_SLOT));
+    pipe->mem   = calloc(nslots * slot_size + ntt_s_all_size + nprimes * roots_size + 3 * n,
+                         sizeof(ZZ));
+    se_assert(pipe->slots && pipe->mem);
+    if (!pipe->slots || !pipe->mem)
+    {
+        se_pipeline_free(pipe);
+        return false;
+    }
+    pipe->se_parms = se_parms;
+    spsc_ring_init(&(pipe->ring), nslots);
+    for (size_t b = 0; b < nslots; b++)
+    {
+        ZZ *slot_mem                 = &(pipe->mem[b * slot_size]);
+        pipe->slots[b].conj_vals_int = (int64_t *)slot_mem;
+        if (asym)
         {
-            if (parms->is_asymmetric)
-                ckks_next_prime_asym(parms, se_ptrs->ternary);
-            else
-                ckks_next_prime_sym(parms, se_ptrs->ternary);
+            pipe->slots[b].e1 = (int8_t *)&(slot_mem[2 * n]);
+            pipe->slots[b].u  = &(slot_mem[2 * n + n / 4]);
         }
     }
+    ZZ *encrypt_mem     = &(pipe->mem[nslots * slot_size]);
+    pipe->ntt_s_all     = ntt_s_all_size ? encrypt_mem : NULL;
+    pipe->ntt_roots_all = roots_size ? &(encrypt_mem[ntt_s_all_size]) : NULL;
+    pipe->ntt_pte       = &(encrypt_mem[ntt_s_all_size + nprimes * roots_size]);
+    pipe->c0            = &(pipe->ntt_pte[n]);
+    pipe->c1            = &(pipe->ntt_pte[2 * n]);
+    pipe->parms         = *parms;
+
+    // -- The roots and ntt(s) only depend on the prime, so compute them once for every message.
+    //    (In asymmetric mode, the roots are initialized by ckks_encode_encrypt_asym.)
+    if (asym) return true;
+    se_assert(parms->small_s);
+    const ZZ *s = se_ptrs->ternary;
+#if defined(SE_SK_NOT_PERSISTENT) || defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
+    s = load_sk(parms, se_ptrs->ternary);
+#endif
+    for (size_t i = 0; i < nprimes; i++)
+    {
+        se_set_curr_prime(&(pipe->parms), i);
+        ZZ *ntt_roots = roots_size ? &(pipe->ntt_roots_all[i * roots_size]) : NULL;
+#ifdef SE_SK_PERSISTENT_NTT
+        SE_UNUSED(s);
+        ntt_roots_initialize(&(pipe->parms), ntt_roots);
+#else
+        ckks_calc_ntt_s_sym(&(pipe->parms), s, ntt_roots, &(pipe->ntt_s_all[i * n]));
+#endif
+    }
+#ifdef SE_SK_PERSISTENT_NTT
+    pipe->ntt_s_all = se_ptrs->ntt_s_ptr;
+#endif
     return true;
 }
 
-bool se_encrypt(SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes, bool print,
-                SE_PARMS *se_parms)
+void se_pipeline_free(SE_PIPELINE *pipe)
 {
-    return se_encrypt_seeded(NULL, NULL, network_send_function, v, vlen_bytes, print, se_parms);
+    se_assert(pipe);
+    if (pipe->slots) free(pipe->slots);
+    if (pipe->mem) free(pipe->mem);
+    memset(pipe, 0, sizeof(SE_PIPELINE));
 }
 
+bool se_pipeline_can_encode(SE_PIPELINE *pipe)
+{
+    size_t idx;
+    return spsc_ring_write_slot(&(pipe->ring), &idx);
+}
+
+bool se_pipeline_encode(uint8_t *shareable_seed, uint8_t *seed, void *v, size_t vlen_bytes,
+                        SE_PIPELINE *pipe)
+{
+    se_assert(pipe && pipe->se_parms);
+    size_t idx;
+    bool ret = spsc_ring_write_slot(&(pipe->ring), &idx);
+    se_assert(ret);
+    if (!ret) return ret;
+
+    // -- Encoding only uses the memory pool of se_parms, which the encrypt stage never reads
+    SE_PARMS *se_parms = pipe->se_parms;
+    ret = se_encode_init(shareable_seed, seed, NULL, v, vlen_bytes, se_parms);
+    if (!ret) return ret;
+
+    SE_PTRS *se_ptrs       = se_parms->se_ptrs;
+    SE_PIPELINE_SLOT *slot = &(pipe->slots[idx]);
+    size_t n               = se_parms->parms->coeff_count;
+    memcpy(slot->conj_vals_int, se_ptrs->conj_vals_int_ptr, n * sizeof(int64_t));
+    if (se_parms->parms->is_asymmetric)
+    {
+        se_assert(se_parms->parms->small_u);
+        memcpy(slot->e1, se_ptrs->e1_ptr, n * sizeof(int8_t));
+        memcpy(slot->u, se_ptrs->ternary, (n / 16) * sizeof(ZZ));
+    }
+    else
+        slot->shareable_prng = se_parms->shareable_prng;
+
+    spsc_ring_push(&(pipe->ring));
+    return true;
+}
+
+bool se_pipeline_can_encrypt(SE_PIPELINE *pipe)
+{
+    size_t idx;
+    return spsc_ring_read_slot(&(pipe->ring), &idx);
+}
+
+void se_pipeline_encrypt(SEND_FNCT_PTR network_send_function, SE_PIPELINE *pipe)
+{
+    se_assert(pipe && pipe->se_parms);
+    size_t idx;
+    bool ret = spsc_ring_read_slot(&(pipe->ring), &idx);
+    se_assert(ret);
+    if (!ret) return;
+
+    SE_PIPELINE_SLOT *slot = &(pipe->slots[idx]);
+    Parms *parms           = &(pipe->parms);
+    const ZZ *pk_cache     = pipe->se_parms->se_ptrs->pk_ptr;
+    size_t n               = parms->coeff_count;
+    size_t roots_size      = ntt_roots_size(n);
+
+#ifdef SE_ENABLE_SYM_SEED_CT
+    if (!parms->is_asymmetric && network_send_function)
+        se_send_seed(network_send_function, &(slot->shareable_prng));
+#endif
+    for (size_t i = 0; i < parms->nprimes; i++)
+    {
+        se_set_curr_prime(parms, i);
+        ZZ *ntt_roots = roots_size ? &(pipe->ntt_roots_all[i * roots_size]) : NULL;
+        if (parms->is_asymmetric)
+        {
+            se_assert(pk_cache || parms->pk_from_file);
+            ckks_encode_encrypt_asym(parms, slot->conj_vals_int, slot->u, slot->e1, pk_cache,
+                                     ntt_roots, pipe->ntt_pte, NULL, NULL, pipe->c0, pipe->c1);
+        }
+        else
+        {
+            ckks_encrypt_sym_ntt_s(parms, slot->conj_vals_int, &(slot->shareable_prng),
+                                   &(pipe->ntt_s_all[i * n]), ntt_roots, pipe->ntt_pte, pipe->c0,
+                                   pipe->c1);
+        }
+        if (network_send_function)
+            se_send_ciphertext(network_send_function, parms, pipe->c0, pipe->c1);
+    }
+
+    // -- Only now may the encode stage reuse the slot
+    spsc_ring_pop(&(pipe->ring));
+}
+#endif
+
 void se_cleanup(SE_PARMS *se_parms)
 {
     se_assert(se_parms);
-#ifdef SE_USE_MALLOC
-    se_assert(se_parms->se_ptrs);
-    delete_parameters(se_parms->parms);
+    if (se_parms->parms) delete_parameters(se_parms->parms);
+    se_parms->parms = 0;
+
+    // -- Clear out the prng state so it does not outlive the instance
+    se_secure_zero_memset(&(se_parms->prng), sizeof(SE_PRNG));
+    se_secure_zero_memset(&(se_parms->shareable_prng), sizeof(SE_PRNG));
 
-    // -- Free the memory pool. Note that conj_vals should always point to the start.
-    // -- TODO: Make this better
-    if (se_parms->se_ptrs->conj_vals) free(se_parms->se_ptrs->conj_vals);
+#ifdef SE_USE_MALLOC
+    if (se_parms->owns_memory)
+    {
+        if (se_parms->mempool) free(se_parms->mempool);
+        free(se_parms);
+    }
 #endif
-    se_parms->parms = 0;
 }
@@ -11,6 +11,12 @@ need to be called. SEAL-Embedded offers three types of setup functions for devel
 different degrees of library configurability. se_setup_custom allows for the most customization,
 while se_setup_default uses default parameter settings. Note: Currently, SEAL-Embedded does not
 support reconfiguring parameters to a different parameter set after initial setup.
+
+All encryption state (parameters, memory pool pointers and prngs) is owned by the SE_PARMS handle
+returned by the setup functions, so independent handles may be used concurrently from different
+threads. A single handle must not be used by more than one thread at a time. When SE_USE_MALLOC is
+not defined, the se_setup* functions return a single static handle; use se_setup_context to set up
+additional handles over caller-owned memory.
 */
 
 #pragma once
@@ -22,6 +28,7 @@ support reconfiguring parameters to a different parameter set after initial setu
 
 #include "ckks_common.h"
 #include "defines.h"
+#include "spsc_ring.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,20 +46,31 @@ TODO: Use error codes
 /** Minimum negative error code value used by SEAL-Embedded */
 #define SE_ERR_MINIMUM -9999
 
-#ifndef SE_USE_MALLOC
-static ZZ **mempool_ptr_global;
-#endif
-
 /**
-SEAL-Embedded parameters struct for API.
+SEAL-Embedded parameters struct for API. Owns all per-instance encryption state.
 
-@param parms    Pointer to internal parameters struct
-@param se_ptrs  Pointer to SE_PTRS struct
+Note: parms and se_ptrs point into this struct, so an SE_PARMS instance must not be copied or moved
+after setup.
+
+@param parms           Pointer to internal parameters struct (points to parms_store)
+@param se_ptrs         Pointer to SE_PTRS struct (points to se_ptrs_store)
+@param mempool         Memory pool backing the se_ptrs pointers
+@param prng            Prng used to sample the error and ternary polynomials. Must not be shared.
+@param shareable_prng  Prng used to sample the 'a' polynomial (symmetric encryption only)
+@param parms_store     Storage for the internal parameters struct
+@param se_ptrs_store   Storage for the SE_PTRS struct
+@param owns_memory     Set to 1 if se_cleanup should free the memory pool and this instance
 */
 typedef struct
 {
     Parms *parms;
     SE_PTRS *se_ptrs;
+    ZZ *mempool;
+    SE_PRNG prng;
+    SE_PRNG shareable_prng;
+    Parms parms_store;
+    SE_PTRS se_ptrs_store;
+    bool owns_memory;
 } SE_PARMS;
 
 typedef enum { SE_SYM_ENCR, SE_ASYM_ENCR } EncryptType;
@@ -72,12 +90,60 @@ The third input parameters can specify any required flags.
 */
 typedef ssize_t (*RND_FNCT_PTR)(void *, size_t, unsigned int flags);
 
+/**
+Non-blocking (streaming) network send interface (see: se_encrypt_stream_seeded). Lets the library
+hand each finished block of a ciphertext to the transport as soon as it is ready, and keep computing
+while the transport drains it, instead of waiting for each call to a SEND_FNCT_PTR to return.
+
+The library never modifies or frees memory passed to 'send' until 'wait' returns, and calls 'wait'
+before reusing that memory and before returning. 'send' may therefore queue the pointer (e.g., for
+DMA or a transmit thread) rather than copy the data.
+
+@param send         Starts sending nbytes bytes at data and returns without waiting for the send to
+                    complete. Returns the number of bytes accepted (must be nbytes).
+@param wait         Blocks until all data passed to 'send' so far has been sent
+@param ctx          [Optional]. Passed to 'send' and 'wait' as their first parameter
+@param chunk_count  Number of coefficients of c0 per call to 'send'. Must be a multiple of 8 (so
+                    that packed chunks end on a byte boundary). If 0, c0 is sent in a single call.
+*/
+typedef struct
+{
+    size_t (*send)(void *ctx, const void *data, size_t nbytes);
+    void (*wait)(void *ctx);
+    void *ctx;
+    size_t chunk_count;
+} SE_SEND_STREAM;
+
+/**
+Sets up a caller-owned SE_PARMS instance for a particular encryption type and custom parameter set
+over a caller-owned memory pool. If either modulus_vals or ratios is NULL, uses the default modulus
+values for the requested degree and number of primes. Does not allocate the instance or the memory
+pool, so it may be used to set up multiple independent instances with or without SE_USE_MALLOC.
+
+Size req: mempool must be at least ckks_get_mempool_size_sym(degree, nprimes) ZZ values for symmetric
+encryption and ckks_get_mempool_size_asym(degree, nprimes) ZZ values for asymmetric encryption
+(MEMPOOL_SIZE if SE_USE_MALLOC is not defined).
+
+@param[in]  degree        Polynomial ring degree
+@param[in]  nprimes       Number of prime moduli
+@param[in]  modulus_vals  An array of nprimes type-ZZ modulus values.
+@param[in]  ratios        An array of const_ratio values for each custom modulus value
+                          (high word, followed by low word).
+@param[in]  scale         Scale
+@param[in]  enc_type      Encryption type
+@param[in]  mempool       Memory pool to carve the SE_PTRS pointers from
+@param[out] se_parms      SE_PARMS instance to set up
+*/
+void se_setup_context(size_t degree, size_t nprimes, const ZZ *modulus_vals, const ZZ *ratios,
+                      double scale, EncryptType encrypt_type, ZZ *mempool, SE_PARMS *se_parms);
+
 /**
 Setups up SEAL-Embedded for a particular encryption type for a custom parameter set, including a
 custom degree, number of modulus primes, modulus prime values, and scale. If either modulus_vals or
 ratios is NULL, reverts to se_setup functionality.
 
-Note: This function calls calloc.
+Note: This function calls calloc. If SE_USE_MALLOC is defined, each call returns a new, independent
+instance. Otherwise, each call sets up and returns the same static instance.
 
 @param[in] degree        Polynomial ring degree
 @param[in] nprimes       Number of prime moduli
@@ -121,9 +187,424 @@ bool se_encrypt_seeded(uint8_t *shareable_seed, uint8_t *seed, SEND_FNCT_PTR net
 bool se_encrypt(SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes, bool print,
                 SE_PARMS *se_parms);
 
+#ifdef SE_USE_MALLOC
+/**
+Encodes and encrypts a batch of value vectors, sending each ciphertext with network_send_function in
+the same order as 'count' consecutive calls to se_encrypt_seeded would. The NTT roots and the NTT
+form of the secret key are computed once per prime for the whole batch instead of once per prime
+per vector.
+
+Currently only amortizes work for symmetric encryption. For asymmetric encryption, this is
+equivalent to calling se_encrypt_seeded for each vector.
+
+Note: This function calls calloc.
+
+Size req: If seeds are !NULL, shareable_seeds and seeds must contain count * SE_PRNG_SEED_BYTE_COUNT
+bytes (one seed per vector).
+
+@param[in] shareable_seeds        [Optional]. Seeds for the shareable prng, one per vector
+@param[in] seeds                  [Optional]. Seeds for the (non-shareable) prng, one per vector
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] vecs                   Array of 'count' pointers to value vectors
+@param[in] count                  Number of vectors in vecs
+@param[in] vlen_bytes             Number of bytes in each vector of vecs
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_batch_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                             SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                             size_t vlen_bytes, SE_PARMS *se_parms);
+
+/**
+Encodes and encrypts a batch of value vectors. See: se_encrypt_batch_seeded.
+
+Note: This function calls calloc.
+
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] vecs                   Array of 'count' pointers to value vectors
+@param[in] count                  Number of vectors in vecs
+@param[in] vlen_bytes             Number of bytes in each vector of vecs
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_batch(SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                      size_t vlen_bytes, SE_PARMS *se_parms);
+
+/**
+Encodes and symmetrically encrypts a batch of value vectors like se_encrypt_batch_seeded, but sends
+each ciphertext through a non-blocking stream so that transmission overlaps computation. The bytes
+sent are identical to those sent by se_encrypt_batch_seeded (including the header of
+SE_ENABLE_SYM_SEED_CT and the packing of SE_ENABLE_PACKED_CT); only the call granularity differs.
+
+For each prime, ntt(m + e) and 'a' are computed while the previous prime's ciphertext is still being
+sent. After a single call to stream->wait, c0 is computed and sent in blocks of stream->chunk_count
+coefficients, followed by c1. The encoder shares memory with c0 and c1, so the last prime of each
+vector is not overlapped with the encoding of the next vector.
+
+Symmetric encryption only (returns 0 for asymmetric encryption).
+
+Note: This function calls calloc. Uses n more ZZ values of scratch memory than
+se_encrypt_batch_seeded, since 'a' is double buffered.
+
+Size req: If seeds are !NULL, shareable_seeds and seeds must contain count * SE_PRNG_SEED_BYTE_COUNT
+bytes (one seed per vector).
+
+@param[in] shareable_seeds  [Optional]. Seeds for the shareable prng, one per vector
+@param[in] seeds            [Optional]. Seeds for the (non-shareable) prng, one per vector
+@param[in] stream           Non-blocking send interface
+@param[in] vecs             Array of 'count' pointers to value vectors
+@param[in] count            Number of vectors in vecs
+@param[in] vlen_bytes       Number of bytes in each vector of vecs
+@param[in] se_parms         SE_PARMS instance
+@returns                    1 on success, 0 on failure
+*/
+bool se_encrypt_stream_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                              const SE_SEND_STREAM *stream, const void **vecs, size_t count,
+                              size_t vlen_bytes, SE_PARMS *se_parms);
+
+/**
+Encodes and symmetrically encrypts a batch of value vectors, sending each ciphertext through a
+non-blocking stream. See: se_encrypt_stream_seeded.
+
+Note: This function calls calloc.
+
+@param[in] stream      Non-blocking send interface
+@param[in] vecs        Array of 'count' pointers to value vectors
+@param[in] count       Number of vectors in vecs
+@param[in] vlen_bytes  Number of bytes in each vector of vecs
+@param[in] se_parms    SE_PARMS instance
+@returns               1 on success, 0 on failure
+*/
+bool se_encrypt_stream(const SE_SEND_STREAM *stream, const void **vecs, size_t count,
+                       size_t vlen_bytes, SE_PARMS *se_parms);
+
+/**
+Encryption task for a single prime of the modulus chain (see: se_prime_tasks_setup). The ciphertext
+components for different primes only depend on the encoded message, the error and ternary samples,
+and the prime itself, so the tasks for one message may run concurrently and in any order. Each task
+owns its own copy of the parameters (pointing at its prime), its own copy of the shareable prng (with
+the counter set to the prime's index), and its own output and scratch memory. All tasks read the
+encoding (and the key or 'u' and e1) from the memory pool of se_parms, which must not be modified
+until every task has finished.
+
+@param parms           Copy of the parameters with curr_modulus set to this task's prime
+@param shareable_prng  Copy of the shareable prng, positioned to sample this prime's 'a'
+@param se_parms        SE_PARMS instance the task was set up from
+@param s               Secret key in small form (symmetric mode only). Points into the memory pool
+                       of se_parms, or into code memory if SE_DATA_FROM_CODE_DIRECT is defined.
+@param c0              First ciphertext component (n ZZ values)
+@param c1              Second ciphertext component (n ZZ values)
+@param ntt_pte         Scratch space (n ZZ values)
+@param ntt_roots       NTT roots for this prime (NULL if SE_NTT_OTF or SE_NTT_ROOTS_FROM_CODE is
+                       defined)
+*/
+typedef struct
+{
+    Parms parms;
+    SE_PRNG shareable_prng;
+    SE_PARMS *se_parms;
+    const ZZ *s;
+    ZZ *c0;
+    ZZ *c1;
+    ZZ *ntt_pte;
+    ZZ *ntt_roots;
+} SE_PRIME_TASK;
+
+/**
+Set of per-prime encryption tasks, one for each prime of the modulus chain.
+
+@param tasks   Array of 'ntasks' tasks. Task i encrypts w.r.t. the i-th prime of the modulus chain.
+@param ntasks  Number of tasks (i.e., the number of primes)
+@param mem     Memory backing the c0, c1, ntt_pte, and ntt_roots buffers of every task
+*/
+typedef struct
+{
+    SE_PRIME_TASK *tasks;
+    size_t ntasks;
+    ZZ *mem;
+} SE_PRIME_TASKS;
+
+/**
+Allocates one encryption task per prime of the modulus chain of se_parms. The tasks may be reused
+for any number of messages.
+
+Note: This function calls calloc. Uses nprimes * (3 * n + r) ZZ values of memory on top of the
+memory pool, where r is the size of the NTT roots for one prime (0 if SE_NTT_OTF is defined).
+
+@param[in]  se_parms  SE_PARMS instance
+@param[out] tasks     Set of tasks to allocate
+@returns              1 on success, 0 on failure
+*/
+bool se_prime_tasks_alloc(const SE_PARMS *se_parms, SE_PRIME_TASKS *tasks);
+
+/**
+Frees a set of tasks allocated with se_prime_tasks_alloc.
+
+@param[in] tasks  Set of tasks to free
+*/
+void se_prime_tasks_free(SE_PRIME_TASKS *tasks);
+
+/**
+Encodes a vector of values and prepares one encryption task per prime (see: SE_PRIME_TASK). Runs
+every step of se_encrypt_seeded that is shared by all primes: encoding, sampling the errors (and 'u'
+in asymmetric mode), and, if SE_ENABLE_SYM_SEED_CT is defined, sending the seed header with
+network_send_function. The tasks may then be run with se_prime_task_run in any order (or
+concurrently), but must be sent with se_prime_task_send in order of the primes.
+
+Running and sending every task produces the same ciphertext as se_encrypt_seeded, and sends the same
+bytes as se_encrypt_batch_seeded, for the same seeds. SE_REVERSE_CT_GEN_ENABLED is ignored.
+
+@param[in]     shareable_seed         [Optional]. Seed for the shareable prng
+@param[in]     seed                   [Optional]. Seed for the (non-shareable) prng
+@param[in]     network_send_function  [Optional]. Function to send the seed header
+@param[in]     v                      Values to encode
+@param[in]     vlen_bytes             Number of bytes in v
+@param[in]     se_parms               SE_PARMS instance
+@param[in,out] tasks                  Set of tasks allocated with se_prime_tasks_alloc
+@returns                              1 on success, 0 on failure
+*/
+bool se_prime_tasks_setup(uint8_t *shareable_seed, uint8_t *seed,
+                          SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                          SE_PARMS *se_parms, SE_PRIME_TASKS *tasks);
+
+/**
+Encrypts the encoded message w.r.t. the task's prime, storing the ciphertext in task->c0 and
+task->c1. Only writes to memory owned by the task, so different tasks may run concurrently.
+
+@param[in,out] task  Task to run (set up with se_prime_tasks_setup)
+*/
+void se_prime_task_run(SE_PRIME_TASK *task);
+
+/**
+Sends the ciphertext of a task that has finished running with network_send_function, in the same
+format as se_encrypt_seeded. Tasks must be sent in order of the primes. If SE_ENABLE_PACKED_CT is
+defined, packs task->c0 and task->c1 in place.
+
+@param[in]     network_send_function  Function to send each ciphertext component
+@param[in,out] task                   Task to send
+*/
+void se_prime_task_send(SEND_FNCT_PTR network_send_function, SE_PRIME_TASK *task);
+
+/**
+Slot of an encode-encrypt pipeline (see: SE_PIPELINE). Holds everything the encrypt stage needs from
+the encode stage for one message.
+
+@param conj_vals_int   Encoded message plus error, i.e., m + e (n int64_t values)
+@param u               Ternary polynomial 'u' in small form (asymmetric encryption only)
+@param e1              Error polynomial e1 (asymmetric encryption only)
+@param shareable_prng  Shareable prng, positioned to sample 'a' for the first prime (symmetric
+                       encryption only)
+*/
+typedef struct
+{
+    int64_t *conj_vals_int;
+    ZZ *u;
+    int8_t *e1;
+    SE_PRNG shareable_prng;
+} SE_PIPELINE_SLOT;
+
+/**
+Two-stage encode-encrypt pipeline over a lock-free single-producer/single-consumer ring of encoded
+messages (see: spsc_ring.h). The encode stage (se_pipeline_encode) encodes a message and samples its
+errors (and 'u' in asymmetric mode) into a free slot, using the memory pool of se_parms. The encrypt
+stage (se_pipeline_encrypt) computes and sends the ciphertext for every prime from the oldest slot,
+using only the memory of the pipeline. The two stages may therefore run concurrently on different
+threads or cores that share memory, e.g., encoding message k + 1 while message k is encrypted.
+
+Exactly one thread may call the encode stage functions and exactly one (possibly different) thread
+may call the encrypt stage functions. Neither stage blocks: se_pipeline_can_encode and
+se_pipeline_can_encrypt tell the caller when to wait (see: se_encrypt_pipelined_seeded for a
+pthreads driver).
+
+@param se_parms       SE_PARMS instance. Its memory pool and prngs belong to the encode stage.
+@param ring           Ring of slot indices
+@param slots          Array of ring.nslots slots
+@param parms          Copy of the parameters used by the encrypt stage
+@param ntt_s_all      Secret key in NTT form for every prime (symmetric encryption only)
+@param ntt_roots_all  NTT roots for every prime (NULL if SE_NTT_OTF is defined)
+@param ntt_pte        Scratch space for the encrypt stage (n ZZ values)
+@param c0             First ciphertext component (n ZZ values)
+@param c1             Second ciphertext component (n ZZ values)
+@param mem            Memory backing all of the above buffers
+*/
+typedef struct
+{
+    SE_PARMS *se_parms;
+    SE_SPSC_RING ring;
+    SE_PIPELINE_SLOT *slots;
+    Parms parms;
+    ZZ *ntt_s_all;
+    ZZ *ntt_roots_all;
+    ZZ *ntt_pte;
+    ZZ *c0;
+    ZZ *c1;
+    ZZ *mem;
+} SE_PIPELINE;
+
+/**
+Allocates an encode-encrypt pipeline with 'nslots' slots for se_parms, and computes the NTT roots
+(and, in symmetric mode, the secret key in NTT form) for every prime.
+
+Note: This function calls calloc. Each slot uses 2 * n ZZ values of memory (plus n / 4 + n / 16 in
+asymmetric mode). The encrypt stage uses 3 * n + nprimes * r ZZ values, where r is the size of the
+NTT roots for one prime (0 if SE_NTT_OTF is defined), plus nprimes * n for ntt(s) in symmetric mode
+unless SE_SK_PERSISTENT_NTT is defined.
+
+@param[in]  se_parms  SE_PARMS instance
+@param[in]  nslots    Number of slots (at least 1)
+@param[out] pipe      Pipeline to allocate
+@returns              1 on success, 0 on failure
+*/
+bool se_pipeline_alloc(SE_PARMS *se_parms, size_t nslots, SE_PIPELINE *pipe);
+
+/**
+Frees a pipeline allocated with se_pipeline_alloc.
+
+@param[in] pipe  Pipeline to free
+*/
+void se_pipeline_free(SE_PIPELINE *pipe);
+
+/**
+Encode stage only. Returns 1 if a slot is free for se_pipeline_encode.
+
+@param[in] pipe  Pipeline
+@returns         1 if se_pipeline_encode may be called, 0 if all slots are in use
+*/
+bool se_pipeline_can_encode(SE_PIPELINE *pipe);
+
+/**
+Encode stage only. Encodes a vector of values and samples its errors (and 'u') into a free slot, and
+then publishes the slot to the encrypt stage.
+
+Req: se_pipeline_can_encode(pipe) must have returned 1 since the last call to this function.
+
+@param[in]     shareable_seed  [Optional]. Seed for the shareable prng
+@param[in]     seed            [Optional]. Seed for the (non-shareable) prng
+@param[in]     v               Values to encode
+@param[in]     vlen_bytes      Number of bytes in v
+@param[in,out] pipe            Pipeline
+@returns                       1 on success, 0 on failure (in which case no slot is published)
+*/
+bool se_pipeline_encode(uint8_t *shareable_seed, uint8_t *seed, void *v, size_t vlen_bytes,
+                        SE_PIPELINE *pipe);
+
+/**
+Encrypt stage only. Returns 1 if an encoded message is ready for se_pipeline_encrypt.
+
+@param[in] pipe  Pipeline
+@returns         1 if se_pipeline_encrypt may be called, 0 if no slot has been published
+*/
+bool se_pipeline_can_encrypt(SE_PIPELINE *pipe);
+
+/**
+Encrypt stage only. Encrypts the oldest encoded message w.r.t. every prime, sending each ciphertext
+with network_send_function, and then releases its slot to the encode stage. Sends the same bytes as
+se_encrypt_batch_seeded would for the same message and seeds (including the header of
+SE_ENABLE_SYM_SEED_CT). SE_REVERSE_CT_GEN_ENABLED is ignored.
+
+Req: se_pipeline_can_encrypt(pipe) must have returned 1 since the last call to this function.
+
+@param[in]     network_send_function  [Optional]. Function to send each ciphertext component
+@param[in,out] pipe                   Pipeline
+*/
+void se_pipeline_encrypt(SEND_FNCT_PTR network_send_function, SE_PIPELINE *pipe);
+
+#ifdef SE_USE_PTHREADS
+/**
+Encodes and encrypts a vector of values like se_encrypt_seeded, but encrypts w.r.t. each prime of
+the modulus chain on one of 'nthreads' threads (the calling thread plus nthreads - 1 worker
+threads). The calling thread sends each ciphertext with network_send_function as soon as it and the
+ciphertexts of every previous prime are ready, so the bytes sent are identical to those sent by
+se_encrypt_batch_seeded (symmetric) or se_encrypt_seeded (asymmetric) for the same seeds.
+
+Note: This function calls calloc and creates threads on every call. See: se_prime_tasks_alloc for
+the additional memory used.
+
+@param[in] shareable_seed         [Optional]. Seed for the shareable prng
+@param[in] seed                   [Optional]. Seed for the (non-shareable) prng
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] v                      Values to encode
+@param[in] vlen_bytes             Number of bytes in v
+@param[in] nthreads               Number of threads (including the calling thread). Values larger
+                                  than the number of primes are reduced to the number of primes.
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_parallel_seeded(uint8_t *shareable_seed, uint8_t *seed,
+                                SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                                size_t nthreads, SE_PARMS *se_parms);
+
+/**
+Encodes and encrypts a vector of values, encrypting w.r.t. each prime on a separate thread. See:
+se_encrypt_parallel_seeded.
+
+Note: This function calls calloc and creates threads on every call.
+
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] v                      Values to encode
+@param[in] vlen_bytes             Number of bytes in v
+@param[in] nthreads               Number of threads (including the calling thread)
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_parallel(SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                         size_t nthreads, SE_PARMS *se_parms);
+
+/**
+Encodes and encrypts a batch of value vectors with a two-stage pipeline (see: SE_PIPELINE). A worker
+thread runs the encode stage for each vector while the calling thread runs the encrypt stage and
+sends each ciphertext with network_send_function, so vector k + 1 is encoded while vector k is
+encrypted. The bytes sent are identical to those sent by se_encrypt_batch_seeded for the same seeds.
+
+This is the reference implementation of the pipeline for shared-memory multi-core targets: when a
+stage has to wait for the other, it yields the processor. A port to a target without pthreads would
+instead run each stage on its own core and, e.g., wait for an inter-core event.
+
+Note: This function calls calloc and creates a thread on every call. See: se_pipeline_alloc for the
+additional memory used.
+
+Size req: If seeds are !NULL, shareable_seeds and seeds must contain count * SE_PRNG_SEED_BYTE_COUNT
+bytes (one seed per vector).
+
+@param[in] shareable_seeds        [Optional]. Seeds for the shareable prng, one per vector
+@param[in] seeds                  [Optional]. Seeds for the (non-shareable) prng, one per vector
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] vecs                   Array of 'count' pointers to value vectors
+@param[in] count                  Number of vectors in vecs
+@param[in] vlen_bytes             Number of bytes in each vector of vecs
+@param[in] nslots                 Number of slots of the pipeline (at least 1). 2 is enough to keep
+                                  both stages busy if they take about the same time.
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_pipelined_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                                 SEND_FNCT_PTR network_send_function, const void **vecs,
+                                 size_t count, size_t vlen_bytes, size_t nslots,
+                                 SE_PARMS *se_parms);
+
+/**
+Encodes and encrypts a batch of value vectors with a two-stage pipeline. See:
+se_encrypt_pipelined_seeded.
+
+Note: This function calls calloc and creates a thread on every call.
+
+@param[in] network_send_function  [Optional]. Function to send each ciphertext component
+@param[in] vecs                   Array of 'count' pointers to value vectors
+@param[in] count                  Number of vectors in vecs
+@param[in] vlen_bytes             Number of bytes in each vector of vecs
+@param[in] nslots                 Number of slots of the pipeline (at least 1)
+@param[in] se_parms               SE_PARMS instance
+@returns                          1 on success, 0 on failure
+*/
+bool se_encrypt_pipelined(SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                          size_t vlen_bytes, size_t nslots, SE_PARMS *se_parms);
+#endif
+#endif
+
 /**
-Frees some library memory and resets parameters object. Should never need to be called by the
-typical user.
+Frees some library memory and resets parameters object. If the instance was returned by one of the
+se_setup* functions with SE_USE_MALLOC defined, also frees the memory pool and the instance itself.
+Should never need to be called by the typical user.
 
 @param[in] se_parms  SE_PARMS instance to free
 */
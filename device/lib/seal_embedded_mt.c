@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file seal_embedded_mt.c
+
+pthreads backends for the per-prime encryption tasks (see: SE_PRIME_TASK) and the encode-encrypt
+pipeline (see: SE_PIPELINE) of seal_embedded.h.
+*/
+
+#include "defines.h"
+
+#ifdef SE_USE_PTHREADS
+#include <pthread.h>
+#include <sched.h>  // sched_yield
+
+#include "seal_embedded.h"
+
+/**
+State shared by the threads of a call to se_encrypt_parallel_seeded. 'next' and 'done' are
+protected by 'lock'.
+
+@param tasks  Set of tasks to run
+@param lock   Mutex protecting 'next' and 'done'
+@param cond   Signaled whenever a task finishes
+@param next   Index of the next task that has not been claimed by any thread
+@param done   done[i] is set to 1 once task i has finished running
+*/
+typedef struct
+{
+    SE_PRIME_TASKS *tasks;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    size_t next;
+    bool *done;
+} SE_PARALLEL_STATE;
+
+/**
+Helper function to claim and run the next unclaimed task.
+
+@param[in,out] state  Shared state
+@returns              1 if a task was run, 0 if all tasks were already claimed
+*/
+static bool se_parallel_run_next(SE_PARALLEL_STATE *state)
+{
+    pthread_mutex_lock(&(state->lock));
+    size_t i = state->next;
+    if (i < state->tasks->ntasks) state->next++;
+    pthread_mutex_unlock(&(state->lock));
+    if (i >= state->tasks->ntasks) return false;
+
+    se_prime_task_run(&(state->tasks->tasks[i]));
+
+    pthread_mutex_lock(&(state->lock));
+    state->done[i] = 1;
+    pthread_cond_broadcast(&(state->cond));
+    pthread_mutex_unlock(&(state->lock));
+    return true;
+}
+
+/**
+Worker thread entry point. Runs tasks until all of them have been claimed.
+
+@param[in,out] arg  Shared state (SE_PARALLEL_STATE)
+*/
+static void *se_parallel_worker(void *arg)
+{
+    while (se_parallel_run_next((SE_PARALLEL_STATE *)arg))
+        ;
+    return NULL;
+}
+
+bool se_encrypt_parallel_seeded(uint8_t *shareable_seed, uint8_t *seed,
+                                SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                                size_t nthreads, SE_PARMS *se_parms)
+{
+    se_assert(se_parms && se_parms->parms);
+    se_assert(nthreads);
+    size_t nprimes = se_parms->parms->nprimes;
+    if (nthreads > nprimes) nthreads = nprimes;
+    if (!nthreads) nthreads = 1;
+
+    SE_PRIME_TASKS tasks;
+    if (!se_prime_tasks_alloc(se_parms, &tasks)) return false;
+    bool *done         = calloc(nprimes, sizeof(bool));
+    pthread_t *threads = calloc(nthreads, sizeof(pthread_t));
+    se_assert(done && threads);
+    bool ret = done && threads;
+    if (ret)
+    {
+        ret = se_prime_tasks_setup(shareable_seed, seed, network_send_function, v, vlen_bytes,
+                                   se_parms, &tasks);
+    }
+    if (!ret)
+    {
+        if (threads) free(threads);
+        if (done) free(done);
+        se_prime_tasks_free(&tasks);
+        return false;
+    }
+
+    SE_PARALLEL_STATE state;
+    state.tasks = &tasks;
+    state.next  = 0;
+    state.done  = done;
+    pthread_mutex_init(&(state.lock), NULL);
+    pthread_cond_init(&(state.cond), NULL);
+
+    // -- The calling thread is one of the nthreads threads. If a thread cannot be created, the
+    //    remaining threads (at least the calling thread) run its share of the tasks.
+    size_t nworkers = 0;
+    for (size_t t = 1; t < nthreads; t++)
+    {
+        if (pthread_create(&(threads[nworkers]), NULL, &se_parallel_worker, &state)) break;
+        nworkers++;
+    }
+
+    // -- Send the ciphertexts in order of the primes. While the next ciphertext to send is not
+    //    ready, the calling thread runs unclaimed tasks (or waits if there are none left).
+    for (size_t i = 0; i < nprimes; i++)
+    {
+        pthread_mutex_lock(&(state.lock));
+        while (!state.done[i])
+        {
+            if (state.next < nprimes)
+            {
+                pthread_mutex_unlock(&(state.lock));
+                se_parallel_run_next(&state);
+                pthread_mutex_lock(&(state.lock));
+            }
+            else
+                pthread_cond_wait(&(state.cond), &(state.lock));
+        }
+        pthread_mutex_unlock(&(state.lock));
+
+        if (network_send_function) se_prime_task_send(network_send_function, &(tasks.tasks[i]));
+    }
+
+    for (size_t t = 0; t < nworkers; t++) pthread_join(threads[t], NULL);
+    pthread_cond_destroy(&(state.cond));
+    pthread_mutex_destroy(&(state.lock));
+    free(threads);
+    free(done);
+    se_prime_tasks_free(&tasks);
+    return true;
+}
+
+bool se_encrypt_parallel(SEND_FNCT_PTR network_send_function, void *v, size_t vlen_bytes,
+                         size_t nthreads, SE_PARMS *se_parms)
+{
+    return se_encrypt_parallel_seeded(NULL, NULL, network_send_function, v, vlen_bytes, nthreads,
+                                      se_parms);
+}
+
+/**
+State of the encode stage thread of se_encrypt_pipelined_seeded.
+
+@param pipe             Pipeline
+@param shareable_seeds  [Optional]. Seeds for the shareable prng, one per vector
+@param seeds            [Optional]. Seeds for the (non-shareable) prng, one per vector
+@param vecs             Array of 'count' pointers to value vectors
+@param count            Number of vectors in vecs
+@param vlen_bytes       Number of bytes in each vector of vecs
+@param failed           Set to 1 (with release ordering) if encoding a vector failed
+*/
+typedef struct
+{
+    SE_PIPELINE *pipe;
+    uint8_t *shareable_seeds;
+    uint8_t *seeds;
+    const void **vecs;
+    size_t count;
+    size_t vlen_bytes;
+    bool failed;
+} SE_PIPELINE_ENCODER;
+
+/**
+Encode stage thread entry point. Encodes every vector into the pipeline, yielding while all slots
+are in use.
+
+@param[in,out] arg  Encode stage state (SE_PIPELINE_ENCODER)
+*/
+static void *se_pipeline_encode_worker(void *arg)
+{
+    SE_PIPELINE_ENCODER *encoder = (SE_PIPELINE_ENCODER *)arg;
+    for (size_t b = 0; b < encoder->count; b++)
+    {
+        while (!se_pipeline_can_encode(encoder->pipe)) sched_yield();
+
+        uint8_t *share_seed =
+            encoder->shareable_seeds ? &(encoder->shareable_seeds[b * SE_PRNG_SEED_BYTE_COUNT]) : 0;
+        uint8_t *seed = encoder->seeds ? &(encoder->seeds[b * SE_PRNG_SEED_BYTE_COUNT]) : 0;
+        if (!se_pipeline_encode(share_seed, seed, (void *)encoder->vecs[b], encoder->vlen_bytes,
+                                encoder->pipe))
+        {
+            __atomic_store_n(&(encoder->failed), 1, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+    return NULL;
+}
+
+bool se_encrypt_pipelined_seeded(uint8_t *shareable_seeds, uint8_t *seeds,
+                                 SEND_FNCT_PTR network_send_function, const void **vecs,
+                                 size_t count, size_t vlen_bytes, size_t nslots,
+                                 SE_PARMS *se_parms)
+{
+    se_assert(se_parms && (vecs || !count));
+    SE_PIPELINE pipe;
+    if (!se_pipeline_alloc(se_parms, nslots, &pipe)) return false;
+
+    SE_PIPELINE_ENCODER encoder;
+    encoder.pipe            = &pipe;
+    encoder.shareable_seeds = shareable_seeds;
+    encoder.seeds           = seeds;
+    encoder.vecs            = vecs;
+    encoder.count           = count;
+    encoder.vlen_bytes      = vlen_bytes;
+    encoder.failed          = 0;
+
+    pthread_t encode_thread;
+    if (pthread_create(&encode_thread, NULL, &se_pipeline_encode_worker, &encoder))
+    {
+        se_pipeline_free(&pipe);
+        return false;
+    }
+
+    // -- Encrypt stage. Stops at the first vector the encode stage failed to encode. (Vectors
+    //    encoded before the failure may have been published after the ring was last checked.)
+    bool ret = true;
+    for (size_t b = 0; b < count && ret; b++)
+    {
+        while (!se_pipeline_can_encrypt(&pipe))
+        {
+            if (__atomic_load_n(&(encoder.failed), __ATOMIC_ACQUIRE) &&
+                !se_pipeline_can_encrypt(&pipe))
+            {
+                ret = false;
+                break;
+            }
+            sched_yield();
+        }
+        if (ret) se_pipeline_encrypt(network_send_function, &pipe);
+    }
+
+    pthread_join(encode_thread, NULL);
+    se_pipeline_free(&pipe);
+    return ret && !encoder.failed;
+}
+
+bool se_encrypt_pipelined(SEND_FNCT_PTR network_send_function, const void **vecs, size_t count,
+                          size_t vlen_bytes, size_t nslots, SE_PARMS *se_parms)
+{
+    return se_encrypt_pipelined_seeded(NULL, NULL, network_send_function, vecs, count, vlen_bytes,
+                                       nslots, se_parms);
+}
+#endif
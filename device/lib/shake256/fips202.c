@@ -27,13 +27,14 @@ as `Microsoft SEAL edit: ...`.
 
 /* Microsoft SEAL edit: moved the rate macros here from Kyber header fips202.h
  */
-#define SHAKE256_RATE 136
+/* Microsoft SEAL-Embedded edit: moved the rate macro and shake256ctx to fips202.h */
 
-// Context for non-incremental API
-typedef struct
-{
-    uint64_t ctx[25];
-} shake256ctx;
+#ifdef SE_ENABLE_TIMERS
+_Thread_local uint64_t se_keccak_permutation_count = 0;
+#define KECCAK_COUNT_PERMUTATION() se_keccak_permutation_count++
+#else
+#define KECCAK_COUNT_PERMUTATION()
+#endif
 
 /*************************************************
  * Name:        keccak_absorb
@@ -57,6 +58,7 @@ static void keccak_absorb(uint64_t *s, uint32_t r, const uint8_t *m, size_t mlen
     {
         KeccakF1600_StateXORBytes(s, m, 0, r);
         KeccakF1600_StatePermute(s);
+        KECCAK_COUNT_PERMUTATION();
         mlen -= r;
         m += r;
     }
@@ -86,6 +88,7 @@ static void keccak_squeezeblocks(uint8_t *h, size_t nblocks, uint64_t *s, uint32
     while (nblocks > 0)
     {
         KeccakF1600_StatePermute(s);
+        KECCAK_COUNT_PERMUTATION();
         KeccakF1600_StateExtractBytes(s, h, 0, r);
         h += r;
         nblocks--;
@@ -126,3 +129,39 @@ void shake256(uint8_t *output, size_t outlen, const uint8_t *input, size_t inlen
         for (i = 0; i < outlen; i++) output[i] = t[i];
     }
 }
+
+/* Microsoft SEAL-Embedded edit: added shake256_absorb and shake256_squeezeblocks from the Kyber
+ * non-incremental API, so that output can be squeezed from a SHAKE256 state on demand */
+
+/*************************************************
+ * Name:        shake256_absorb
+ *
+ * Description: Absorb step of the SHAKE256 XOF.
+ *              non-incremental, starts by zeroeing the state.
+ *
+ * Arguments:   - shake256ctx *state:   pointer to (uninitialized) output Keccak state
+ *              - const uint8_t *input: pointer to input to be absorbed into state
+ *              - size_t inlen:         length of input in bytes
+ **************************************************/
+void shake256_absorb(shake256ctx *state, const uint8_t *input, size_t inlen)
+{
+    size_t i;
+    for (i = 0; i < 25; ++i) { state->ctx[i] = 0; }
+    keccak_absorb((uint64_t *)state->ctx, SHAKE256_RATE, input, inlen, 0x1F);
+}
+
+/*************************************************
+ * Name:        shake256_squeezeblocks
+ *
+ * Description: Squeeze step of SHAKE256 XOF. Squeezes full blocks of
+ *              SHAKE256_RATE bytes each. Modifies the state. Can be called
+ *              multiple times to keep squeezing, i.e., is incremental.
+ *
+ * Arguments:   - uint8_t *output:     pointer to output blocks
+ *              - size_t nblocks:      number of blocks to be squeezed (written to output)
+ *              - shake256ctx *state:  pointer to input/output Keccak state
+ **************************************************/
+void shake256_squeezeblocks(uint8_t *output, size_t nblocks, shake256ctx *state)
+{
+    keccak_squeezeblocks(output, nblocks, (uint64_t *)state->ctx, SHAKE256_RATE);
+}
@@ -11,4 +11,24 @@ Origin: Microsoft SEAL library (https://github.com/microsoft/SEAL) commit
 #include <stddef.h>
 #include <stdint.h>
 
+/* Microsoft SEAL-Embedded edit: added the incremental squeeze API below (see: SE_PRNG_STREAM) */
+#include "defines.h"
+
+#define SHAKE256_RATE 136
+
+// Context for non-incremental API
+typedef struct
+{
+    uint64_t ctx[25];
+} shake256ctx;
+
+#ifdef SE_ENABLE_TIMERS
+// Number of Keccak-f[1600] permutations computed so far by the calling thread (for benchmarks only)
+extern _Thread_local uint64_t se_keccak_permutation_count;
+#endif
+
 void shake256(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen);
+
+void shake256_absorb(shake256ctx *state, const uint8_t *in, size_t inlen);
+
+void shake256_squeezeblocks(uint8_t *out, size_t nblocks, shake256ctx *state);
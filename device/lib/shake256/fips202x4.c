@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file fips202x4.c
+
+4-way SHAKE256 (see: shake256x4). Follows the absorb and squeeze steps of shake256 in fips202.c
+exactly, on 4 interleaved Keccak states.
+*/
+
+#include "shake256/fips202x4.h"
+
+#include <string.h>  // memcpy
+
+#include "cpu_features.h"
+#include "defines.h"
+#include "shake256/fips202.h"
+#include "shake256/keccakf1600x4.h"
+
+#ifdef SE_KECCAK_X4_AVX2
+/**
+XORs 'len' bytes of each of the 4 inputs (starting at byte offset 'off' of each) into the first
+'len' bytes of the corresponding state. Assumes len is a multiple of 8 (i.e., whole words).
+*/
+static inline SE_TARGET_KECCAK_X4 void keccak_x4_xor_words(keccak_x4_lane *s, const uint8_t *in[4],
+                                                           size_t off, size_t len)
+{
+    for (size_t w = 0; w < len / 8; w++)
+    {
+        uint64_t x[4];
+        for (size_t l = 0; l < 4; l++) memcpy(&(x[l]), &(in[l][off + 8 * w]), 8);
+        s[w] ^= (keccak_x4_lane){x[0], x[1], x[2], x[3]};
+    }
+}
+
+/**
+Copies the first 'len' bytes of each of the 4 states to the corresponding output (starting at byte
+offset 'off' of each).
+*/
+static inline SE_TARGET_KECCAK_X4 void keccak_x4_extract(const keccak_x4_lane *s, uint8_t *out[4],
+                                                         size_t off, size_t len)
+{
+    for (size_t l = 0; l < 4; l++)
+    {
+        size_t w = 0;
+        for (; w < len / 8; w++)
+        {
+            uint64_t x = s[w][l];
+            memcpy(&(out[l][off + 8 * w]), &x, 8);
+        }
+        for (size_t i = 8 * w; i < len; i++)
+        { out[l][off + i] = (uint8_t)(s[i / 8][l] >> (8 * (i % 8))); }
+    }
+}
+
+/**
+AVX2 implementation of shake256x4. Note: Assumes a little-endian host (i.e., x86-64).
+*/
+static SE_TARGET_KECCAK_X4 void shake256x4_avx2(uint8_t *out[4], size_t outlen,
+                                               const uint8_t *in[4], size_t inlen)
+{
+    keccak_x4_lane s[25];
+    for (size_t i = 0; i < 25; i++) s[i] = (keccak_x4_lane){0, 0, 0, 0};
+
+    // -- Absorb full blocks (see: keccak_absorb)
+    size_t off = 0;
+    for (; inlen - off >= SHAKE256_RATE; off += SHAKE256_RATE)
+    {
+        keccak_x4_xor_words(s, in, off, SHAKE256_RATE);
+        KeccakF1600_StatePermute4x(s);
+#ifdef SE_ENABLE_TIMERS
+        se_keccak_permutation_count += 4;
+#endif
+    }
+
+    // -- Absorb the padded last block
+    uint8_t t[4][SHAKE256_RATE];
+    const uint8_t *t_ptrs[4];
+    size_t mlen = inlen - off;
+    for (size_t l = 0; l < 4; l++)
+    {
+        memset(t[l], 0, SHAKE256_RATE);
+        memcpy(t[l], &(in[l][off]), mlen);
+        t[l][mlen] = 0x1F;
+        t[l][SHAKE256_RATE - 1] |= 128;
+        t_ptrs[l] = t[l];
+    }
+    keccak_x4_xor_words(s, t_ptrs, 0, SHAKE256_RATE);
+
+    // -- Squeeze (see: keccak_squeezeblocks)
+    for (off = 0; off < outlen; off += SHAKE256_RATE)
+    {
+        size_t len = outlen - off;
+        if (len > SHAKE256_RATE) len = SHAKE256_RATE;
+        KeccakF1600_StatePermute4x(s);
+#ifdef SE_ENABLE_TIMERS
+        se_keccak_permutation_count += 4;
+#endif
+        keccak_x4_extract(s, out, off, len);
+    }
+}
+#endif
+
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen)
+{
+#ifdef SE_KECCAK_X4_AVX2
+    if (se_cpu_has_avx2())
+    {
+        uint8_t *out[4]      = {out0, out1, out2, out3};
+        const uint8_t *in[4] = {in0, in1, in2, in3};
+        shake256x4_avx2(out, outlen, in, inlen);
+        return;
+    }
+#endif
+    shake256(out0, outlen, in0, inlen);
+    shake256(out1, outlen, in1, inlen);
+    shake256(out2, outlen, in2, inlen);
+    shake256(out3, outlen, in3, inlen);
+}
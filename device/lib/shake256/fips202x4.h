@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file fips202x4.h
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+Computes 4 independent SHAKE256 outputs of the same length from 4 inputs of the same length. The
+output is identical to calling shake256 on each input in turn. If SE_KECCAK_X4_AVX2 is defined
+and the CPU supports AVX2 (checked at runtime), the 4 Keccak states are computed in parallel.
+Otherwise, falls back to 4 calls to shake256.
+
+@param[out] out0    Output for in0 (outlen bytes)
+@param[out] out1    Output for in1 (outlen bytes)
+@param[out] out2    Output for in2 (outlen bytes)
+@param[out] out3    Output for in3 (outlen bytes)
+@param[in]  outlen  Number of output bytes per input
+@param[in]  in0     Input 0 (inlen bytes)
+@param[in]  in1     Input 1 (inlen bytes)
+@param[in]  in2     Input 2 (inlen bytes)
+@param[in]  in3     Input 3 (inlen bytes)
+@param[in]  inlen   Number of bytes per input
+*/
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3, size_t outlen,
+                const uint8_t *in0, const uint8_t *in1, const uint8_t *in2, const uint8_t *in3,
+                size_t inlen);
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file keccakf1600x4.h
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "defines.h"
+
+#ifdef SE_KECCAK_X4_AVX2
+#define SE_TARGET_KECCAK_X4 __attribute__((target("avx2")))
+
+/**
+A word of 4 interleaved Keccak states (i.e., word i of state 0, 1, 2, and 3).
+*/
+typedef uint64_t keccak_x4_lane __attribute__((vector_size(32)));
+
+/**
+Applies the Keccak-f[1600] permutation to 4 independent states at once. Requires that the CPU
+supports AVX2 (see: shake256x4).
+
+@param[in,out] state  4 interleaved Keccak states (25 keccak_x4_lane words)
+*/
+SE_TARGET_KECCAK_X4 void KeccakF1600_StatePermute4x(keccak_x4_lane *state);
+#endif
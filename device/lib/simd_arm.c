@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file simd_arm.c
+
+NEON (e.g., Cortex-A7) and Helium / MVE (e.g., Cortex-M55) implementations of the "fast" NTT and of
+the polynomial arithmetic in polymodarith.h. Only compiled if SE_USE_SIMD_ARM is defined (see:
+user_defines.h). The instruction set is selected at build time from the target's compile flags
+(see: SE_SIMD_ARM in defines.h). Both instruction sets provide 4 x 32-bit
+lanes and share most intrinsic names, so the kernels are written once on top of a few helpers.
+
+Every kernel produces output that is bit-identical to the scalar implementation, so the scalar
+functions can be used as a reference (see: ntt_tests.c).
+*/
+
+#include "defines.h"
+
+#ifdef SE_SIMD_ARM
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#else
+#include <arm_mve.h>
+#endif
+
+#include "ntt_simd.h"
+#include "parameters.h"
+#include "polymodarith.h"
+#include "uintmodarith.h"
+
+// ==============================================================================
+//                                  Helpers
+// ==============================================================================
+
+/**
+Returns the high 32 bits of the 32 x 32-bit product of each pair of lanes (see: mul_uint32_high).
+*/
+static inline uint32x4_t mul_uint_high_arm(uint32x4_t a, uint32x4_t b)
+{
+#ifdef __ARM_NEON
+    uint64x2_t lo = vmull_u32(vget_low_u32(a), vget_low_u32(b));
+    uint64x2_t hi = vmull_u32(vget_high_u32(a), vget_high_u32(b));
+    return vcombine_u32(vshrn_n_u64(lo, 32), vshrn_n_u64(hi, 32));
+#else
+    return vmulhq_u32(a, b);
+#endif
+}
+
+/**
+Returns 1 in each lane where the addition 'sum' = 'a' + (something) generated a carry, else 0 (see:
+add_uint32).
+*/
+static inline uint32x4_t carry_arm(uint32x4_t sum, uint32x4_t a)
+{
+#ifdef __ARM_NEON
+    return vshrq_n_u32(vcltq_u32(sum, a), 31);
+#else
+    return vpselq_u32(vdupq_n_u32(1), vdupq_n_u32(0), vcmphiq_u32(a, sum));
+#endif
+}
+
+/**
+Constant-time shift of each lane from [0, 2q) to [0, q) (see: shift_result). If x < q, x - q wraps
+around to a value larger than x, so the minimum is always the correct result. Requires q < 2^31.
+*/
+static inline uint32x4_t shift_result_arm(uint32x4_t x, uint32x4_t q)
+{
+    return vminq_u32(x, vsubq_u32(x, q));
+}
+
+/**
+Modular multiplication of each pair of lanes. Follows barrett_reduce_64input_32modulus exactly.
+
+@param[in] a    Operand 1 in each lane
+@param[in] b    Operand 2 in each lane
+@param[in] q    Modulus value (in every lane)
+@param[in] cr0  Low word of const_ratio (in every lane)
+@param[in] cr1  High word of const_ratio (in every lane)
+@returns        (a * b) mod q in each lane
+*/
+static inline uint32x4_t mul_mod_arm(uint32x4_t a, uint32x4_t b, uint32x4_t q, uint32x4_t cr0,
+                                     uint32x4_t cr1)
+{
+    // -- input = a * b
+    uint32x4_t in_lw = vmulq_u32(a, b);
+    uint32x4_t in_hw = mul_uint_high_arm(a, b);
+
+    // -- Round 1
+    uint32x4_t right_hw  = mul_uint_high_arm(in_lw, cr0);
+    uint32x4_t middle_lw = vaddq_u32(vmulq_u32(in_lw, cr1), right_hw);
+    uint32x4_t middle_hw =
+        vaddq_u32(mul_uint_high_arm(in_lw, cr1), carry_arm(middle_lw, right_hw));
+
+    // -- Round 2
+    uint32x4_t middle2_temp_lw = vmulq_u32(in_hw, cr0);
+    uint32x4_t middle2_lw      = vaddq_u32(middle_lw, middle2_temp_lw);
+    uint32x4_t middle2_hw =
+        vaddq_u32(mul_uint_high_arm(in_hw, cr0), carry_arm(middle2_lw, middle_lw));
+
+    uint32x4_t tmp = vaddq_u32(vaddq_u32(vmulq_u32(in_hw, cr1), middle_hw), middle2_hw);
+
+    // -- Barrett subtraction
+    tmp = vsubq_u32(in_lw, vmulq_u32(tmp, q));
+    return shift_result_arm(tmp, q);
+}
+
+// ==============================================================================
+//                            Polynomial arithmetic
+// ==============================================================================
+
+void poly_add_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod, ZZ *res)
+{
+    uint32x4_t q   = vdupq_n_u32(mod->value);
+    PolySizeType i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t sum = vaddq_u32(vld1q_u32(&(p1[i])), vld1q_u32(&(p2[i])));
+        vst1q_u32(&(res[i]), shift_result_arm(sum, q));
+    }
+    for (; i < n; i++) { res[i] = add_mod(p1[i], p2[i], mod); }
+}
+
+void poly_neg_mod_arm(const ZZ *p1, PolySizeType n, const Modulus *mod, ZZ *res)
+{
+    // -- (q - x) is correct unless x == 0, in which case (0 - x) = 0 is smaller
+    uint32x4_t q    = vdupq_n_u32(mod->value);
+    uint32x4_t zero = vdupq_n_u32(0);
+    PolySizeType i  = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t x = vld1q_u32(&(p1[i]));
+        vst1q_u32(&(res[i]), vminq_u32(vsubq_u32(q, x), vsubq_u32(zero, x)));
+    }
+    for (; i < n; i++) { res[i] = neg_mod(p1[i], mod); }
+}
+
+void poly_pointwise_mul_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod,
+                                ZZ *res)
+{
+    uint32x4_t q   = vdupq_n_u32(mod->value);
+    uint32x4_t cr0 = vdupq_n_u32(mod->const_ratio[0]);
+    uint32x4_t cr1 = vdupq_n_u32(mod->const_ratio[1]);
+    PolySizeType i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t prod = mul_mod_arm(vld1q_u32(&(p1[i])), vld1q_u32(&(p2[i])), q, cr0, cr1);
+        vst1q_u32(&(res[i]), prod);
+    }
+    for (; i < n; i++) { res[i] = mul_mod(p1[i], p2[i], mod); }
+}
+
+void poly_pointwise_mul_mod_pair_arm(const ZZ *p1a, const ZZ *p1b, const ZZ *p2, PolySizeType n,
+                                     const Modulus *mod, ZZ *res_a, ZZ *res_b)
+{
+    uint32x4_t q   = vdupq_n_u32(mod->value);
+    uint32x4_t cr0 = vdupq_n_u32(mod->const_ratio[0]);
+    uint32x4_t cr1 = vdupq_n_u32(mod->const_ratio[1]);
+    PolySizeType i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t val    = vld1q_u32(&(p2[i]));
+        uint32x4_t prod_a = mul_mod_arm(vld1q_u32(&(p1a[i])), val, q, cr0, cr1);
+        uint32x4_t prod_b = mul_mod_arm(vld1q_u32(&(p1b[i])), val, q, cr0, cr1);
+        vst1q_u32(&(res_a[i]), prod_a);
+        vst1q_u32(&(res_b[i]), prod_b);
+    }
+    for (; i < n; i++)
+    {
+        ZZ val   = p2[i];
+        res_a[i] = mul_mod(p1a[i], val, mod);
+        res_b[i] = mul_mod(p1b[i], val, mod);
+    }
+}
+
+void poly_mul_neg_mod_arm(const ZZ *p1, const ZZ *p2, PolySizeType n, const Modulus *mod, ZZ *res)
+{
+    uint32x4_t q    = vdupq_n_u32(mod->value);
+    uint32x4_t zero = vdupq_n_u32(0);
+    uint32x4_t cr0  = vdupq_n_u32(mod->const_ratio[0]);
+    uint32x4_t cr1  = vdupq_n_u32(mod->const_ratio[1]);
+    PolySizeType i  = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t prod = mul_mod_arm(vld1q_u32(&(p1[i])), vld1q_u32(&(p2[i])), q, cr0, cr1);
+        vst1q_u32(&(res[i]), vminq_u32(vsubq_u32(q, prod), vsubq_u32(zero, prod)));
+    }
+    for (; i < n; i++) { res[i] = neg_mod(mul_mod(p1[i], p2[i], mod), mod); }
+}
+
+void poly_mul_neg_add_mod_arm(const ZZ *p1, const ZZ *p2, const ZZ *p3, PolySizeType n,
+                              const Modulus *mod, ZZ *res)
+{
+    uint32x4_t q     = vdupq_n_u32(mod->value);
+    uint32x4_t two_q = vdupq_n_u32(mod->value << 1);
+    uint32x4_t cr0   = vdupq_n_u32(mod->const_ratio[0]);
+    uint32x4_t cr1   = vdupq_n_u32(mod->const_ratio[1]);
+    PolySizeType i   = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t prod = mul_mod_arm(vld1q_u32(&(p1[i])), vld1q_u32(&(p2[i])), q, cr0, cr1);
+
+        // -- Reduce p3 from [0, 4q) to [0, q), then compute (p3 + (q - prod)) mod q
+        uint32x4_t val = vld1q_u32(&(p3[i]));
+        val            = shift_result_arm(vminq_u32(val, vsubq_u32(val, two_q)), q);
+        vst1q_u32(&(res[i]), shift_result_arm(vaddq_u32(val, vsubq_u32(q, prod)), q));
+    }
+    for (; i < n; i++)
+    { res[i] = sub_mod(reduce_lazy_4q(p3[i], mod->value), mul_mod(p1[i], p2[i], mod), mod); }
+}
+
+// ==============================================================================
+//                                     NTT
+// ==============================================================================
+
+#ifdef SE_NTT_SIMD_ARM
+void ntt_fast_arm_inpl(const Parms *parms, const MUMO *ntt_fast_roots, ZZ *vec)
+{
+    se_assert(parms && parms->curr_modulus && ntt_fast_roots && vec);
+    size_t n     = parms->coeff_count;
+    Modulus *mod = parms->curr_modulus;
+    ZZ two_q_val = mod->value << 1;
+
+    uint32x4_t q     = vdupq_n_u32(mod->value);
+    uint32x4_t two_q = vdupq_n_u32(two_q_val);
+
+    size_t h  = 1;
+    size_t tt = n / 2;
+
+    // -- Vectorized rounds: each group shares one root, so broadcast it across lanes.
+    //    This is the Harvey butterfly from ntt_lazy_inpl. Assume x, y in [0, 4q).
+    for (; tt >= 4; h *= 2, tt /= 2)
+    {
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)
+        {
+            const MUMO *s = &(ntt_fast_roots[h + j]);
+            uint32x4_t w  = vdupq_n_u32(s->operand);
+            uint32x4_t wq = vdupq_n_u32(s->quotient);
+
+            for (size_t k = kstart; k < (kstart + tt); k += 4)
+            {
+                uint32x4_t x = vld1q_u32(&(vec[k]));
+                uint32x4_t y = vld1q_u32(&(vec[k + tt]));
+
+                uint32x4_t u  = vminq_u32(x, vsubq_u32(x, two_q));
+                uint32x4_t hi = mul_uint_high_arm(y, wq);
+                uint32x4_t v  = vsubq_u32(vmulq_u32(y, w), vmulq_u32(hi, q));
+
+                vst1q_u32(&(vec[k]), vaddq_u32(u, v));
+                vst1q_u32(&(vec[k + tt]), vsubq_u32(vaddq_u32(u, two_q), v));
+            }
+        }
+    }
+
+    // -- Remaining rounds (tt = 2, 1) have fewer butterflies per root than lanes
+    for (; tt >= 1; h *= 2, tt /= 2)
+    {
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)
+        {
+            const MUMO *s = &(ntt_fast_roots[h + j]);
+            for (size_t k = kstart; k < (kstart + tt); k++)
+            {
+                ZZ val1 = vec[k];
+                ZZ val2 = vec[k + tt];
+
+                ZZ u = val1 - (two_q_val & (ZZ)(-(ZZsign)(val1 >= two_q_val)));
+                ZZ v = mul_mod_mumo_lazy(val2, s, mod);
+
+                vec[k]      = u + v;
+                vec[k + tt] = u + two_q_val - v;
+            }
+        }
+    }
+
+    // -- Final reduction from [0, 4q) to [0, q)
+    for (size_t i = 0; i < n; i += 4)
+    {
+        uint32x4_t x = vld1q_u32(&(vec[i]));
+        x            = vminq_u32(x, vsubq_u32(x, two_q));
+        vst1q_u32(&(vec[i]), shift_result_arm(x, q));
+    }
+}
+#endif
+#endif
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/**
+@file spsc_ring.h
+
+Lock-free single-producer/single-consumer ring of slot indices. The ring only hands out indices into
+a caller-owned array of 'nslots' slots: the producer fills the slot returned by
+spsc_ring_write_slot and publishes it with spsc_ring_push, and the consumer reads the slot returned
+by spsc_ring_read_slot and releases it with spsc_ring_pop. Exactly one thread (or core) may act as
+the producer and exactly one as the consumer. Neither side ever blocks, so the caller decides how to
+wait when the ring is full or empty (e.g., yield, WFE, or an inter-core mailbox interrupt).
+
+The counters are only ever written by one side and read with acquire/release ordering (GCC/clang
+__atomic builtins), so slot contents written before spsc_ring_push are visible to the consumer after
+spsc_ring_read_slot returns that slot, and likewise for spsc_ring_pop.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "defines.h"
+
+/**
+Single-producer/single-consumer ring state.
+
+@param head    Number of slots pushed so far (written by the producer only)
+@param tail    Number of slots popped so far (written by the consumer only)
+@param nslots  Number of slots
+*/
+typedef struct
+{
+    size_t head;
+    size_t tail;
+    size_t nslots;
+} SE_SPSC_RING;
+
+/**
+Initializes an empty ring.
+
+@param[out] ring    Ring to initialize
+@param[in]  nslots  Number of slots (at least 1)
+*/
+static inline void spsc_ring_init(SE_SPSC_RING *ring, size_t nslots)
+{
+    se_assert(ring && nslots);
+    ring->head   = 0;
+    ring->tail   = 0;
+    ring->nslots = nslots;
+}
+
+/**
+Producer only. Returns the index of the next slot to fill, if the ring is not full.
+
+@param[in]  ring  Ring
+@param[out] idx   Index of the slot to fill
+@returns          1 if a slot is free, 0 if the ring is full
+*/
+static inline bool spsc_ring_write_slot(SE_SPSC_RING *ring, size_t *idx)
+{
+    size_t head = ring->head;
+    size_t tail = __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE);
+    if (head - tail >= ring->nslots) return false;
+    *idx = head % ring->nslots;
+    return true;
+}
+
+/**
+Producer only. Publishes the slot returned by the last call to spsc_ring_write_slot.
+
+@param[in,out] ring  Ring
+*/
+static inline void spsc_ring_push(SE_SPSC_RING *ring)
+{
+    __atomic_store_n(&(ring->head), ring->head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+Consumer only. Returns the index of the oldest published slot, if the ring is not empty.
+
+@param[in]  ring  Ring
+@param[out] idx   Index of the slot to read
+@returns          1 if a slot is available, 0 if the ring is empty
+*/
+static inline bool spsc_ring_read_slot(SE_SPSC_RING *ring, size_t *idx)
+{
+    size_t tail = ring->tail;
+    size_t head = __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE);
+    if (head == tail) return false;
+    *idx = tail % ring->nslots;
+    return true;
+}
+
+/**
+Consumer only. Releases the slot returned by the last call to spsc_ring_read_slot back to the
+producer.
+
+@param[in,out] ring  Ring
+*/
+static inline void spsc_ring_pop(SE_SPSC_RING *ring)
+{
+    __atomic_store_n(&(ring->tail), ring->tail + 1, __ATOMIC_RELEASE);
+}
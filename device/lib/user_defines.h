@@ -49,6 +49,21 @@ to sample randomness using an A7 application and pass it to this library.
 */
 #define SE_RAND_TYPE 1
 
+/**
+PRNG type. Used to expand a seed into the uniform random polynomial 'a' (symmetric encryption) and
+into the samples of the error and ternary distributions.
+
+Note: The adapter (or server) must expand the seed of a seeded ciphertext with the same algorithm.
+The choice is identified by SE_PRNG_SEED_VERSION (see: defines.h), which is sent in front of the
+seed.
+
+0 = SHAKE256 (default, as in Microsoft SEAL)
+1 = AES-256 in counter mode. Uses AES-NI on x86-64 hosts if SE_USE_SIMD_PRNG is defined, otherwise
+    a portable constant-time (bitsliced) implementation. Fastest choice on cores with AES hardware.
+2 = ChaCha20. Constant-time and fast in software on cores without AES hardware (e.g., ARM M4).
+*/
+#define SE_PRNG_TYPE 0
+
 // ==============================================================================
 //                       Basic configurations: Memory
 //
@@ -67,6 +82,27 @@ Note: On the Sphere M4, will not work if this is non-otf for n = 4K and in Debug
 */
 #define SE_IFFT_TYPE 0
 
+/**
+Inverse FFT (i.e., encoder) precision.
+
+Note: Single precision requires SE_IFFT_TYPE to be 0 (compute "on-the-fly"). Otherwise, will be
+reset to 0 (double precision).
+
+Single precision error analysis: The IFFT of n slot values of magnitude at most V has outputs of
+magnitude at most n * V, which are computed with a relative error of about log2(n) * 2^-24. After
+the combined multiplication by scale / n, each plaintext coefficient is off by at most about
+log2(n) * 2^-24 * V * scale (e.g., 12 * 2^-24 * 2^25 * V = 24 * V for n = 4K and scale = 2^25).
+For any V >= 1, this is well above the 0.5 error from rounding alone, so it dominates the encoding
+error. Decoded values are therefore off by about log2(n) * 2^-24 * V in addition to the usual
+encryption error, i.e., ~1e-6 relative error for n = 4K.
+
+0 = double precision (double complex)
+1 = single precision (float complex). Halves the size of the encoder's complex buffer and avoids
+    double precision (usually soft-float) arithmetic on cores with only a single precision FPU
+    (e.g., ARM M4F).
+*/
+#define SE_IFFT_PRECISION_TYPE 0
+
 /**
 NTT type.
 
@@ -76,6 +112,8 @@ Note: On the Sphere M4, will not work if this is load-fast for n = 4K and in Deb
 1 = compute "one-shot"
 2 = load
 3 = load fast
+4 = load fast, merging 2 butterfly levels per pass over the polynomial (same roots as 3). Halves
+    the number of passes over memory, which helps on cores with small caches. Always scalar.
 */
 #define SE_NTT_TYPE 1
 
@@ -102,17 +140,20 @@ memory for better performance).
 0 = not persistent
 1 = persistent across primes
 2 = persistent
+3 = persistent, and also keep ntt(s) resident for every prime in the modulus chain
+    (uses an additional nprimes * n ZZ elements of memory)
 */
 #define SE_SK_TYPE 2
 
 /**
 Data load type. Load method for precomputed keys, roots, and index map.
 
-Note: On M4, this will be force set to 1.
+Note: On M4, this will be force set to 1 (unless it is set to 2).
 
 0 = from file                              (uses file I/O)
 1 = copy from headers into separate buffer (no file I/O)
-2 = load from code directly                (not supported)
+2 = read from code directly                (no file I/O, no copies: keys, roots, and index map
+                                            are read in place, so they take up no RAM)
 */
 #define SE_DATA_LOAD_TYPE 0
 
@@ -128,6 +169,37 @@ Uncomment to use.
 */
 #define SE_MEMPOOL_ALLOC_VALUES
 
+/**
+Keep both public key components for every prime resident in the memory pool (loaded once during
+setup) instead of loading them for every prime of every encode-encrypt sequence. Uses an additional
+2 * nprimes * n ZZ elements of memory. Ignored in symmetric mode, and if SE_DATA_LOAD_TYPE is 2
+(the public key is then read from code directly). Uncomment to use.
+*/
+// #define SE_PK_PERSISTENT
+
+/**
+Use SIMD kernels for the "fast" NTT (SE_NTT_TYPE 3) on x86-64 hosts, which selects AVX-512 or AVX2
+at runtime based on the CPU. Output is identical to the scalar implementation. Ignored on other
+platforms. Comment out to use the scalar NTT only.
+*/
+#define SE_USE_SIMD_NTT
+
+/**
+Use SIMD kernels for randomness generation on x86-64 hosts, selected at runtime based on the CPU.
+The PRNG computes 4 SHAKE256 outputs at once with AVX2 (see: prng_fill_buffer_x4), the AES-256-CTR
+PRNG uses AES-NI, and the uniform sampler uses AVX2. Output is identical to the scalar
+implementation. Ignored on other platforms. Comment out to use the scalar implementation only.
+*/
+#define SE_USE_SIMD_PRNG
+
+/**
+Use NEON or Helium (MVE) kernels for polynomial arithmetic and the "fast" NTT (SE_NTT_TYPE 3) on
+ARM targets compiled with either instruction set enabled. Output is identical to the scalar
+implementation. Experimental: verify the unit tests pass on the target (or under qemu-user, see:
+scripts/test_all_configs.sh) before use. Ignored on other platforms. Uncomment to use.
+*/
+// #define SE_USE_SIMD_ARM
+
 /**
 Uncomment to use predefine implementation for conj(), creal(), and cimag(). Otherwise,
 treats complex values as two doubles (a real part followed by an imaginary part).
@@ -140,6 +212,32 @@ Comment out to use stack allocation instead.
 */
 #define SE_USE_MALLOC
 
+/**
+Provide se_encrypt_parallel, which encrypts w.r.t. each prime of the modulus chain on a separate
+thread using pthreads (see: SE_PRIME_TASK). Ignored if SE_USE_MALLOC is not defined and on the M4
+targets. Comment out if pthreads is not available.
+*/
+#define SE_USE_PTHREADS
+
+/**
+Symmetric encryption only: Send the seed of the uniform random polynomial 'a' instead of c1 = a,
+which nearly halves the size of each ciphertext. Once per message, the library sends a header of
+SE_SEED_CT_HEADER_BYTE_COUNT bytes (see: defines.h), i.e., SE_PRNG_SEED_VERSION followed by the seed
+of the shareable prng. It then sends only c0 for each prime. The receiver regenerates c1 for the
+i-th prime sent (counting from 0) by expanding the seed with the prng counter set to i, in the same
+way as sample_poly_uniform. Unless SE_REVERSE_CT_GEN_ENABLED is defined, i is the prime's index in
+the modulus chain. Ignored in asymmetric mode. Uncomment to use.
+*/
+// #define SE_ENABLE_SYM_SEED_CT
+
+/**
+Pack each ciphertext component to the bit width of the current prime before sending it (e.g., 30
+instead of 32 bits per coefficient for the default primes), which saves 6-16% of each ciphertext.
+Packing works in place over c0 and c1 (see: pack.h for the format), so their values are no longer
+available after they are sent. Uncomment to use.
+*/
+// #define SE_ENABLE_PACKED_CT
+
 /**
 Optimization to generate prime components in reverse order every other time. Enables more
 optimal memory usage and performance. Will be ignored if IFFT type is "compute on-the-fly"
@@ -720,11 +720,14 @@ static inline void print_config(bool sym)
     const char *predef_cplx_str = " Using predef complex? :";
     const char *timers_str      = "       Timers enabled? :";
     const char *getrand_str     = "   Randomness enabled? :";
+    const char *prng_str        = "            PRNG type  :";
     const char *ct_rev_str      = "   Reverse ct enabled? :";
     const char *data_load_str   = "       Data load type  :";
     const char *assert_str      = "          Assert type  :";
     const char *ifft_str        = "            IFFT type  :";
+    const char *ifft_prec_str   = "       IFFT precision  :";
     const char *ntt_str         = "             NTT type  :";
+    const char *ntt_simd_str    = "             SIMD NTT  :";
     const char *index_map_str   = "       Index map type  :";
     const char *s_str           = "      Secret key type  :";
     // const char *zz_str          = "              ZZ type  :";
@@ -789,6 +792,14 @@ static inline void print_config(bool sym)
     printf("%s No\n", getrand_str);
 #endif
 
+#ifdef SE_PRNG_AES_CTR
+    printf("%s AES-256-CTR (#define SE_PRNG_AES_CTR)\n", prng_str);
+#elif defined(SE_PRNG_CHACHA20)
+    printf("%s ChaCha20 (#define SE_PRNG_CHACHA20)\n", prng_str);
+#else
+    printf("%s SHAKE256 (#define SE_PRNG_SHAKE256)\n", prng_str);
+#endif
+
 #ifdef SE_REVERSE_CT_GEN_ENABLED
     printf("%s Yes (#define SE_REVERSE_CT_GEN_ENABLED)\n", ct_rev_str);
 #else
@@ -836,12 +847,22 @@ static inline void print_config(bool sym)
         ;
 #endif
 
+#ifdef SE_IFFT_SINGLE_PRECISION
+    printf("%s single (#define SE_IFFT_SINGLE_PRECISION)\n", ifft_prec_str);
+#else
+    printf("%s double\n", ifft_prec_str);
+#endif
+
 #ifdef SE_NTT_OTF
     printf("%s compute on-the-fly (#define SE_NTT_OTF)\n", ntt_str);
 #elif defined(SE_NTT_ONE_SHOT)
     printf("%s compute one-shot (#define SE_NTT_ONE_SHOT)\n", ntt_str);
 #elif defined(SE_NTT_REG)
     printf("%s load (from flash) (#define SE_NTT_REG)\n", ntt_str);
+#elif defined(SE_NTT_FAST_MERGED)
+    printf("%s load fast (aka \"lazy\"), 2 levels per pass (from flash) "
+           "(#define SE_NTT_FAST_MERGED)\n",
+           ntt_str);
 #elif defined(SE_NTT_FAST)
     printf("%s load fast (aka \"lazy\") (from flash) (#define SE_NTT_FAST)\n", ntt_str);
 #elif defined(SE_NTT_NONE)
@@ -852,6 +873,16 @@ static inline void print_config(bool sym)
         ;
 #endif
 
+#ifdef SE_NTT_SIMD_X86
+    printf("%s x86 AVX2/AVX-512, chosen at runtime (#define SE_USE_SIMD_NTT)\n", ntt_simd_str);
+#elif defined(SE_SIMD_ARM) && defined(__ARM_NEON)
+    printf("%s ARM NEON (#define SE_USE_SIMD_ARM)\n", ntt_simd_str);
+#elif defined(SE_SIMD_ARM)
+    printf("%s ARM Helium (MVE) (#define SE_USE_SIMD_ARM)\n", ntt_simd_str);
+#else
+    printf("%s No\n", ntt_simd_str);
+#endif
+
 #ifdef SE_INDEX_MAP_OTF
     printf("%s compute on-the-fly (#define SE_INDEX_MAP_OTF)\n", index_map_str);
 #elif defined(SE_INDEX_MAP_LOAD)
@@ -879,6 +910,9 @@ static inline void print_config(bool sym)
 #elif defined(SE_SK_PERSISTENT_ACROSS_PRIMES)
         printf("%s persistent across primes (1 load per sequence) ", s_str);
         printf("(#define SE_SK_PERSISTENT_ACROSS_PRIMES)\n");
+#elif defined(SE_SK_PERSISTENT_NTT)
+        printf("%s truly persistent, ntt(s) cached per prime ", s_str);
+        printf("(#define SE_SK_PERSISTENT_NTT)\n");
 #elif defined(SE_SK_PERSISTENT)
         printf("%s truly persistent (1 load only) (#define SE_SK_PERSISTENT)\n", s_str);
 #else
@@ -52,7 +52,7 @@ def set_ntt_define(set_val):
     with open("lib/user_defines.h", "r") as file :
         filedata = file.readlines()
 
-    newfiledata = file_line_rep(filedata, "#define SE_NTT_TYPE", 0, 3, set_val)
+    newfiledata = file_line_rep(filedata, "#define SE_NTT_TYPE", 0, 4, set_val)
 
     with open("lib/user_defines.h", "w") as file :
         file.writelines(newfiledata)
@@ -77,7 +77,7 @@ def set_sk_define(set_val):
     with open("lib/user_defines.h", "r") as file :
         filedata = file.readlines()
 
-    newfiledata = file_line_rep(filedata, "#define SE_SK_TYPE", 0, 2, set_val)
+    newfiledata = file_line_rep(filedata, "#define SE_SK_TYPE", 0, 3, set_val)
 
     with open("lib/user_defines.h", "w") as file :
         file.writelines(newfiledata)
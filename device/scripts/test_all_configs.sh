@@ -9,7 +9,7 @@ BUILD_DIR=./build
 # ifft            0, 1
 # ntt             0, 1, 2, 3
 # index_map_type  0, 1, 2, 3, 4
-# sk_type         0, 1, 2
+# sk_type         0, 1, 2, 3
 # data_load_type  0, 1
 
 # python3 $CHANGE_DEFINES_SCRIPT -i 0 -n 0 -m 0 -s 0 -d 0
@@ -28,11 +28,11 @@ for d in 0 1
     do
     for i in 0 1
         do
-            for n in 0 1 2 3
+            for n in 0 1 2 3 4
                 do
                     for m in 0 1 2 3 4
                         do
-                            for s in 0 1
+                            for s in 0 1 3
                                 do
                                     python3 $CHANGE_DEFINES_SCRIPT -i $i -n $n -m $m -s $s -d $d 
                                     cmake --build $BUILD_DIR -j || exit 1
@@ -49,3 +49,26 @@ for d in 0 1
                 done
         done
     done
+
+# -- ARM SIMD kernels (see: SE_USE_SIMD_ARM in user_defines.h): cross-compile the unit tests with
+#    NEON enabled and run them with qemu-user. Uses the "fast" NTT so the NTT kernels are covered.
+#    Skipped if the cross-compiler or qemu-arm is not installed.
+ARM_CC=arm-linux-gnueabihf-gcc
+ARM_BUILD_DIR=./build-arm
+if command -v $ARM_CC > /dev/null && command -v qemu-arm > /dev/null
+then
+    python3 $CHANGE_DEFINES_SCRIPT -i 0 -n 3 -m 1 -s 2 -d 0
+    cmake -S . -B $ARM_BUILD_DIR -DSE_BUILD_LOCAL=ON -DCMAKE_C_COMPILER=$ARM_CC \
+        -DCMAKE_C_FLAGS="-mfpu=neon -mfloat-abi=hard -DSE_USE_SIMD_ARM" || exit 1
+    cmake --build $ARM_BUILD_DIR -j || exit 1
+    qemu-arm -L /usr/arm-linux-gnueabihf $ARM_BUILD_DIR/bin/seal_embedded_tests
+    status=$?
+    echo "status = "$status
+    if [ $status -ne 0 ]
+    then
+        echo "THERE WAS AN ERROR."
+        exit
+    fi
+else
+    echo "Skipping ARM SIMD tests ($ARM_CC or qemu-arm not found)."
+fi
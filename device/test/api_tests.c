@@ -7,9 +7,12 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>  // memcmp
 
+#include "ckks_sym.h"
 #include "ckks_tests_common.h"
 #include "defines.h"
+#include "pack.h"
 #include "seal_embedded.h"
 #include "test_common.h"
 #include "util_print.h"
@@ -17,6 +20,14 @@
 // -- Comment out to run true test
 // #define SE_API_TESTS_DEBUG
 
+// -- Whether c1 is sent after c0 for each prime (not the case for seeded symmetric ciphertexts)
+static bool test_print_sends_c1 = true;
+
+#ifdef SE_ENABLE_PACKED_CT
+// -- Parameters of the ciphertexts being sent, used to unpack them
+static const Parms *test_api_parms = 0;
+#endif
+
 /**
 Function to print ciphertext values with the same function signature as SEND_FNCT_PTR.
 Used in place of a networking function for testing.
@@ -29,15 +40,31 @@ Size req: v must be at least vlen_bytes
 */
 size_t test_print_ciphertexts(void *v, size_t vlen_bytes)
 {
-    static int idx   = 0;
-    size_t vlen      = vlen_bytes / sizeof(ZZ);
+#ifdef SE_ENABLE_SYM_SEED_CT
+    // -- Header of a seeded symmetric ciphertext, followed by c0 for each prime
+    if (vlen_bytes == SE_SEED_CT_HEADER_BYTE_COUNT)
+    {
+        print_poly_uint8_full("seed", (uint8_t *)v, vlen_bytes);
+        return vlen_bytes;
+    }
+#endif
+    static int idx = 0;
+#ifdef SE_ENABLE_PACKED_CT
+    // -- Print the unpacked values, so that the adapter can verify them as usual
+    size_t vlen  = test_api_parms->coeff_count;
+    size_t nbits = packed_bit_count(test_api_parms->curr_modulus);
+    se_assert(vlen_bytes == poly_packed_byte_count(vlen, nbits));
+    poly_unpack_inpl((ZZ *)v, vlen, nbits);
+#else
+    size_t vlen = vlen_bytes / sizeof(ZZ);
+#endif
     const char *name = idx ? "c1" : "c0";
 #ifdef SE_API_TESTS_DEBUG
     print_poly(name, (ZZ *)v, vlen);
 #else
     print_poly_full(name, (ZZ *)v, vlen);
 #endif
-    idx = idx ? 0 : 1;
+    idx = (idx || !test_print_sends_c1) ? 0 : 1;
     return vlen_bytes;
 }
 
@@ -53,6 +80,12 @@ void test_ckks_api_base(SE_PARMS *se_parms)
     se_assert(se_parms->se_ptrs);
 
     SEND_FNCT_PTR fake_network_func = (void *)&test_print_ciphertexts;
+#ifdef SE_ENABLE_SYM_SEED_CT
+    test_print_sends_c1 = se_parms->parms->is_asymmetric;
+#endif
+#ifdef SE_ENABLE_PACKED_CT
+    test_api_parms = se_parms->parms;
+#endif
 
     size_t vlen = se_parms->parms->coeff_count / 2;
 #ifdef SE_USE_MALLOC
@@ -96,7 +129,7 @@ void test_ckks_api_base(SE_PARMS *se_parms)
         v = 0;
     }
 #endif
-    delete_parameters(se_parms->parms);
+    se_cleanup(se_parms);
 }
 
 /**
@@ -107,15 +140,6 @@ On success, resulting output can be verified with the SEAL-Embedded adapter.
 void test_ckks_api_sym(void)
 {
     printf("Beginning tests for ckks api symmetric encrypt...\n");
-#ifndef SE_USE_MALLOC
-    static ZZ mempool_local[MEMPOOL_SIZE];
-    *mempool_ptr_global = &(mempool_local[0]);
-    // -- Debugging
-    // printf("Address of mempool_local: %p\n", &(mempool_local[0]));
-    // printf("Address of mempool_ptr_global: %p\n", &mempool_ptr_global);
-    // printf("Value of mempool_ptr_global (should be address of mempool_local): %p\n",
-    // mempool_ptr_global);
-#endif
     SE_PARMS *se_parms = se_setup_default(SE_SYM_ENCR);
     print_test_banner("Symmetric Encryption (API)", se_parms->parms);
     test_ckks_api_base(se_parms);
@@ -129,16 +153,628 @@ On success, resulting output can be verified with the SEAL-Embedded adapter.
 void test_ckks_api_asym(void)
 {
     printf("Beginning tests for ckks api asymmetric encrypt...\n");
-#ifndef SE_USE_MALLOC
-    static ZZ mempool_local[MEMPOOL_SIZE];
-    *mempool_ptr_global = &(mempool_local[0]);
-    // -- Debugging
-    // printf("Address of mempool_local: %p\n", &(mempool_local[0]));
-    // printf("Address of mempool_ptr_global: %p\n", &mempool_ptr_global);
-    // printf("Value of mempool_ptr_global (should be address of mempool_local): %p\n",
-    // mempool_ptr_global);
-#endif
     SE_PARMS *se_parms = se_setup_default(SE_ASYM_ENCR);
     print_test_banner("Asymmetric Encryption (API)", se_parms->parms);
     test_ckks_api_base(se_parms);
 }
+
+/**
+Helper function to encrypt v with fixed seeds on an SE_PARMS instance and save the ciphertext
+corresponding to the last prime.
+
+Size req: c0_save and c1_save must contain space for n ZZ elements
+
+@param[in]  v         Input values
+@param[in]  vlen      Number of values in v
+@param[in]  seed_val  Value used to derive the seeds
+@param[in]  se_parms  SE_PARMS instance
+@param[out] c0_save   Copy of c0 for the last prime
+@param[out] c1_save   Copy of c1 for the last prime
+*/
+static void test_ckks_api_encrypt_save(flpt *v, size_t vlen, uint8_t seed_val, SE_PARMS *se_parms,
+                                       ZZ *c0_save, ZZ *c1_save)
+{
+    uint8_t share_seed[SE_PRNG_SEED_BYTE_COUNT];
+    uint8_t seed[SE_PRNG_SEED_BYTE_COUNT];
+    memset(&(share_seed[0]), seed_val, SE_PRNG_SEED_BYTE_COUNT);
+    memset(&(seed[0]), (uint8_t)(seed_val + 1), SE_PRNG_SEED_BYTE_COUNT);
+
+    bool ret = se_encrypt_seeded(share_seed, seed, NULL, v, vlen * sizeof(flpt), false, se_parms);
+    se_assert(ret);
+
+    size_t n = se_parms->parms->coeff_count;
+    memcpy(c0_save, se_parms->se_ptrs->c0_ptr, n * sizeof(ZZ));
+    memcpy(c1_save, se_parms->se_ptrs->c1_ptr, n * sizeof(ZZ));
+}
+
+/**
+Tests that two SE_PARMS instances do not share any state. Encrypting with the same seeds on two
+instances must produce the same ciphertext, regardless of encryptions performed on the other
+instance in between.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+@param[in] nprimes  # of modulus primes (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ckks_api_contexts(size_t n, size_t nprimes)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+    if (nprimes != SE_NPRIMES) nprimes = SE_NPRIMES;
+#endif
+    printf("Beginning tests for ckks api contexts...\n");
+    double scale = pow(2, 25);
+    size_t vlen  = n / 2;
+
+#ifdef SE_USE_MALLOC
+    size_t mempool_size = ckks_get_mempool_size_sym(n, nprimes);
+    SE_PARMS *ctx_a     = calloc(2, sizeof(SE_PARMS));
+    SE_PARMS *ctx_b     = &(ctx_a[1]);
+    ZZ *mempool_a       = calloc(mempool_size, sizeof(ZZ));
+    ZZ *mempool_b       = calloc(mempool_size, sizeof(ZZ));
+    ZZ *c_save          = calloc(4 * n, sizeof(ZZ));
+    flpt *v             = calloc(vlen, sizeof(flpt));
+#else
+    static SE_PARMS ctx_local[2];
+    static ZZ mempool_a[MEMPOOL_SIZE];
+    static ZZ mempool_b[MEMPOOL_SIZE];
+    static ZZ c_save[4 * SE_DEGREE_N];
+    flpt v[SE_DEGREE_N / 2];
+    SE_PARMS *ctx_a = &(ctx_local[0]);
+    SE_PARMS *ctx_b = &(ctx_local[1]);
+#endif
+    ZZ *c0_a = c_save;
+    ZZ *c1_a = &(c_save[n]);
+    ZZ *c0_b = &(c_save[2 * n]);
+    ZZ *c1_b = &(c_save[3 * n]);
+
+    se_setup_context(n, nprimes, NULL, NULL, scale, SE_SYM_ENCR, mempool_a, ctx_a);
+    se_setup_context(n, nprimes, NULL, NULL, scale, SE_SYM_ENCR, mempool_b, ctx_b);
+    se_assert(ctx_a->se_ptrs->c0_ptr != ctx_b->se_ptrs->c0_ptr);
+
+    print_test_banner("API Contexts", ctx_a->parms);
+
+    for (size_t testnum = 0; testnum < 9; testnum++)
+    {
+        set_encode_encrypt_test(testnum, vlen, v);
+
+        // -- Same seeds on both instances must produce the same ciphertext
+        test_ckks_api_encrypt_save(v, vlen, 1, ctx_a, c0_a, c1_a);
+        test_ckks_api_encrypt_save(v, vlen, 1, ctx_b, c0_b, c1_b);
+        compare_poly("c0 (a)", c0_a, "c0 (b)", c0_b, n);
+        compare_poly("c1 (a)", c1_a, "c1 (b)", c1_b, n);
+
+        // -- Interleaved use of instance b must not affect instance a
+        test_ckks_api_encrypt_save(v, vlen, 1, ctx_a, c0_a, c1_a);
+        test_ckks_api_encrypt_save(v, vlen, 3, ctx_b, c0_b, c1_b);
+        se_assert(memcmp(c1_a, c1_b, n * sizeof(ZZ)));
+        test_ckks_api_encrypt_save(v, vlen, 1, ctx_b, c0_b, c1_b);
+        compare_poly("c0 (a)", c0_a, "c0 (b)", c0_b, n);
+        compare_poly("c1 (a)", c1_a, "c1 (b)", c1_b, n);
+    }
+
+    se_cleanup(ctx_a);
+    se_cleanup(ctx_b);
+#ifdef SE_USE_MALLOC
+    free(v);
+    free(c_save);
+    free(mempool_b);
+    free(mempool_a);
+    free(ctx_a);
+#endif
+    printf("...done with tests for ckks api contexts.\n");
+}
+
+#ifdef SE_USE_MALLOC
+static ZZ *test_capture_buffer  = 0;
+static size_t test_capture_size = 0;  // Number of ZZ values captured so far
+#ifdef SE_ENABLE_SYM_SEED_CT
+static uint8_t *test_capture_headers = 0;
+static size_t test_capture_nheaders  = 0;  // Number of seeded ciphertext headers captured so far
+#endif
+
+/**
+Function to capture ciphertext values with the same function signature as SEND_FNCT_PTR.
+Appends v to test_capture_buffer (or, if v is the header of a seeded ciphertext, to
+test_capture_headers). Used in place of a networking function for testing.
+
+@param[in] v           Input polynomial (ciphertext) to be captured
+@param[in] vlen_bytes  Number of bytes of v to capture
+@returns               Then number of bytes of v that were captured (always equal to vlen_bytes)
+*/
+static size_t test_capture_ciphertexts(void *v, size_t vlen_bytes)
+{
+#ifdef SE_ENABLE_SYM_SEED_CT
+    if (vlen_bytes == SE_SEED_CT_HEADER_BYTE_COUNT)
+    {
+        memcpy(&(test_capture_headers[test_capture_nheaders * vlen_bytes]), v, vlen_bytes);
+        test_capture_nheaders++;
+        return vlen_bytes;
+    }
+#endif
+    memcpy(&(test_capture_buffer[test_capture_size]), v, vlen_bytes);
+#ifdef SE_ENABLE_PACKED_CT
+    // -- Unpack, so that the captured values can be compared as usual
+    size_t n     = test_api_parms->coeff_count;
+    size_t nbits = packed_bit_count(test_api_parms->curr_modulus);
+    se_assert(vlen_bytes == poly_packed_byte_count(n, nbits));
+    poly_unpack_inpl(&(test_capture_buffer[test_capture_size]), n, nbits);
+    test_capture_size += n;
+#else
+    test_capture_size += vlen_bytes / sizeof(ZZ);
+#endif
+    return vlen_bytes;
+}
+#endif
+
+/**
+Tests that se_encrypt_batch_seeded produces the same ciphertexts, in the same order, as consecutive
+calls to se_encrypt_seeded. Component c1 is checked against 'a' regenerated from the shareable seed,
+since se_encrypt_seeded may overwrite c1 with ntt(m + e) in some configurations. If
+SE_ENABLE_SYM_SEED_CT is defined, checks the header sent in place of c1 instead.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  # of modulus primes
+*/
+void test_ckks_api_batch(size_t n, size_t nprimes)
+{
+#ifdef SE_USE_MALLOC
+    printf("Beginning tests for ckks api batch encrypt...\n");
+    const size_t count = 4;
+    double scale       = pow(2, 25);
+    size_t vlen        = n / 2;
+#ifdef SE_ENABLE_SYM_SEED_CT
+    size_t ct_size = n * nprimes;  // ZZ values per vector (all primes)
+    size_t ct_step = n;            // ZZ values per prime
+    test_capture_headers = calloc(2 * count, SE_SEED_CT_HEADER_BYTE_COUNT);
+#else
+    size_t ct_size = 2 * n * nprimes;
+    size_t ct_step = 2 * n;
+#endif
+
+    SE_PARMS *se_parms  = se_setup_custom(n, nprimes, NULL, NULL, scale, SE_SYM_ENCR);
+    Parms *parms        = se_parms->parms;
+    flpt *v             = calloc(count * vlen, sizeof(flpt));
+    uint8_t *seeds      = calloc(2 * count, SE_PRNG_SEED_BYTE_COUNT);
+    ZZ *batch_out       = calloc(count * ct_size, sizeof(ZZ));
+    ZZ *single_out      = calloc(count * ct_size, sizeof(ZZ));
+    ZZ *a_expected      = calloc(n, sizeof(ZZ));
+    uint8_t *share_seeds = &(seeds[count * SE_PRNG_SEED_BYTE_COUNT]);
+    const void *vecs[4];
+
+#ifdef SE_ENABLE_PACKED_CT
+    test_api_parms = parms;
+#endif
+    print_test_banner("Batch Encryption (API)", parms);
+    for (size_t b = 0; b < count; b++)
+    {
+        set_encode_encrypt_test(b, vlen, &(v[b * vlen]));
+        vecs[b] = &(v[b * vlen]);
+        memset(&(seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 1), SE_PRNG_SEED_BYTE_COUNT);
+        memset(&(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 11), SE_PRNG_SEED_BYTE_COUNT);
+    }
+    // -- Also test a short vector, which must be zero-padded
+    size_t vlen_bytes = vlen * sizeof(flpt);
+
+    for (size_t short_vec = 0; short_vec < 2; short_vec++)
+    {
+        size_t vlen_bytes_test = short_vec ? vlen_bytes / 2 : vlen_bytes;
+
+        test_capture_buffer = batch_out;
+        test_capture_size   = 0;
+#ifdef SE_ENABLE_SYM_SEED_CT
+        test_capture_nheaders = 0;
+#endif
+        bool ret = se_encrypt_batch_seeded(share_seeds, seeds, &test_capture_ciphertexts, vecs,
+                                           count, vlen_bytes_test, se_parms);
+        se_assert(ret && test_capture_size == count * ct_size);
+
+        test_capture_buffer = single_out;
+        test_capture_size   = 0;
+        for (size_t b = 0; b < count; b++)
+        {
+            ret = se_encrypt_seeded(&(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]),
+                                    &(seeds[b * SE_PRNG_SEED_BYTE_COUNT]),
+                                    &test_capture_ciphertexts, (void *)vecs[b], vlen_bytes_test,
+                                    false, se_parms);
+            se_assert(ret);
+        }
+        se_assert(test_capture_size == count * ct_size);
+#ifdef SE_ENABLE_SYM_SEED_CT
+        se_assert(test_capture_nheaders == 2 * count);
+#endif
+
+        for (size_t b = 0; b < count; b++)
+        {
+#ifdef SE_ENABLE_SYM_SEED_CT
+            // -- Both headers must hold the seed version and the shareable seed of vector b
+            for (size_t k = 0; k < 2; k++)
+            {
+                uint8_t *header =
+                    &(test_capture_headers[(k * count + b) * SE_SEED_CT_HEADER_BYTE_COUNT]);
+                se_assert(header[0] == SE_PRNG_SEED_VERSION);
+                se_assert(!memcmp(&(header[1]), &(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]),
+                                  SE_PRNG_SEED_BYTE_COUNT));
+            }
+#endif
+            SE_PRNG prng;
+            prng_randomize_reset(&prng, &(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]));
+            ckks_reset_primes(parms);
+            for (size_t i = 0; i < nprimes; i++)
+            {
+                ZZ *c0_batch  = &(batch_out[b * ct_size + i * ct_step]);
+                ZZ *c0_single = &(single_out[b * ct_size + i * ct_step]);
+                compare_poly("c0 (batch)", c0_batch, "c0 (single)", c0_single, n);
+
+#ifndef SE_ENABLE_SYM_SEED_CT
+                sample_poly_uniform(parms, &prng, a_expected);
+                compare_poly("c1 (batch)", c0_batch + n, "a", a_expected, n);
+#endif
+                if ((i + 1) < nprimes) ckks_next_prime_sym(parms, NULL);
+            }
+        }
+    }
+
+#ifdef SE_ENABLE_SYM_SEED_CT
+    free(test_capture_headers);
+    test_capture_headers = 0;
+#endif
+    free(a_expected);
+    free(single_out);
+    free(batch_out);
+    free(seeds);
+    free(v);
+    se_cleanup(se_parms);
+    printf("...done with tests for ckks api batch encrypt.\n");
+#else
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+#endif
+}
+
+#ifdef SE_USE_MALLOC
+// -- Bytes received so far by the test stream (and by test_capture_bytes)
+static uint8_t *test_stream_bytes      = 0;
+static size_t test_stream_nbytes       = 0;
+static const void **test_stream_data   = 0;  // Pending sends of the test stream
+static size_t *test_stream_lens        = 0;
+static size_t test_stream_npending     = 0;
+static size_t test_stream_max_npending = 0;
+
+/**
+Function to capture the raw bytes sent, with the same function signature as SEND_FNCT_PTR. Appends v
+to test_stream_bytes.
+
+@param[in] v           Data to be captured
+@param[in] vlen_bytes  Number of bytes of v to capture
+@returns               Then number of bytes of v that were captured (always equal to vlen_bytes)
+*/
+static size_t test_capture_bytes(void *v, size_t vlen_bytes)
+{
+    memcpy(&(test_stream_bytes[test_stream_nbytes]), v, vlen_bytes);
+    test_stream_nbytes += vlen_bytes;
+    return vlen_bytes;
+}
+
+/**
+'send' function of the test stream (see: SE_SEND_STREAM). Only records the pointer to the data, as a
+non-blocking transport would. The data is read when test_stream_wait is called, so any modification
+of the data by the library before then shows up in the captured bytes.
+
+@param[in] ctx     Unused
+@param[in] data    Data to send
+@param[in] nbytes  Number of bytes of data to send
+@returns           nbytes
+*/
+static size_t test_stream_send(void *ctx, const void *data, size_t nbytes)
+{
+    SE_UNUSED(ctx);
+    se_assert(test_stream_npending < test_stream_max_npending);
+    test_stream_data[test_stream_npending] = data;
+    test_stream_lens[test_stream_npending] = nbytes;
+    test_stream_npending++;
+    return nbytes;
+}
+
+/**
+'wait' function of the test stream (see: SE_SEND_STREAM). Appends the data of all pending sends to
+test_stream_bytes.
+
+@param[in] ctx  Unused
+*/
+static void test_stream_wait(void *ctx)
+{
+    SE_UNUSED(ctx);
+    for (size_t k = 0; k < test_stream_npending; k++)
+    {
+        memcpy(&(test_stream_bytes[test_stream_nbytes]), test_stream_data[k], test_stream_lens[k]);
+        test_stream_nbytes += test_stream_lens[k];
+    }
+    test_stream_npending = 0;
+}
+#endif
+
+/**
+Tests that se_encrypt_stream_seeded sends the same bytes, in the same order, as
+se_encrypt_batch_seeded for several chunk sizes. The test stream only reads the data of each send
+when 'wait' is called, so this also checks that the library does not modify data that is still
+being sent.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  # of modulus primes
+*/
+void test_ckks_api_stream(size_t n, size_t nprimes)
+{
+#ifdef SE_USE_MALLOC
+    printf("Beginning tests for ckks api stream encrypt...\n");
+    const size_t count = 3;
+    double scale       = pow(2, 25);
+    size_t vlen        = n / 2;
+    size_t max_nbytes  = count * (SE_SEED_CT_HEADER_BYTE_COUNT + 2 * n * nprimes * sizeof(ZZ));
+
+    SE_PARMS *se_parms   = se_setup_custom(n, nprimes, NULL, NULL, scale, SE_SYM_ENCR);
+    flpt *v              = calloc(count * vlen, sizeof(flpt));
+    uint8_t *seeds       = calloc(2 * count, SE_PRNG_SEED_BYTE_COUNT);
+    uint8_t *batch_out   = calloc(max_nbytes, 1);
+    uint8_t *stream_out  = calloc(max_nbytes, 1);
+    uint8_t *share_seeds = &(seeds[count * SE_PRNG_SEED_BYTE_COUNT]);
+    const void *vecs[3];
+
+    // -- At most all of c0 in chunks of 8, c1, and a header may be pending at once
+    test_stream_max_npending = n / 8 + 2;
+    test_stream_data         = calloc(test_stream_max_npending, sizeof(void *));
+    test_stream_lens         = calloc(test_stream_max_npending, sizeof(size_t));
+
+    print_test_banner("Stream Encryption (API)", se_parms->parms);
+    for (size_t b = 0; b < count; b++)
+    {
+        set_encode_encrypt_test(b, vlen, &(v[b * vlen]));
+        vecs[b] = &(v[b * vlen]);
+        memset(&(seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 1), SE_PRNG_SEED_BYTE_COUNT);
+        memset(&(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 21), SE_PRNG_SEED_BYTE_COUNT);
+    }
+    size_t vlen_bytes = vlen * sizeof(flpt);
+
+    test_stream_bytes  = batch_out;
+    test_stream_nbytes = 0;
+    bool ret = se_encrypt_batch_seeded(share_seeds, seeds, &test_capture_bytes, vecs, count,
+                                       vlen_bytes, se_parms);
+    se_assert(ret);
+    size_t batch_nbytes = test_stream_nbytes;
+
+    const size_t chunk_counts[3] = {0, 8, n / 4};
+    for (size_t k = 0; k < 3; k++)
+    {
+        printf("chunk count: %zu\n", chunk_counts[k]);
+        SE_SEND_STREAM stream;
+        stream.send        = &test_stream_send;
+        stream.wait        = &test_stream_wait;
+        stream.ctx         = NULL;
+        stream.chunk_count = chunk_counts[k];
+
+        test_stream_bytes    = stream_out;
+        test_stream_nbytes   = 0;
+        test_stream_npending = 0;
+        memset(stream_out, 0, max_nbytes);
+        ret = se_encrypt_stream_seeded(share_seeds, seeds, &stream, vecs, count, vlen_bytes,
+                                       se_parms);
+        se_assert(ret);
+        se_assert(test_stream_npending == 0);
+        se_assert(test_stream_nbytes == batch_nbytes);
+        se_assert(!memcmp(stream_out, batch_out, batch_nbytes));
+    }
+
+    free(test_stream_lens);
+    free(test_stream_data);
+    test_stream_data = 0;
+    test_stream_lens = 0;
+    free(stream_out);
+    free(batch_out);
+    free(seeds);
+    free(v);
+    se_cleanup(se_parms);
+    printf("...done with tests for ckks api stream encrypt.\n");
+#else
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+#endif
+}
+
+/**
+Tests that running the per-prime encryption tasks out of order and sending them in order sends the
+same bytes as se_encrypt_batch_seeded (symmetric) or se_encrypt_seeded (asymmetric), and that
+se_encrypt_parallel_seeded does as well for any number of threads.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  # of modulus primes
+*/
+void test_ckks_api_prime_tasks(size_t n, size_t nprimes)
+{
+#ifdef SE_USE_MALLOC
+    printf("Beginning tests for ckks api prime tasks...\n");
+    double scale      = pow(2, 25);
+    size_t vlen       = n / 2;
+    size_t vlen_bytes = vlen * sizeof(flpt);
+    size_t max_nbytes = SE_SEED_CT_HEADER_BYTE_COUNT + 2 * n * nprimes * sizeof(ZZ);
+
+    flpt *v          = calloc(vlen, sizeof(flpt));
+    uint8_t *ref_out = calloc(max_nbytes, 1);
+    uint8_t *out     = calloc(max_nbytes, 1);
+    uint8_t seed[SE_PRNG_SEED_BYTE_COUNT];
+    uint8_t share_seed[SE_PRNG_SEED_BYTE_COUNT];
+    set_encode_encrypt_test(0, vlen, v);
+    const void *vecs[1] = {v};
+
+    for (size_t asym = 0; asym < 2; asym++)
+    {
+        EncryptType enc_type = asym ? SE_ASYM_ENCR : SE_SYM_ENCR;
+        SE_PARMS *se_parms   = se_setup_custom(n, nprimes, NULL, NULL, scale, enc_type);
+        print_test_banner(asym ? "Prime Tasks Asymmetric (API)" : "Prime Tasks Symmetric (API)",
+                          se_parms->parms);
+        memset(seed, 7, SE_PRNG_SEED_BYTE_COUNT);
+        memset(share_seed, 11, SE_PRNG_SEED_BYTE_COUNT);
+
+        test_stream_bytes  = ref_out;
+        test_stream_nbytes = 0;
+        bool ret;
+        if (asym)
+            ret = se_encrypt_seeded(NULL, seed, &test_capture_bytes, v, vlen_bytes, false,
+                                    se_parms);
+        else
+            ret = se_encrypt_batch_seeded(share_seed, seed, &test_capture_bytes, vecs, 1,
+                                          vlen_bytes, se_parms);
+        se_assert(ret);
+        size_t ref_nbytes = test_stream_nbytes;
+
+        // -- Run the tasks in reverse order, then send them in order
+        SE_PRIME_TASKS tasks;
+        ret = se_prime_tasks_alloc(se_parms, &tasks);
+        se_assert(ret && tasks.ntasks == nprimes);
+
+        test_stream_bytes  = out;
+        test_stream_nbytes = 0;
+        memset(out, 0, max_nbytes);
+        ret = se_prime_tasks_setup(share_seed, seed, &test_capture_bytes, v, vlen_bytes, se_parms,
+                                   &tasks);
+        se_assert(ret);
+        for (size_t i = nprimes; i-- > 0;) se_prime_task_run(&(tasks.tasks[i]));
+        for (size_t i = 0; i < nprimes; i++)
+        {
+            for (size_t j = 0; j < n; j++)
+            {
+                se_assert(tasks.tasks[i].c0[j] < tasks.tasks[i].parms.curr_modulus->value);
+                se_assert(tasks.tasks[i].c1[j] < tasks.tasks[i].parms.curr_modulus->value);
+            }
+            se_prime_task_send(&test_capture_bytes, &(tasks.tasks[i]));
+        }
+        se_assert(test_stream_nbytes == ref_nbytes);
+        se_assert(!memcmp(out, ref_out, ref_nbytes));
+        se_prime_tasks_free(&tasks);
+
+#ifdef SE_USE_PTHREADS
+        for (size_t nthreads = 1; nthreads <= nprimes + 1; nthreads++)
+        {
+            printf("threads: %zu\n", nthreads);
+            test_stream_nbytes = 0;
+            memset(out, 0, max_nbytes);
+            ret = se_encrypt_parallel_seeded(share_seed, seed, &test_capture_bytes, v, vlen_bytes,
+                                             nthreads, se_parms);
+            se_assert(ret);
+            se_assert(test_stream_nbytes == ref_nbytes);
+            se_assert(!memcmp(out, ref_out, ref_nbytes));
+        }
+#endif
+        se_cleanup(se_parms);
+    }
+
+    free(out);
+    free(ref_out);
+    free(v);
+    printf("...done with tests for ckks api prime tasks.\n");
+#else
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+#endif
+}
+
+/**
+Tests that the encode-encrypt pipeline sends the same bytes as se_encrypt_batch_seeded, both when
+driving the two stages by hand (interleaved, with the ring running full and empty) and with the
+pthreads driver for several numbers of slots.
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  # of modulus primes
+*/
+void test_ckks_api_pipeline(size_t n, size_t nprimes)
+{
+#ifdef SE_USE_MALLOC
+    printf("Beginning tests for ckks api pipeline...\n");
+    const size_t count = 4;
+    double scale       = pow(2, 25);
+    size_t vlen        = n / 2;
+    size_t vlen_bytes  = vlen * sizeof(flpt);
+    size_t max_nbytes  = count * (SE_SEED_CT_HEADER_BYTE_COUNT + 2 * n * nprimes * sizeof(ZZ));
+
+    flpt *v              = calloc(count * vlen, sizeof(flpt));
+    uint8_t *seeds       = calloc(2 * count, SE_PRNG_SEED_BYTE_COUNT);
+    uint8_t *ref_out     = calloc(max_nbytes, 1);
+    uint8_t *out         = calloc(max_nbytes, 1);
+    uint8_t *share_seeds = &(seeds[count * SE_PRNG_SEED_BYTE_COUNT]);
+    const void *vecs[4];
+    for (size_t b = 0; b < count; b++)
+    {
+        set_encode_encrypt_test(b, vlen, &(v[b * vlen]));
+        vecs[b] = &(v[b * vlen]);
+        memset(&(seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 1), SE_PRNG_SEED_BYTE_COUNT);
+        memset(&(share_seeds[b * SE_PRNG_SEED_BYTE_COUNT]), (int)(b + 31), SE_PRNG_SEED_BYTE_COUNT);
+    }
+
+    for (size_t asym = 0; asym < 2; asym++)
+    {
+        EncryptType enc_type = asym ? SE_ASYM_ENCR : SE_SYM_ENCR;
+        SE_PARMS *se_parms   = se_setup_custom(n, nprimes, NULL, NULL, scale, enc_type);
+        print_test_banner(asym ? "Pipeline Asymmetric (API)" : "Pipeline Symmetric (API)",
+                          se_parms->parms);
+
+        test_stream_bytes  = ref_out;
+        test_stream_nbytes = 0;
+        bool ret = se_encrypt_batch_seeded(share_seeds, seeds, &test_capture_bytes, vecs, count,
+                                           vlen_bytes, se_parms);
+        se_assert(ret);
+        size_t ref_nbytes = test_stream_nbytes;
+
+        // -- Drive the stages by hand with 2 slots, running the ring full and empty
+        SE_PIPELINE pipe;
+        ret = se_pipeline_alloc(se_parms, 2, &pipe);
+        se_assert(ret);
+        test_stream_bytes  = out;
+        test_stream_nbytes = 0;
+        memset(out, 0, max_nbytes);
+        size_t nencoded = 0, nencrypted = 0;
+        const size_t schedule[6][2] = {{2, 0}, {0, 1}, {1, 0}, {0, 2}, {1, 0}, {0, 1}};
+        for (size_t k = 0; k < 6; k++)
+        {
+            // -- schedule[k] = {# to encode, # to encrypt}
+            for (size_t j = 0; j < schedule[k][0]; j++, nencoded++)
+            {
+                size_t offset = nencoded * SE_PRNG_SEED_BYTE_COUNT;
+                ret = se_pipeline_encode(&(share_seeds[offset]), &(seeds[offset]),
+                                         (void *)vecs[nencoded], vlen_bytes, &pipe);
+                se_assert(ret);
+            }
+            for (size_t j = 0; j < schedule[k][1]; j++, nencrypted++)
+                se_pipeline_encrypt(&test_capture_bytes, &pipe);
+            se_assert(se_pipeline_can_encode(&pipe) == (nencoded - nencrypted < 2));
+            se_assert(se_pipeline_can_encrypt(&pipe) == (nencoded > nencrypted));
+        }
+        se_assert(nencoded == count && nencrypted == count);
+        se_assert(test_stream_nbytes == ref_nbytes);
+        se_assert(!memcmp(out, ref_out, ref_nbytes));
+        se_pipeline_free(&pipe);
+
+#ifdef SE_USE_PTHREADS
+        for (size_t nslots = 1; nslots <= 3; nslots++)
+        {
+            printf("slots: %zu\n", nslots);
+            test_stream_nbytes = 0;
+            memset(out, 0, max_nbytes);
+            ret = se_encrypt_pipelined_seeded(share_seeds, seeds, &test_capture_bytes, vecs, count,
+                                              vlen_bytes, nslots, se_parms);
+            se_assert(ret);
+            se_assert(test_stream_nbytes == ref_nbytes);
+            se_assert(!memcmp(out, ref_out, ref_nbytes));
+        }
+#endif
+        se_cleanup(se_parms);
+    }
+
+    free(out);
+    free(ref_out);
+    free(seeds);
+    free(v);
+    printf("...done with tests for ckks api pipeline.\n");
+#else
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+#endif
+}
@@ -48,8 +48,8 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
     if (!parms.sample_s) se_assert(parms.small_s);
 
 #ifdef SE_USE_MALLOC
-    print_ckks_mempool_size(n, 0);
-    ZZ *mempool = ckks_mempool_setup_asym(n);
+    print_ckks_mempool_size(n, nprimes, 0);
+    ZZ *mempool = ckks_mempool_setup_asym(n, nprimes);
 #else
     print_ckks_mempool_size();
     ZZ mempool_local[MEMPOOL_SIZE];
@@ -60,7 +60,7 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
     // -- Get pointers
     SE_PTRS se_ptrs_local;
     ckks_set_ptrs_asym(n, mempool, &se_ptrs_local);
-    double complex *conj_vals  = se_ptrs_local.conj_vals;
+    cflpt *conj_vals           = se_ptrs_local.conj_vals;
     int64_t *conj_vals_int     = se_ptrs_local.conj_vals_int_ptr;
     double complex *ifft_roots = se_ptrs_local.ifft_roots;
     ZZ *pk_c0                  = se_ptrs_local.c0_ptr;
@@ -71,6 +71,7 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
     ZZ *u                      = se_ptrs_local.ternary;
     flpt *v                    = se_ptrs_local.values;
     int8_t *e1                 = se_ptrs_local.e1_ptr;
+    ZZ *pk_cache               = se_ptrs_local.pk_ptr;
     size_t vlen                = n / 2;
 
     if (!test_message)
@@ -148,6 +149,9 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
             set_encode_encrypt_test(testnum, vlen, v);
             print_poly_flpt("v        ", v, vlen);
         }
+        else
+            clear_flpt(v, vlen);
+        const flpt *v_save = save_test_values(v, vlen);
 
         // ------------------------------------------
         // ----- Begin encode-encrypt sequence ------
@@ -215,9 +219,19 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
             // print_poly_int8_full("e1  ", e1_ptr, n);
             // if (ntt_e1_ptr) print_poly_full("ntt e1  ", ntt_e1_ptr, n);
 
+            // -- If the public key is resident, copy it into the cache for this prime so that
+            //    encryption reads it from there instead of from pk_c0 and pk_c1
+            if (pk_cache)
+            {
+                memcpy(&(pk_cache[2 * i * n]), pk_c0, n * sizeof(ZZ));
+                memcpy(&(pk_cache[(2 * i + 1) * n]), pk_c1, n * sizeof(ZZ));
+                memset(pk_c0, 0, n * sizeof(ZZ));
+                memset(pk_c1, 0, n * sizeof(ZZ));
+            }
+
             // -- Per prime Encode + Encrypt
-            ckks_encode_encrypt_asym(&parms, conj_vals_int, u, e1, ntt_roots, ntt_u_e1_pte,
-                                     ntt_u_save, ntt_e1_save, pk_c0, pk_c1);
+            ckks_encode_encrypt_asym(&parms, conj_vals_int, u, e1, pk_cache, ntt_roots,
+                                     ntt_u_e1_pte, ntt_u_save, ntt_e1_save, pk_c0, pk_c1);
             print_poly_int64("conj_vals_int      ", conj_vals_int, n);
 
             // -- Debugging
@@ -275,8 +289,8 @@ void test_ckks_asym_base(size_t n, size_t nprimes, bool test_message)
             // -- Note: sizeof(max(ntt_roots, ifft_roots)) must be passed as temp memory to undo
             //    ifft.
             bool s_test_save_small = 0;
-            check_decode_decrypt_inpl(pk_c0, pk_c1, v, vlen, ntt_s_save, s_test_save_small, pterr,
-                                      index_map, &parms, temp_test_mem);
+            check_decode_decrypt_inpl(pk_c0, pk_c1, v_save, vlen, ntt_s_save, s_test_save_small,
+                                      pterr, index_map, &parms, temp_test_mem);
 
             // -- Done checking this prime, now try next prime if requested
             // -- Note: This does nothing to u if u is in small form
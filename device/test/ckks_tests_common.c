@@ -10,6 +10,7 @@
 #include <complex.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>  // memcpy
 
 #include "ckks_common.h"
 #include "defines.h"
@@ -56,6 +57,20 @@ void set_encode_encrypt_test(size_t testnum, size_t vlen, flpt *v)
     }
 }
 
+// -- Copy of the test values last saved by save_test_values (n/2 values at most)
+#ifdef SE_USE_MALLOC
+static flpt test_values_save[16384 / 2];
+#else
+static flpt test_values_save[SE_DEGREE_N / 2];
+#endif
+
+const flpt *save_test_values(const flpt *v, size_t vlen)
+{
+    se_assert(v && vlen <= sizeof(test_values_save) / sizeof(flpt));
+    memcpy(test_values_save, v, vlen * sizeof(flpt));
+    return test_values_save;
+}
+
 void ckks_decode(const ZZ *pt, size_t values_len, uint16_t *index_map, const Parms *parms,
                  double complex *temp, flpt *values_decoded)
 {
@@ -103,15 +118,16 @@ void ckks_decode(const ZZ *pt, size_t values_len, uint16_t *index_map, const Par
     { values_decoded[i] = (flpt)(res_double[index_map_[i]]); }
     // print_poly_flpt("decoded", values_decoded, n);
 #else
-    se_assert(index_map);
+    const uint16_t *map = index_map;
 #ifdef SE_INDEX_MAP_LOAD
     // -- Load or setup here, doesn't matter, since we are just testing...
-    load_index_map(parms, index_map);
+    map = load_index_map(parms, index_map);
 #elif defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
-    if (parms->is_asymmetric) load_index_map(parms, index_map);
+    if (parms->is_asymmetric) map = load_index_map(parms, index_map);
 #endif
+    se_assert(map);
     for (size_t i = 0; i < values_len; i++)
-    { values_decoded[i] = (flpt)se_creal(res[index_map[i]]); }
+    { values_decoded[i] = (flpt)se_creal(res[map[i]]); }
 #endif
 }
 
@@ -23,6 +23,17 @@ If testnum > 8, will set testnum to 8.
 */
 void set_encode_encrypt_test(size_t testnum, size_t vlen, flpt *v);
 
+/**
+Saves a copy of the test values to check decoding against. The values buffer of the memory pool is
+only live while mapping (see: mempool.h), so it is overwritten by the time the result is decoded.
+The copy is valid until the next call.
+
+@param[in] v     Test values
+@param[in] vlen  Number of flpt elements in v. Must be <= n/2
+@returns         Copy of the values of 'v'
+*/
+const flpt *save_test_values(const flpt *v, size_t vlen);
+
 /**
 (Pseudo) ckks decode. 'values_decoded' and 'pt' may share the same starting address for in-place
 computation (see: ckks_decode_inpl)
@@ -36,8 +36,8 @@ void test_ckks_encode(size_t n)
 
     Parms parms;
 #ifdef SE_USE_MALLOC
-    print_ckks_mempool_size(n, 1);
-    ZZ *mempool = ckks_mempool_setup_sym(n);
+    print_ckks_mempool_size(n, 1, 1);
+    ZZ *mempool = ckks_mempool_setup_sym(n, 1);
 #else
     print_ckks_mempool_size();
     ZZ mempool_local[MEMPOOL_SIZE];
@@ -49,7 +49,7 @@ void test_ckks_encode(size_t n)
     // -- Get pointers
     SE_PTRS se_ptrs_local;
     ckks_set_ptrs_sym(n, mempool, &se_ptrs_local);
-    double complex *conj_vals  = se_ptrs_local.conj_vals;
+    cflpt *conj_vals           = se_ptrs_local.conj_vals;
     int64_t *conj_vals_int     = se_ptrs_local.conj_vals_int_ptr;
     double complex *ifft_roots = se_ptrs_local.ifft_roots;
     uint16_t *index_map        = se_ptrs_local.index_map_ptr;
@@ -79,6 +79,7 @@ void test_ckks_encode(size_t n)
         // -- Get test values
         set_encode_encrypt_test(testnum, vlen, v);
         print_poly_flpt("v        ", v, vlen);
+        const flpt *v_save = save_test_values(v, vlen);
 
         // -- Begin encode-encrypt sequence
         // -- First, encode base. Afer this, we should only use the pointer values
@@ -91,7 +92,7 @@ void test_ckks_encode(size_t n)
         // print_poly_int64_full("conj_vals_int      ", conj_vals_int, n);
 
         // -- Check that decoding works
-        check_decode_inpl(pt, v, vlen, index_map, &parms, temp);
+        check_decode_inpl(pt, v_save, vlen, index_map, &parms, temp);
     }
 #ifdef SE_USE_MALLOC
     // clang-format off
@@ -48,8 +48,8 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
     if (!parms.sample_s) se_assert(parms.small_s);
 
 #ifdef SE_USE_MALLOC
-    print_ckks_mempool_size(n, true);
-    ZZ *mempool = ckks_mempool_setup_sym(n);
+    print_ckks_mempool_size(n, nprimes, true);
+    ZZ *mempool = ckks_mempool_setup_sym(n, nprimes);
 #else
     print_ckks_mempool_size();
     ZZ mempool_local[MEMPOOL_SIZE];
@@ -60,7 +60,7 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
     // -- Get pointers
     SE_PTRS se_ptrs_local;
     ckks_set_ptrs_sym(n, mempool, &se_ptrs_local);
-    double complex *conj_vals  = se_ptrs_local.conj_vals;
+    cflpt *conj_vals           = se_ptrs_local.conj_vals;
     int64_t *conj_vals_int     = se_ptrs_local.conj_vals_int_ptr;
     double complex *ifft_roots = se_ptrs_local.ifft_roots;
     ZZ *c0                     = se_ptrs_local.c0_ptr;
@@ -110,6 +110,10 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
     size_t s_size = parms.small_s ? n / 16 : n;
     if (encode_only) clear(s, s_size);
 
+    // -- If ntt(s) is resident, compute it for every prime ahead of time too
+    ZZ *ntt_s_cache = se_ptrs_local.ntt_s_ptr;
+    if (ntt_s_cache) ckks_setup_ntt_s(&parms, s, ntt_roots, ntt_s_cache);
+
     for (size_t testnum = 0; testnum < 9; testnum++)
     {
         printf("-------------------- Test %zu -----------------------\n", testnum);
@@ -121,6 +125,9 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
             set_encode_encrypt_test(testnum, vlen, v);
             print_poly_flpt("v        ", v, vlen);
         }
+        else
+            clear_flpt(v, vlen);
+        const flpt *v_save = save_test_values(v, vlen);
 
         // -- Begin encode-encrypt sequence
         // -- First, calculate m + e (not fully reduced, not in ntt form)
@@ -147,8 +154,8 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
             // -- Per prime Encode + Encrypt
             // print_poly_ternary("s", s, n, true);
             // print_poly_ternary_full("s", s, n, true);
-            ckks_encode_encrypt_sym(&parms, conj_vals_int, NULL, &shareable_prng, s, ntt_pte,
-                                    ntt_roots, c0, c1, s_test_save, c1_test_save);
+            ckks_encode_encrypt_sym(&parms, conj_vals_int, NULL, &shareable_prng, s, ntt_s_cache,
+                                    ntt_pte, ntt_roots, c0, c1, s_test_save, c1_test_save);
             // print_poly_int64("conj_vals_int", conj_vals_int, n);
             // print_poly_ternary("s", s, n, true);
             // print_poly_ternary("s_save", s, n, false);
@@ -158,9 +165,12 @@ void test_ckks_sym_base(size_t n, size_t nprimes, bool test_message)
             //    just decrypt.
             // -- Note: sizeof(max(ntt_roots, ifft_roots)) must be passed as temp memory
             //    to undo ifft
+            // -- ntt_pte is left lazily reduced by the fused final pass
+            for (size_t i = 0; i < n; i++)
+            { ntt_pte[i] = reduce_lazy_4q(ntt_pte[i], parms.curr_modulus->value); }
             bool s_test_save_small = false;
-            check_decode_decrypt_inpl(c0, c1_test_save, v, vlen, s_test_save, s_test_save_small,
-                                      ntt_pte, index_map, &parms, temp_test_mem);
+            check_decode_decrypt_inpl(c0, c1_test_save, v_save, vlen, s_test_save,
+                                      s_test_save_small, ntt_pte, index_map, &parms, temp_test_mem);
 
 #ifdef SE_SK_PERSISTENT_ACROSS_PRIMES
             // -- Decoding corrupted this, so load it back
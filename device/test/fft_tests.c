@@ -6,6 +6,7 @@
 */
 
 #include <complex.h>
+#include <float.h>  // FLT_EPSILON
 #include <math.h>    // log2
 #include <string.h>  // memcpy
 
@@ -15,6 +16,10 @@
 #include "test_common.h"
 #include "util_print.h"
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 #ifndef SE_USE_MALLOC
 #if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
 #define IFFT_TEST_ROOTS_MEM SE_DEGREE_N
@@ -100,6 +105,9 @@ void test_fft_mult_helper(size_t n, double complex *v1, double complex *v2, doub
 {
     size_t logn = (size_t)log2(n);
 
+    // -- Loaded roots may be read from code directly instead of 'roots' (see: fileops.h)
+    const double complex *roots_ptr = roots;
+
     // -- Correctness: ifft(fft(vec) .* fft(v2))*(1/n) = vec * vec2
     print_poly_double_complex("v1              ", v1, n);
     print_poly_double_complex("v2              ", v2, n);
@@ -112,15 +120,15 @@ void test_fft_mult_helper(size_t n, double complex *v1, double complex *v2, doub
 
 #ifdef SE_FFT_LOAD_FULL
     se_assert(roots);
-    load_fft_roots(n, roots);
+    roots_ptr = load_fft_roots(n, roots);
 #elif defined(SE_FFT_ONE_SHOT)
     se_assert(roots);
     calc_fft_roots(n, logn, roots);
 #endif
 
-    fft_inpl(v1, n, logn, roots);
+    fft_inpl(v1, n, logn, roots_ptr);
     // print_poly_double_complex("v1 (after fft)  ", v1, n);
-    fft_inpl(v2, n, logn, roots);
+    fft_inpl(v2, n, logn, roots_ptr);
     // print_poly_double_complex("v2 (after fft)  ", v2, n);
 
     pointwise_mult_inpl_complex(v1, v2, n);
@@ -128,13 +136,13 @@ void test_fft_mult_helper(size_t n, double complex *v1, double complex *v2, doub
 
 #ifdef SE_IFFT_LOAD_FULL
     se_assert(roots);
-    load_ifft_roots(n, roots);
+    roots_ptr = load_ifft_roots(n, roots);
 #elif defined(SE_IFFT_ONE_SHOT)
     se_assert(roots);
     calc_ifft_roots(n, logn, roots);
 #endif
 
-    ifft_inpl(v1, n, logn, roots);
+    ifft_inpl(v1, n, logn, roots_ptr);
     // print_poly_double_complex("vec (after ifft)  ", v1, n);
 
     poly_div_inpl_complex(v1, n, n);
@@ -157,6 +165,7 @@ void test_fft_helper(size_t degree, const double complex *v, double complex *tem
 {
     size_t n    = degree;
     size_t logn = (size_t)log2(degree);
+    const double complex *roots_ptr = roots;
 
     // -- Correctness: ifft(fft(vec)) * (1/n) = vec
     // -- Save vec for comparison later. Write to temp to apply fft/ifft in-place
@@ -167,20 +176,20 @@ void test_fft_helper(size_t degree, const double complex *v, double complex *tem
 
 #ifdef SE_FFT_LOAD_FULL
     se_assert(roots);
-    load_fft_roots(n, roots);
+    roots_ptr = load_fft_roots(n, roots);
 #elif defined(SE_FFT_ONE_SHOT)
     se_assert(roots);
     calc_fft_roots(n, logn, roots);
 #endif
 
     // -- Note: 'roots' will be ignored if SE_FFT_OTF is chosen
-    fft_inpl(v_fft, n, logn, roots);
+    fft_inpl(v_fft, n, logn, roots_ptr);
     print_poly_double_complex("vec (after fft)   ", v, n);
 
 #ifdef SE_IFFT_LOAD_FULL
     se_assert(roots);
-    load_ifft_roots(n, roots);
-    print_poly_double_complex("roots               ", roots, n);
+    roots_ptr = load_ifft_roots(n, roots);
+    print_poly_double_complex("roots               ", roots_ptr, n);
     // print_poly_double_complex_full("roots               ", roots, n);
 #elif defined(SE_IFFT_ONE_SHOT)
     se_assert(roots);
@@ -188,7 +197,7 @@ void test_fft_helper(size_t degree, const double complex *v, double complex *tem
 #endif
 
     // -- Note: 'roots' will be ignored if SE_IFFT_OTF is chosen
-    ifft_inpl(v_fft, n, logn, roots);
+    ifft_inpl(v_fft, n, logn, roots_ptr);
     print_poly_double_complex("vec (after ifft)  ", v_fft, n);
 
     poly_div_inpl_complex(v_fft, n, n);
@@ -348,6 +357,280 @@ void test_fft(size_t n)
 #endif
 }
 
+/**
+Reference IFFT for the on-the-fly IFFT tests. Same butterflies as ifft_inpl, but every root is
+computed exactly.
+
+@param[in,out] vec   Input/Output vector of n double complex values
+@param[in]     n     IFFT transform size
+@param[in]     logn  log2(n)
+*/
+static void ifft_exact_ref_inpl(double complex *vec, size_t n, size_t logn)
+{
+    for (size_t tt = 1, h = n / 2; h > 0; tt *= 2, h /= 2)
+    {
+        for (size_t j = 0, kstart = 0; j < h; j++, kstart += 2 * tt)
+        {
+            double angle     = M_PI * (double)bitrev(h + j, logn) / (double)n;
+            double complex s = (double complex)_complex(cos(angle), -sin(angle));
+            for (size_t k = kstart; k < (kstart + tt); k++)
+            {
+                double complex u = vec[k];
+                double complex w = vec[k + tt];
+                vec[k]           = u + w;
+                vec[k + tt]      = (u - w) * s;
+            }
+        }
+    }
+}
+
+/**
+Checks that the "on-the-fly" IFFT, which derives most of its twiddle factors by recurrence (see:
+SE_IFFT_OTF_RESYNC_INTERVAL), matches an IFFT that uses exactly computed roots.
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ifft_otf(size_t n)
+{
+#ifndef SE_IFFT_OTF
+    SE_UNUSED(n);
+    printf("IFFT type is not on-the-fly. Skipping on-the-fly IFFT test.\n");
+#else
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+    size_t logn = (size_t)log2(n);
+
+#ifdef SE_USE_MALLOC
+    double complex *mempool = calloc(2 * n, sizeof(double complex));
+#else
+    double complex mempool[2 * SE_DEGREE_N];
+    memset(&mempool, 0, 2 * n * sizeof(double complex));
+#endif
+    double complex *v     = &(mempool[0]);
+    double complex *v_ref = &(mempool[n]);
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    print_test_banner("ifft on-the-fly", &parms);
+
+    for (size_t testnum = 0; testnum < 3; testnum++)
+    {
+        printf("\n--------------- Test: %zu -----------------\n", testnum);
+        switch (testnum)
+        {
+            case 0: set_double_complex(v, n, 1); break;
+            case 1: gen_double_complex_vec(v, 1000, n); break;
+            case 2: gen_double_complex_half_vec(v, pow(10, 6), n); break;
+        }
+        memcpy(v_ref, v, n * sizeof(double complex));
+
+        ifft_exact_ref_inpl(v_ref, n, logn);
+        ifft_inpl(v, n, logn, 0);
+        print_poly_double_complex("ifft (exact roots)", v_ref, n);
+        print_poly_double_complex("ifft (on-the-fly) ", v, n);
+
+        // -- Outputs grow up to n times the input magnitude, so compare relative to the largest
+        double maxval = 0;
+        for (size_t i = 0; i < n; i++) maxval = fmax(maxval, cabs(v_ref[i]));
+        bool err = compare_poly_double_complex(v, v_ref, n, 1e-12 * (maxval + 1));
+        se_assert(!err);
+    }
+    delete_parameters(&parms);
+#ifdef SE_USE_MALLOC
+    free(mempool);
+#endif
+#endif
+}
+
+/**
+Sets the second half of vec so that vec is conjugate-symmetric as seen by ifft_real_inpl (i.e.,
+vec[n - 1 - i] = conj(vec[i])), and copies the first half into vec_split (real parts, then
+imaginary parts).
+
+@param[in,out] vec        Vector of n double complex values. First half is input.
+@param[in]     n          Number of values in vec
+@param[out]    vec_split  [Optional]. Storage for n double values
+*/
+static void set_conj_symmetric(double complex *vec, size_t n, double *vec_split)
+{
+    for (size_t i = 0; i < n / 2; i++)
+    {
+        vec[n - 1 - i] = se_conj(vec[i]);
+        if (vec_split)
+        {
+            vec_split[i]         = se_creal(vec[i]);
+            vec_split[i + n / 2] = se_cimag(vec[i]);
+        }
+    }
+}
+
+/**
+Checks that the real-input IFFT (as used by the encoder) matches the full IFFT on conjugate-
+symmetric inputs, down to the last encoded (i.e., scaled and rounded) coefficient.
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ifft_real(size_t n)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+    size_t logn = (size_t)log2(n);
+
+#ifdef SE_USE_MALLOC
+    double complex *v = calloc(n, sizeof(double complex));
+    double *v_real    = calloc(n, sizeof(double));
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
+    double complex *roots = calloc(n, sizeof(double complex));
+#else
+    double complex *roots = 0;
+#endif
+#else
+    double complex v[SE_DEGREE_N];
+    double v_real[SE_DEGREE_N];
+    memset(&v, 0, n * sizeof(double complex));
+    memset(&v_real, 0, n * sizeof(double));
+#if defined(SE_IFFT_LOAD_FULL) || defined(SE_IFFT_ONE_SHOT)
+    double complex roots[SE_DEGREE_N];
+    memset(&roots, 0, n * sizeof(double complex));
+#else
+    double complex *roots = 0;
+#endif
+#endif
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    print_test_banner("ifft real input", &parms);
+
+    const double complex *roots_ptr = roots;
+#ifdef SE_IFFT_LOAD_FULL
+    roots_ptr = load_ifft_roots(n, roots);
+#elif defined(SE_IFFT_ONE_SHOT)
+    calc_ifft_roots(n, logn, roots);
+#endif
+
+    for (size_t testnum = 0; testnum < 4; testnum++)
+    {
+        printf("\n--------------- Test: %zu -----------------\n", testnum);
+        switch (testnum)
+        {
+            case 0: set_double_complex(v, n, 1); break;
+            case 1: gen_double_complex_vec(v, pow(10, 6), n); break;
+            case 2: gen_double_complex_half_vec(v, pow(10, 8), n); break;
+            case 3: gen_double_complex_vec(v, pow(10, 9), n); break;
+        }
+        set_conj_symmetric(v, n, v_real);
+
+        ifft_inpl(v, n, logn, roots_ptr);
+        ifft_real_inpl(v_real, n, logn, roots_ptr);
+        print_poly_double_complex("ifft (full)", v, n);
+        print_poly_double("ifft (real)", v_real, n);
+
+        double maxval = 0, maxdiff = 0;
+        for (size_t i = 0; i < n; i++) maxval = fmax(maxval, cabs(v[i]));
+
+        size_t n_coeff_diff = 0;
+        double n_inv        = parms.scale / (double)n;
+        for (size_t i = 0; i < n; i++)
+        {
+            // -- Full output is real, and twice the output of the real-input ifft
+            maxdiff = fmax(maxdiff, fabs(se_cimag(v[i])));
+            maxdiff = fmax(maxdiff, fabs(se_creal(v[i]) - 2 * v_real[i]));
+            if (round(se_creal(v[i]) * n_inv) != round(2 * v_real[i] * n_inv)) n_coeff_diff++;
+        }
+        printf("max |ifft|: %0.6f\n", maxval);
+        printf("max error : %g\n", maxdiff);
+        printf("# of differing coefficients: %zu\n", n_coeff_diff);
+        se_assert(maxdiff <= 1e-12 * (maxval + 1));
+        se_assert(n_coeff_diff == 0);
+    }
+    delete_parameters(&parms);
+#ifdef SE_USE_MALLOC
+    free(v);
+    free(v_real);
+    if (roots) free(roots);
+#endif
+}
+
+/**
+Checks the accuracy of the single precision IFFT (see: SE_IFFT_PRECISION_TYPE) against the error
+analysis in user_defines.h. The IFFT outputs must be within log2(n) * 2^-23 (relative to the
+largest output) of an exactly computed IFFT, and so the encoded coefficients (i.e., outputs
+multiplied by scale / n and rounded) must be within log2(n) * 2^-23 * max|output| * scale / n + 1.
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ifft_float(size_t n)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+    size_t logn = (size_t)log2(n);
+
+#ifdef SE_USE_MALLOC
+    double complex *v_ref = calloc(n, sizeof(double complex));
+    double *v_split       = calloc(n, sizeof(double));
+    float *v              = calloc(n, sizeof(float));
+#else
+    double complex v_ref[SE_DEGREE_N];
+    double v_split[SE_DEGREE_N];
+    float v[SE_DEGREE_N];
+    memset(&v_ref, 0, n * sizeof(double complex));
+    memset(&v_split, 0, n * sizeof(double));
+    memset(&v, 0, n * sizeof(float));
+#endif
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    print_test_banner("ifft single precision", &parms);
+
+    for (size_t testnum = 0; testnum < 4; testnum++)
+    {
+        printf("\n--------------- Test: %zu -----------------\n", testnum);
+        switch (testnum)
+        {
+            case 0: set_double_complex(v_ref, n, 1); break;
+            case 1: gen_double_complex_vec(v_ref, 10, n); break;
+            case 2: gen_double_complex_vec(v_ref, 1000, n); break;
+            case 3: gen_double_complex_half_vec(v_ref, pow(10, 6), n); break;
+        }
+        set_conj_symmetric(v_ref, n, v_split);
+        for (size_t i = 0; i < n; i++) v[i] = (float)v_split[i];
+
+        ifft_exact_ref_inpl(v_ref, n, logn);
+        ifft_real_float_inpl(v, n, logn);
+
+        double maxval = 0, maxdiff = 0, max_coeff_diff = 0;
+        double n_inv = parms.scale / (double)n;
+        for (size_t i = 0; i < n; i++)
+        {
+            // -- Outputs of the real-input ifft are half of the (real) outputs of the full ifft
+            double out        = 2 * (double)v[i];
+            maxval            = fmax(maxval, cabs(v_ref[i]));
+            maxdiff           = fmax(maxdiff, cabs(v_ref[i] - out));
+            double coeff_diff = round(se_creal(v_ref[i]) * n_inv) - round(out * n_inv);
+            max_coeff_diff    = fmax(max_coeff_diff, fabs(coeff_diff));
+        }
+        double bound       = (double)logn * FLT_EPSILON * maxval;
+        double coeff_bound = bound * n_inv + 1;
+        printf("max |ifft|: %0.6f\n", maxval);
+        printf("max error : %0.6f (bound: %0.6f)\n", maxdiff, bound);
+        printf("max coeff error: %0.1f (bound: %0.1f)\n", max_coeff_diff, coeff_bound);
+        se_assert(maxdiff <= bound);
+        se_assert(max_coeff_diff <= coeff_bound);
+    }
+    delete_parameters(&parms);
+#ifdef SE_USE_MALLOC
+    free(v_ref);
+    free(v_split);
+    free(v);
+#endif
+}
+
 #ifndef SE_USE_MALLOC
 #ifdef IFFT_TEST_ROOTS_MEM
 #undef IFFT_TEST_ROOTS_MEM
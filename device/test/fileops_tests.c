@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/*
+@file fileops_tests.c
+
+Tests for the data loaders (see: fileops.h). Checks that each loader returns the passed buffer, or a
+pointer into code memory (without writing the buffer) if SE_DATA_FROM_CODE_DIRECT is defined, and
+that the data read through the returned pointer gives the same results as a copy in RAM.
+*/
+
+#include <stdlib.h>  // calloc
+#include <string.h>  // memset, memcpy
+
+#include "ckks_asym.h"
+#include "ckks_common.h"
+#include "ckks_sym.h"
+#include "defines.h"
+#include "fileops.h"
+#include "ntt.h"
+#include "test_common.h"
+#include "util_print.h"  // printf
+
+// -- Byte value the buffers are filled with before each load
+#define SE_FILEOPS_TEST_FILL 0xA5
+
+// -- Keys are only available if they are stored in a file or defined in code
+#if !defined(SE_DATA_FROM_CODE_COPY) && !defined(SE_DATA_FROM_CODE_DIRECT)
+#define SE_FILEOPS_TEST_SK
+#define SE_FILEOPS_TEST_PK
+#else
+#ifdef SE_DEFINE_SK_DATA
+#define SE_FILEOPS_TEST_SK
+#endif
+#ifdef SE_DEFINE_PK_DATA
+#define SE_FILEOPS_TEST_PK
+#endif
+#endif
+
+/**
+Checks the pointer returned by a loader. If SE_DATA_FROM_CODE_DIRECT is defined, the loader must
+return a pointer other than 'buf' and leave 'buf' untouched. Otherwise, it must return 'buf'.
+
+@param[in] name   Name of the loaded data (for printing)
+@param[in] ret    Pointer returned by the loader
+@param[in] buf    Buffer passed to the loader (filled with SE_FILEOPS_TEST_FILL before the load)
+@param[in] bytes  Size of 'buf' in bytes
+*/
+static void check_load_ptr(const char *name, const void *ret, const void *buf, size_t bytes)
+{
+    printf("Checking load of %s...\n", name);
+    se_assert(ret);
+#ifdef SE_DATA_FROM_CODE_DIRECT
+    se_assert(ret != buf);
+    const uint8_t *buf_bytes = (const uint8_t *)buf;
+    for (size_t i = 0; i < bytes; i++) se_assert(buf_bytes[i] == SE_FILEOPS_TEST_FILL);
+#else
+    se_assert(ret == buf);
+    SE_UNUSED(bytes);
+#endif
+}
+
+/**
+Tests the data loaders.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is not defined)
+@param[in] nprimes  Number of primes (ignored if SE_USE_MALLOC is not defined)
+*/
+void test_fileops(size_t n, size_t nprimes)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);
+    n       = SE_DEGREE_N;
+    nprimes = SE_NPRIMES;
+#endif
+    printf("\n******************************************\n");
+    printf("Beginning test for data loaders...\n");
+
+    Parms parms;
+    set_parms_ckks(n, nprimes, &parms);
+    parms.is_asymmetric = true;
+    parms.pk_from_file  = true;
+    parms.small_s       = true;
+    parms.small_u       = true;
+
+    // -- Layout (in units of n ZZ values):
+    //     0: load buffer (4, enough for n double complex values)
+    //     4: reference copy (1)
+    //     5: two ciphertexts (2 each)
+    //     9: ntt_pte (1)
+    //    10: ntt roots (2)
+    //    12: asymmetric encryption inputs: conj_vals_int (2), u (1), e1 (1/4)
+    //    16: pk_cache (2 per prime)
+    size_t mempool_size = (16 + 2 * nprimes) * n;
+#ifdef SE_USE_MALLOC
+    ZZ *mempool = calloc(mempool_size, sizeof(ZZ));
+#else
+    static ZZ mempool[(16 + 2 * SE_NPRIMES) * SE_DEGREE_N];
+    memset(mempool, 0, mempool_size * sizeof(ZZ));
+#endif
+    se_assert(mempool);
+    se_assert(4 * sizeof(ZZ) >= sizeof(double complex));
+    se_assert(2 * sizeof(ZZ) >= sizeof(int64_t));
+
+#if defined(SE_INDEX_MAP_LOAD) || defined(SE_INDEX_MAP_LOAD_PERSIST) || \
+    defined(SE_INDEX_MAP_LOAD_PERSIST_SYM_LOAD_ASYM)
+    // -- Index map: must match the computed one
+    {
+        uint16_t *map_buf = (uint16_t *)mempool;
+        uint16_t *map_ref = (uint16_t *)&(mempool[4 * n]);
+        memset(map_buf, SE_FILEOPS_TEST_FILL, n * sizeof(uint16_t));
+        const uint16_t *map = load_index_map(&parms, map_buf);
+        check_load_ptr("index map", map, map_buf, n * sizeof(uint16_t));
+        ckks_calc_index_map(&parms, map_ref);
+        for (size_t i = 0; i < n; i++) se_assert(map[i] == map_ref[i]);
+    }
+#endif
+
+#ifdef SE_IFFT_LOAD_FULL
+    // -- IFFT roots: the values are checked by the FFT tests, which use the loaded roots directly
+    {
+        double complex *roots_buf = (double complex *)mempool;
+        memset(roots_buf, SE_FILEOPS_TEST_FILL, n * sizeof(double complex));
+        const double complex *roots = load_ifft_roots(n, roots_buf);
+        check_load_ptr("ifft roots", roots, roots_buf, n * sizeof(double complex));
+    }
+#endif
+
+#if defined(SE_NTT_REG) || defined(SE_NTT_FAST)
+    // -- NTT roots: the values are checked by the NTT tests, which use the loaded roots directly
+    for (size_t i = 0; i < nprimes; i++)
+    {
+        ZZ *buf = mempool;
+        memset(buf, SE_FILEOPS_TEST_FILL, 2 * n * sizeof(ZZ));
+#ifdef SE_NTT_REG
+        const ZZ *roots = load_ntt_roots(&parms, buf);
+        check_load_ptr("ntt roots", roots, buf, n * sizeof(ZZ));
+#else
+        const MUMO *roots = load_ntt_fast_roots(&parms, (MUMO *)buf);
+        check_load_ptr("ntt fast roots", roots, buf, 2 * n * sizeof(ZZ));
+#endif
+        if (i + 1 < nprimes) ckks_next_prime_asym(&parms, NULL);
+    }
+    ckks_reset_primes(&parms);
+#endif
+
+#ifdef SE_FILEOPS_TEST_SK
+    // -- Secret key: the NTT form must match the one computed from a copy in RAM
+    {
+        ZZ *buf       = mempool;
+        ZZ *s_copy    = &(mempool[4 * n]);
+        ZZ *ntt_s     = &(mempool[5 * n]);
+        ZZ *ntt_s_ref = &(mempool[7 * n]);
+        ZZ *ntt_roots = ntt_roots_size(n) ? &(mempool[10 * n]) : NULL;
+
+        memset(buf, SE_FILEOPS_TEST_FILL, n / 16 * sizeof(ZZ));
+        const ZZ *s = load_sk(&parms, buf);
+        check_load_ptr("sk", s, buf, n / 16 * sizeof(ZZ));
+        memcpy(s_copy, s, n / 16 * sizeof(ZZ));
+        for (size_t i = 0; i < nprimes; i++)
+        {
+            ckks_calc_ntt_s_sym(&parms, s, ntt_roots, ntt_s);
+            ckks_calc_ntt_s_sym(&parms, s_copy, ntt_roots, ntt_s_ref);
+            compare_poly("ntt(s) (loaded)", ntt_s, "ntt(s) (copy)", ntt_s_ref, n);
+            if (i + 1 < nprimes) ckks_next_prime_asym(&parms, NULL);
+        }
+        ckks_reset_primes(&parms);
+    }
+#endif
+
+#ifdef SE_FILEOPS_TEST_PK
+    // -- Public key: the ciphertexts must match the ones computed from a copy in RAM
+    {
+        ZZ *buf           = mempool;
+        ZZ *c0            = &(mempool[5 * n]);
+        ZZ *c1            = &(mempool[6 * n]);
+        ZZ *c0_ref        = &(mempool[7 * n]);
+        ZZ *c1_ref        = &(mempool[8 * n]);
+        ZZ *ntt_pte       = &(mempool[9 * n]);
+        ZZ *ntt_roots     = ntt_roots_size(n) ? &(mempool[10 * n]) : NULL;
+        int64_t *vals_int = (int64_t *)&(mempool[12 * n]);
+        ZZ *u             = &(mempool[14 * n]);
+        int8_t *e1        = (int8_t *)&(mempool[15 * n]);
+        ZZ *pk_cache      = &(mempool[16 * n]);
+
+        for (size_t i = 0; i < nprimes; i++)
+        {
+            for (size_t j = 0; j < 2; j++)
+            {
+                memset(buf, SE_FILEOPS_TEST_FILL, n * sizeof(ZZ));
+                const ZZ *pki = load_pki(j, &parms, buf);
+                check_load_ptr("pk", pki, buf, n * sizeof(ZZ));
+                memcpy(&(pk_cache[(2 * i + j) * n]), pki, n * sizeof(ZZ));
+            }
+            if (i + 1 < nprimes) ckks_next_prime_asym(&parms, NULL);
+        }
+        ckks_reset_primes(&parms);
+
+        SE_PRNG prng;
+        for (size_t i = 0; i < n; i++) vals_int[i] = (int64_t)(i % 64) - 32;
+        ckks_asym_init(&parms, NULL, &prng, vals_int, u, e1);
+        for (size_t i = 0; i < nprimes; i++)
+        {
+            memset(c0, SE_FILEOPS_TEST_FILL, n * sizeof(ZZ));
+            memset(c1, SE_FILEOPS_TEST_FILL, n * sizeof(ZZ));
+            ckks_encode_encrypt_asym(&parms, vals_int, u, e1, NULL, ntt_roots, ntt_pte, NULL, NULL,
+                                     c0, c1);
+            ckks_encode_encrypt_asym(&parms, vals_int, u, e1, pk_cache, ntt_roots, ntt_pte, NULL,
+                                     NULL, c0_ref, c1_ref);
+            compare_poly("c0 (loaded)", c0, "c0 (copy)", c0_ref, n);
+            compare_poly("c1 (loaded)", c1, "c1 (copy)", c1_ref, n);
+            if (i + 1 < nprimes) ckks_next_prime_asym(&parms, parms.small_u ? NULL : u);
+        }
+    }
+#endif
+
+#ifdef SE_USE_MALLOC
+    free(mempool);
+#endif
+    delete_parameters(&parms);
+
+    printf("...done with test for data loaders.\n");
+    printf("******************************************\n");
+}
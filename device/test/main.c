@@ -20,13 +20,25 @@ extern void test_mult_uint(void);
 extern void test_add_mod(void);
 extern void test_neg_mod(void);
 extern void test_mul_mod(void);
+extern void test_prng_fill_buffer_x4(void);
+extern void test_prng_stream(void);
+extern void test_prng_backends(void);
 extern void test_sample_poly_uniform(size_t n);
+extern void test_sample_poly_uniform_rejection(size_t n);
+extern void test_sample_poly_cbd(size_t n);
 extern void test_sample_poly_ternary(size_t n);
 extern void test_sample_poly_ternary_small(size_t n);
 extern void test_barrett_reduce(void);
 extern void test_barrett_reduce_wide(void);
 extern void test_poly_mult_ntt(size_t n, size_t nprimes);
+extern void test_ntt_lazy_fused(size_t n, size_t nprimes);
+extern void test_ntt_simd(size_t n, size_t nprimes);
+extern void test_ntt_merged(size_t n, size_t nprimes);
+extern void test_poly_arith_simd(size_t n, size_t nprimes);
 extern void test_fft(size_t n);
+extern void test_ifft_otf(size_t n);
+extern void test_ifft_real(size_t n);
+extern void test_ifft_float(size_t n);
 extern void test_enc_zero_sym(size_t n, size_t nprimes);
 extern void test_enc_zero_asym(size_t n, size_t nprimes);
 extern void test_ckks_encode(size_t n);
@@ -34,6 +46,14 @@ extern void test_ckks_encode_encrypt_sym(size_t n, size_t nprimes);
 extern void test_ckks_encode_encrypt_asym(size_t n, size_t nprimes);
 extern void test_ckks_api_sym(void);
 extern void test_ckks_api_asym(void);
+extern void test_ckks_api_contexts(size_t n, size_t nprimes);
+extern void test_ckks_api_batch(size_t n, size_t nprimes);
+extern void test_ckks_api_stream(size_t n, size_t nprimes);
+extern void test_ckks_api_prime_tasks(size_t n, size_t nprimes);
+extern void test_ckks_api_pipeline(size_t n, size_t nprimes);
+extern void test_poly_pack(size_t n);
+extern void test_mempool_layout(size_t n, size_t nprimes);
+extern void test_fileops(size_t n, size_t nprimes);
 
 #ifdef SE_ON_SPHERE_M4
 #include "mt3620.h"
@@ -99,7 +119,12 @@ int main(void)
     const size_t nprimes = SE_NPRIMES;
 #endif
 
+    test_prng_fill_buffer_x4();
+    test_prng_stream();
+    test_prng_backends();
     test_sample_poly_uniform(n);
+    test_sample_poly_uniform_rejection(n);
+    test_sample_poly_cbd(n);
     test_sample_poly_ternary(n);
     test_sample_poly_ternary_small(n);  // Only useful when SE_USE_MALLOC is defined
 
@@ -117,17 +142,33 @@ int main(void)
     //    because it uses schoolbook multiplication
     // -- Comment it out unless you need to test it
     // test_poly_mult_ntt(n, nprimes);
+    test_ntt_lazy_fused(n, nprimes);
+    test_ntt_simd(n, nprimes);
+    test_ntt_merged(n, nprimes);
+    test_poly_arith_simd(n, nprimes);
 
     test_fft(n);
+    test_ifft_otf(n);
+    test_ifft_real(n);
+    test_ifft_float(n);
 
     test_enc_zero_sym(n, nprimes);
     test_enc_zero_asym(n, nprimes);
 
     test_ckks_encode(n);
 
+    test_poly_pack(n);
+    test_mempool_layout(n, nprimes);
+    test_fileops(n, nprimes);
+
     // -- Main tests
     test_ckks_encode_encrypt_sym(n, nprimes);
     test_ckks_encode_encrypt_asym(n, nprimes);
+    test_ckks_api_contexts(n, nprimes);
+    test_ckks_api_batch(n, nprimes);
+    test_ckks_api_stream(n, nprimes);
+    test_ckks_api_prime_tasks(n, nprimes);
+    test_ckks_api_pipeline(n, nprimes);
 
     // -- Run these tests to verify api
     // -- Check the result with the adapter by writing output to a text file
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/*
+@file mempool_tests.c
+
+Tests for the memory pool layout (see: mempool.h).
+*/
+
+#include "ckks_asym.h"
+#include "ckks_common.h"
+#include "ckks_sym.h"
+#include "defines.h"
+#include "mempool.h"
+#include "test_common.h"
+#include "util_print.h"  // printf
+
+/**
+Checks the layout of the memory pool for one mode: every buffer is inside the pool, and two buffers
+that are live in the same phase only overlap if one is computed in place on the other. Also checks
+that ckks_set_ptrs_sym/asym hand out the same buffers, and that c0 and c1 are placed right after
+conj_vals_int (which the encryption functions rely on).
+
+@param[in] n        Polynomial ring degree
+@param[in] nprimes  Number of primes
+@param[in] sym      Set to 1 for the symmetric mode layout, 0 for the asymmetric one
+*/
+static void test_mempool_layout_mode(size_t n, size_t nprimes, bool sym)
+{
+    SE_MEMPOOL_BUF bufs[SE_MP_NBUFS];
+    size_t mempool_size = se_mempool_layout(n, nprimes, sym, bufs);
+    se_print_mempool_layout(n, nprimes, sym);
+
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        if (!bufs[i].size) continue;
+        se_assert(bufs[i].offset + bufs[i].size <= mempool_size);
+        if (bufs[i].on != SE_MP_ID_none)
+        {
+            se_assert(bufs[bufs[i].on].size);
+            se_assert(bufs[i].offset == bufs[bufs[i].on].offset);
+        }
+
+        for (size_t j = 0; j < i; j++)
+        {
+            if (!bufs[j].size || !(bufs[i].live & bufs[j].live)) continue;
+            bool overlap = (bufs[i].offset < bufs[j].offset + bufs[j].size) &&
+                           (bufs[j].offset < bufs[i].offset + bufs[i].size);
+            if (overlap && bufs[i].on != (SE_MP_ID)j)
+            {
+                printf("Error! %s overlaps %s\n", bufs[i].name, bufs[j].name);
+                se_assert(0);
+            }
+        }
+    }
+    se_assert(bufs[SE_MP_ID_c1].offset == bufs[SE_MP_ID_conj_vals_int].offset + 2 * n);
+    se_assert(bufs[SE_MP_ID_c0].offset == bufs[SE_MP_ID_c1].offset + n);
+
+#ifdef SE_USE_MALLOC
+    se_assert(mempool_size == (sym ? ckks_get_mempool_size_sym(n, nprimes)
+                                   : ckks_get_mempool_size_asym(n, nprimes)));
+    ZZ *mempool = sym ? ckks_mempool_setup_sym(n, nprimes) : ckks_mempool_setup_asym(n, nprimes);
+#else
+    se_assert(mempool_size == (sym ? MEMPOOL_SIZE_sym : MEMPOOL_SIZE_Asym));
+    static ZZ mempool[MEMPOOL_SIZE];
+#ifdef SE_ENCRYPT_TYPE_SYMMETRIC
+    if (!sym) return;
+#else
+    if (sym) return;
+#endif
+#endif
+
+    SE_PTRS se_ptrs;
+    if (sym)
+        ckks_set_ptrs_sym(n, mempool, &se_ptrs);
+    else
+        ckks_set_ptrs_asym(n, mempool, &se_ptrs);
+
+    const void *ptrs[SE_MP_NBUFS] = {0};
+    ptrs[SE_MP_ID_conj_vals]      = se_ptrs.conj_vals;
+    ptrs[SE_MP_ID_conj_vals_int]  = se_ptrs.conj_vals_int_ptr;
+    ptrs[SE_MP_ID_c1]             = se_ptrs.c1_ptr;
+    ptrs[SE_MP_ID_c0]             = se_ptrs.c0_ptr;
+    ptrs[SE_MP_ID_ifft_roots]     = se_ptrs.ifft_roots;
+    ptrs[SE_MP_ID_ntt_roots]      = se_ptrs.ntt_roots_ptr;
+    ptrs[SE_MP_ID_ntt_pte]        = se_ptrs.ntt_pte_ptr;
+    ptrs[SE_MP_ID_e1]             = se_ptrs.e1_ptr;
+    ptrs[SE_MP_ID_values]         = se_ptrs.values;
+    ptrs[SE_MP_ID_ntt_s]          = se_ptrs.ntt_s_ptr;
+    ptrs[SE_MP_ID_pk]             = se_ptrs.pk_ptr;
+    ptrs[bufs[SE_MP_ID_index_map].size ? SE_MP_ID_index_map : SE_MP_ID_index_map_persist] =
+        se_ptrs.index_map_ptr;
+    ptrs[bufs[SE_MP_ID_ternary].size ? SE_MP_ID_ternary : SE_MP_ID_ternary_persist] =
+        se_ptrs.ternary;
+
+    for (size_t i = 0; i < SE_MP_NBUFS; i++)
+    {
+        const void *exp_ptr = bufs[i].size ? &(mempool[bufs[i].offset]) : NULL;
+        se_assert(ptrs[i] == exp_ptr);
+    }
+
+#ifdef SE_USE_MALLOC
+    free(mempool);
+#endif
+}
+
+/**
+Tests the memory pool layout in both modes.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is not defined)
+@param[in] nprimes  Number of primes (ignored if SE_USE_MALLOC is not defined)
+*/
+void test_mempool_layout(size_t n, size_t nprimes)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);
+    n       = SE_DEGREE_N;
+    nprimes = SE_NPRIMES;
+#endif
+    printf("\n******************************************\n");
+    printf("Beginning test for memory pool layout...\n");
+
+    test_mempool_layout_mode(n, nprimes, 1);
+    test_mempool_layout_mode(n, nprimes, 0);
+
+    printf("...done with test for memory pool layout.\n");
+    printf("******************************************\n");
+}
@@ -11,9 +11,12 @@
 #include <stdio.h>
 #include <string.h>  // memset
 
+#include "fileops.h"
 #include "intt.h"
 #include "ntt.h"
+#include "ntt_simd.h"
 #include "parameters.h"
+#include "polymodarith.h"
 #include "polymodmult.h"
 #include "test_common.h"
 #include "uintmodarith.h"
@@ -315,6 +318,475 @@ void test_poly_mult_ntt(size_t n, size_t nprimes)
 #endif
     delete_parameters(&parms);
 }
+
+/**
+Checks that the fused pipeline used to compute [-a*s + m + e]_Rq (i.e., ntt_lazy_out_inpl followed
+by poly_mul_neg_add_mod, or ntt_inpl followed by poly_mul_neg_mod and poly_add_mod_inpl) matches the
+unfused sequence
+of ntt_inpl, poly_mult_mod_ntt_form_inpl, poly_neg_mod_inpl, and poly_add_mod_inpl.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+@param[in] nprimes  # of modulus primes    (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ntt_lazy_fused(size_t n, size_t nprimes)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+    if (nprimes != SE_NPRIMES) nprimes = SE_NPRIMES;
+#endif
+
+    printf("**********************************\n\n");
+    printf("Beginning tests for lazy ntt + fused arithmetic");
+    printf("....\n\n");
+
+    Parms parms;
+    set_parms_ckks(n, nprimes, &parms);
+    print_test_banner("Lazy Ntt + Fused Arith", &parms);
+
+#ifdef SE_NTT_OTF
+    size_t ntt_roots_size = 0;
+#elif defined(SE_NTT_REG) || defined(SE_NTT_ONE_SHOT)
+    size_t ntt_roots_size = n;
+#else  // defined(SE_NTT_FAST)
+    size_t ntt_roots_size = 2 * n;
+#endif
+
+    // ------------------
+    //	Initialize memory
+    // ------------------
+    size_t mempool_size = 5 * n + ntt_roots_size;
+#ifdef SE_USE_MALLOC
+    ZZ *mempool = calloc(mempool_size, sizeof(ZZ));
+#else
+    ZZ mempool_local[5 * SE_DEGREE_N + NTT_TESTS_ROOTS_MEM];
+    ZZ *mempool = &(mempool_local[0]);
+    memset(mempool, 0, mempool_size * sizeof(ZZ));
+#endif
+
+    // clang-format off
+    size_t idx = 0;  // start index
+    ZZ *ntt_s     = &(mempool[idx]);                       idx += n;
+    ZZ *a         = &(mempool[idx]);                       idx += n;
+    ZZ *pte       = &(mempool[idx]);                       idx += n;
+    ZZ *ref_res   = &(mempool[idx]);                       idx += n;
+    ZZ *fused_res = &(mempool[idx]);                       idx += n;
+    ZZ *ntt_roots = ntt_roots_size ? &(mempool[idx]) : 0;  idx += ntt_roots_size;
+    se_assert(idx == mempool_size);
+    // clang-format on
+
+    while (1)
+    {
+        ntt_roots_initialize(&parms, ntt_roots);
+        Modulus *mod = parms.curr_modulus;
+        print_zz("Modulus", mod->value);
+
+        for (int testnum = 0; testnum < 3; testnum++)
+        {
+            printf("--------------- Test %d ------------------\n", testnum);
+            random_zzq_poly(ntt_s, n, mod);
+            random_zzq_poly(a, n, mod);
+            random_zzq_poly(pte, n, mod);
+            if (testnum == 1) set(pte, n, mod->value - 1);
+            if (testnum == 2) clear(ntt_s, n);
+
+            // -- Reference: ntt(pte) - ntt_s . a, with a full pass for each step
+            poly_mult_mod_ntt_form(ntt_s, a, n, mod, ref_res);
+            poly_neg_mod_inpl(ref_res, n, mod);
+            memcpy(fused_res, pte, n * sizeof(ZZ));
+            ntt_inpl(&parms, ntt_roots, fused_res);
+            poly_add_mod_inpl(ref_res, fused_res, n, mod);
+
+            // -- Single fused pass
+            ntt_lazy_out_inpl(&parms, ntt_roots, pte);
+            for (size_t i = 0; i < n; i++) se_assert(pte[i] < 4 * mod->value);
+            poly_mul_neg_add_mod(ntt_s, a, pte, n, mod, fused_res);
+            compare_poly("unfused", ref_res, "fused", fused_res, n);
+
+            // -- Fused multiply and negate only
+            poly_mul_neg_mod(ntt_s, a, n, mod, fused_res);
+            for (size_t i = 0; i < n; i++) pte[i] = reduce_lazy_4q(pte[i], mod->value);
+            poly_add_mod_inpl(fused_res, pte, n, mod);
+            compare_poly("unfused", ref_res, "fused (mul neg)", fused_res, n);
+        }
+        if ((parms.curr_modulus_idx + 1) < parms.nprimes)
+        {
+            bool ret = next_modulus(&parms);
+            se_assert(ret);
+        }
+        else
+            break;
+    }
+#ifdef SE_USE_MALLOC
+    if (mempool)
+    {
+        free(mempool);
+        mempool = 0;
+    }
+#endif
+    delete_parameters(&parms);
+    printf("...done with tests for lazy ntt + fused arithmetic.\n");
+}
+
+/**
+Checks that every SIMD NTT backend supported by the CPU produces output that is bit-identical to
+the scalar "fast" NTT. Does nothing if neither SE_NTT_SIMD_X86 nor SE_NTT_SIMD_ARM is defined.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+@param[in] nprimes  # of modulus primes    (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ntt_simd(size_t n, size_t nprimes)
+{
+#if !defined(SE_NTT_SIMD_X86) && !defined(SE_NTT_SIMD_ARM)
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+    printf("SIMD NTT is not enabled. Skipping SIMD NTT tests.\n");
+#else
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+    if (nprimes != SE_NPRIMES) nprimes = SE_NPRIMES;
+#endif
+
+    printf("**********************************\n\n");
+    printf("Beginning tests for simd ntt");
+    printf("....\n\n");
+
+    Parms parms;
+    set_parms_ckks(n, nprimes, &parms);
+    print_test_banner("Simd Ntt", &parms);
+
+#ifdef SE_NTT_SIMD_X86
+    SE_SIMD_LEVEL simd_level = ntt_simd_level();
+    printf("Simd level: %s\n", simd_level == SE_SIMD_AVX512 ? "AVX-512"
+                                : simd_level == SE_SIMD_AVX2 ? "AVX2"
+                                                             : "none");
+#endif
+
+    // ------------------
+    //	Initialize memory
+    // ------------------
+    size_t mempool_size = 3 * n + 2 * n;
+#ifdef SE_USE_MALLOC
+    ZZ *mempool = calloc(mempool_size, sizeof(ZZ));
+#else
+    ZZ mempool_local[5 * SE_DEGREE_N];
+    ZZ *mempool = &(mempool_local[0]);
+    memset(mempool, 0, mempool_size * sizeof(ZZ));
+#endif
+
+    // clang-format off
+    size_t idx = 0;  // start index
+    ZZ *a         = &(mempool[idx]); idx += n;
+    ZZ *ref_res   = &(mempool[idx]); idx += n;
+    ZZ *simd_res  = &(mempool[idx]); idx += n;
+    MUMO *ntt_roots_buf = (MUMO *)&(mempool[idx]); idx += 2 * n;
+    se_assert(idx == mempool_size);
+    // clang-format on
+
+    while (1)
+    {
+        // -- The backends are called directly, so use the roots as loaded (they may be read from
+        //    code directly, see: fileops.h)
+        const MUMO *ntt_roots = load_ntt_fast_roots(&parms, ntt_roots_buf);
+        print_zz("Modulus", parms.curr_modulus->value);
+        Modulus *mod = parms.curr_modulus;
+
+        for (int testnum = 0; testnum < 4; testnum++)
+        {
+            printf("--------------- Test %d ------------------\n", testnum);
+            switch (testnum)
+            {
+                case 0: clear(a, n); break;
+                case 1:
+                    clear(a, n);
+                    a[0] = 1;
+                    break;
+                case 2: set(a, n, mod->value - 1); break;  // largest reduced input
+                default: random_zzq_poly(a, n, mod); break;
+            }
+
+            memcpy(ref_res, a, n * sizeof(ZZ));
+            ntt_fast_ref_inpl(&parms, ntt_roots, ref_res);
+
+#ifdef SE_NTT_SIMD_X86
+            if (simd_level >= SE_SIMD_AVX2)
+            {
+                memcpy(simd_res, a, n * sizeof(ZZ));
+                ntt_fast_avx2_inpl(&parms, ntt_roots, simd_res);
+                compare_poly("ntt ref", ref_res, "ntt avx2", simd_res, n);
+            }
+            if (simd_level == SE_SIMD_AVX512)
+            {
+                memcpy(simd_res, a, n * sizeof(ZZ));
+                ntt_fast_avx512_inpl(&parms, ntt_roots, simd_res);
+                compare_poly("ntt ref", ref_res, "ntt avx512", simd_res, n);
+            }
+#else
+            memcpy(simd_res, a, n * sizeof(ZZ));
+            ntt_fast_arm_inpl(&parms, ntt_roots, simd_res);
+            compare_poly("ntt ref", ref_res, "ntt arm", simd_res, n);
+#endif
+
+            // -- The dispatcher should match as well
+            memcpy(simd_res, a, n * sizeof(ZZ));
+            ntt_inpl(&parms, (ZZ *)ntt_roots, simd_res);
+            compare_poly("ntt ref", ref_res, "ntt_inpl", simd_res, n);
+        }
+        if ((parms.curr_modulus_idx + 1) < parms.nprimes)
+        {
+            bool ret = next_modulus(&parms);
+            se_assert(ret);
+        }
+        else
+            break;
+    }
+#ifdef SE_USE_MALLOC
+    if (mempool)
+    {
+        free(mempool);
+        mempool = 0;
+    }
+#endif
+    delete_parameters(&parms);
+    printf("...done with tests for simd ntt.\n");
+#endif
+}
+
+/**
+Checks that the merged-layer "fast" NTT produces output that is bit-identical to the scalar "fast"
+NTT. Does nothing if SE_NTT_FAST_MERGED is not defined.
+
+Note: The first n/2 "fast" roots for degree n are exactly the "fast" roots for degree n/2, so the
+roots for n are also used to check degree n/2 (i.e., an odd number of levels if logn is even).
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+@param[in] nprimes  # of modulus primes    (ignored if SE_USE_MALLOC is defined)
+*/
+void test_ntt_merged(size_t n, size_t nprimes)
+{
+#ifndef SE_NTT_FAST_MERGED
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+    printf("Merged-layer NTT is not enabled. Skipping merged-layer NTT tests.\n");
+#else
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+    if (nprimes != SE_NPRIMES) nprimes = SE_NPRIMES;
+#endif
+
+    printf("**********************************\n\n");
+    printf("Beginning tests for merged-layer ntt");
+    printf("....\n\n");
+
+    Parms parms;
+    set_parms_ckks(n, nprimes, &parms);
+    print_test_banner("Merged-layer Ntt", &parms);
+
+    // ------------------
+    //	Initialize memory
+    // ------------------
+    size_t mempool_size = 3 * n + 2 * n;
+#ifdef SE_USE_MALLOC
+    ZZ *mempool = calloc(mempool_size, sizeof(ZZ));
+#else
+    ZZ mempool_local[5 * SE_DEGREE_N];
+    ZZ *mempool = &(mempool_local[0]);
+    memset(mempool, 0, mempool_size * sizeof(ZZ));
+#endif
+
+    // clang-format off
+    size_t idx = 0;  // start index
+    ZZ *a           = &(mempool[idx]); idx += n;
+    ZZ *ref_res     = &(mempool[idx]); idx += n;
+    ZZ *merged_res  = &(mempool[idx]); idx += n;
+    MUMO *ntt_roots_buf = (MUMO *)&(mempool[idx]); idx += 2 * n;
+    se_assert(idx == mempool_size);
+    // clang-format on
+
+    while (1)
+    {
+        const MUMO *ntt_roots = load_ntt_fast_roots(&parms, ntt_roots_buf);
+        print_zz("Modulus", parms.curr_modulus->value);
+        Modulus *mod = parms.curr_modulus;
+
+        for (size_t logn_diff = 0; logn_diff < 2; logn_diff++)
+        {
+            Parms parms_curr       = parms;
+            parms_curr.coeff_count = n >> logn_diff;
+            parms_curr.logn        = parms.logn - logn_diff;
+            size_t len             = parms_curr.coeff_count;
+            printf("Degree: %zu\n", len);
+
+            for (int testnum = 0; testnum < 3; testnum++)
+            {
+                printf("--------------- Test %d ------------------\n", testnum);
+                switch (testnum)
+                {
+                    case 0:
+                        clear(a, len);
+                        a[0] = 1;
+                        break;
+                    case 1: set(a, len, mod->value - 1); break;  // largest reduced input
+                    default: random_zzq_poly(a, len, mod); break;
+                }
+
+                memcpy(ref_res, a, len * sizeof(ZZ));
+                ntt_fast_ref_inpl(&parms_curr, ntt_roots, ref_res);
+
+                memcpy(merged_res, a, len * sizeof(ZZ));
+                ntt_fast_merged_inpl(&parms_curr, ntt_roots, merged_res);
+                compare_poly("ntt ref", ref_res, "ntt merged", merged_res, len);
+            }
+        }
+        if ((parms.curr_modulus_idx + 1) < parms.nprimes)
+        {
+            bool ret = next_modulus(&parms);
+            se_assert(ret);
+        }
+        else
+            break;
+    }
+#ifdef SE_USE_MALLOC
+    if (mempool)
+    {
+        free(mempool);
+        mempool = 0;
+    }
+#endif
+    delete_parameters(&parms);
+    printf("...done with tests for merged-layer ntt.\n");
+#endif
+}
+
+/**
+Checks that the SIMD polynomial arithmetic (see: polymodarith.h) produces output that is
+bit-identical to the scalar modular arithmetic functions. Does nothing if SE_SIMD_ARM is not
+defined.
+
+@param[in] n        Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+@param[in] nprimes  # of modulus primes    (ignored if SE_USE_MALLOC is defined)
+*/
+void test_poly_arith_simd(size_t n, size_t nprimes)
+{
+#ifndef SE_SIMD_ARM
+    SE_UNUSED(n);
+    SE_UNUSED(nprimes);
+    printf("SIMD polynomial arithmetic is not enabled. Skipping tests.\n");
+#else
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N && nprimes == SE_NPRIMES);  // sanity check
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+    if (nprimes != SE_NPRIMES) nprimes = SE_NPRIMES;
+#endif
+
+    printf("**********************************\n\n");
+    printf("Beginning tests for simd polynomial arithmetic");
+    printf("....\n\n");
+
+    Parms parms;
+    set_parms_ckks(n, nprimes, &parms);
+    print_test_banner("Simd Poly Arith", &parms);
+
+    // -- Use an odd length so that the scalar tail of each kernel is exercised too
+    size_t len          = n - 1;
+    size_t mempool_size = 5 * n;
+#ifdef SE_USE_MALLOC
+    ZZ *mempool = calloc(mempool_size, sizeof(ZZ));
+#else
+    ZZ mempool_local[5 * SE_DEGREE_N];
+    ZZ *mempool = &(mempool_local[0]);
+    memset(mempool, 0, mempool_size * sizeof(ZZ));
+#endif
+
+    // clang-format off
+    size_t idx = 0;  // start index
+    ZZ *a        = &(mempool[idx]); idx += n;
+    ZZ *b        = &(mempool[idx]); idx += n;
+    ZZ *ref_res  = &(mempool[idx]); idx += n;
+    ZZ *simd_res = &(mempool[idx]); idx += n;
+    ZZ *pair_res = &(mempool[idx]); idx += n;
+    se_assert(idx == mempool_size);
+    // clang-format on
+
+    while (1)
+    {
+        Modulus *mod = parms.curr_modulus;
+        print_zz("Modulus", mod->value);
+        for (int testnum = 0; testnum < 3; testnum++)
+        {
+            printf("--------------- Test %d ------------------\n", testnum);
+            switch (testnum)
+            {
+                case 0:
+                    clear(a, n);
+                    clear(b, n);
+                    break;
+                case 1:
+                    set(a, n, mod->value - 1);
+                    set(b, n, mod->value - 1);
+                    break;
+                default:
+                    random_zzq_poly(a, n, mod);
+                    random_zzq_poly(b, n, mod);
+                    break;
+            }
+
+            for (size_t i = 0; i < len; i++) ref_res[i] = add_mod(a[i], b[i], mod);
+            memcpy(simd_res, a, n * sizeof(ZZ));
+            poly_add_mod_inpl(simd_res, b, len, mod);
+            compare_poly("add ref", ref_res, "add simd", simd_res, len);
+
+            for (size_t i = 0; i < len; i++) ref_res[i] = neg_mod(a[i], mod);
+            memcpy(simd_res, a, n * sizeof(ZZ));
+            poly_neg_mod_inpl(simd_res, len, mod);
+            compare_poly("neg ref", ref_res, "neg simd", simd_res, len);
+
+            for (size_t i = 0; i < len; i++) ref_res[i] = mul_mod(a[i], b[i], mod);
+            memcpy(simd_res, a, n * sizeof(ZZ));
+            poly_mult_mod_ntt_form_inpl(simd_res, b, len, mod);
+            compare_poly("mul ref", ref_res, "mul simd", simd_res, len);
+
+            poly_pointwise_mul_mod_pair(a, b, a, len, mod, simd_res, pair_res);
+            for (size_t i = 0; i < len; i++) ref_res[i] = mul_mod(a[i], a[i], mod);
+            compare_poly("mul ref", ref_res, "mul pair simd (a)", simd_res, len);
+            for (size_t i = 0; i < len; i++) ref_res[i] = mul_mod(b[i], a[i], mod);
+            compare_poly("mul ref", ref_res, "mul pair simd (b)", pair_res, len);
+
+            for (size_t i = 0; i < len; i++) ref_res[i] = neg_mod(mul_mod(a[i], b[i], mod), mod);
+            poly_mul_neg_mod(a, b, len, mod, simd_res);
+            compare_poly("mul neg ref", ref_res, "mul neg simd", simd_res, len);
+
+            // -- Use 4q - 1 - b as a lazily reduced (i.e., in [0, 4q)) input
+            for (size_t i = 0; i < len; i++) pair_res[i] = 4 * mod->value - 1 - b[i];
+            for (size_t i = 0; i < len; i++)
+            {
+                ZZ prod    = mul_mod(a[i], b[i], mod);
+                ref_res[i] = sub_mod(reduce_lazy_4q(pair_res[i], mod->value), prod, mod);
+            }
+            poly_mul_neg_add_mod(a, b, pair_res, len, mod, simd_res);
+            compare_poly("mul neg add ref", ref_res, "mul neg add simd", simd_res, len);
+        }
+        if ((parms.curr_modulus_idx + 1) < parms.nprimes)
+        {
+            bool ret = next_modulus(&parms);
+            se_assert(ret);
+        }
+        else
+            break;
+    }
+#ifdef SE_USE_MALLOC
+    if (mempool)
+    {
+        free(mempool);
+        mempool = 0;
+    }
+#endif
+    delete_parameters(&parms);
+    printf("...done with tests for simd polynomial arithmetic.\n");
+#endif
+}
 #endif
 
 #ifdef SE_USE_MALLOC
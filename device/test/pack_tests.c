@@ -0,0 +1,96 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+/*
+@file pack_tests.c
+
+Tests for packing ciphertext components to the bit width of the modulus.
+*/
+
+#include <string.h>  // memcmp, memcpy
+
+#include "defines.h"
+#include "pack.h"
+#include "parameters.h"
+#include "test_common.h"
+#include "util_print.h"  // printf
+
+/**
+Reference implementation of poly_pack_inpl, one bit at a time and out of place.
+
+@param[in]  poly   Polynomial to pack
+@param[in]  n      Number of coefficients
+@param[in]  nbits  Bit width of each coefficient
+@param[out] out    Packed polynomial (poly_packed_byte_count(n, nbits) bytes)
+*/
+static void poly_pack_ref(const ZZ *poly, size_t n, size_t nbits, uint8_t *out)
+{
+    memset(out, 0, poly_packed_byte_count(n, nbits));
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t k = 0; k < nbits; k++)
+        {
+            size_t bit_pos = i * nbits + k;
+            out[bit_pos / 8] |= (uint8_t)(((poly[i] >> k) & 1) << (bit_pos % 8));
+        }
+    }
+}
+
+/**
+Tests that poly_pack_inpl matches the reference packing for every bit width (and for a number of
+coefficients that does not fill the last byte), and that poly_unpack_inpl reverses it.
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_poly_pack(size_t n)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+
+    printf("\n******************************************\n");
+    printf("Beginning test for poly pack...\n");
+
+#ifdef SE_USE_MALLOC
+    ZZ *poly         = calloc(2 * n, sizeof(ZZ));
+    ZZ *poly_orig    = &(poly[n]);
+    uint8_t *exp_out = calloc(n, sizeof(ZZ));
+#else
+    ZZ poly[SE_DEGREE_N];
+    ZZ poly_orig[SE_DEGREE_N];
+    uint8_t exp_out[SE_DEGREE_N * sizeof(ZZ)];
+#endif
+
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    size_t default_nbits = packed_bit_count(parms.curr_modulus);
+    print_zz("q", parms.curr_modulus->value);
+    printf("packed bit width: %zu\n", default_nbits);
+    se_assert(default_nbits == 27 || default_nbits == 30);
+
+    for (size_t nbits = 1; nbits <= 32; nbits++)
+    {
+        for (size_t len = n - 3; len <= n; len += 3)
+        {
+            ZZ mask = (nbits == 32) ? (ZZ)0xFFFFFFFF : (ZZ)((1UL << nbits) - 1);
+            for (size_t i = 0; i < len; i++) poly_orig[i] = random_zz() & mask;
+            memcpy(poly, poly_orig, len * sizeof(ZZ));
+
+            size_t nbytes = poly_pack_inpl(poly, len, nbits);
+            se_assert(nbytes == poly_packed_byte_count(len, nbits));
+            poly_pack_ref(poly_orig, len, nbits, exp_out);
+            se_assert(!memcmp(poly, exp_out, nbytes));
+
+            poly_unpack_inpl(poly, len, nbits);
+            se_assert(!memcmp(poly, poly_orig, len * sizeof(ZZ)));
+        }
+    }
+
+#ifdef SE_USE_MALLOC
+    free(exp_out);
+    free(poly);
+#endif
+    delete_parameters(&parms);
+    printf("...done with test for poly pack.\n");
+}
@@ -9,6 +9,8 @@ Various tests for sampling a polynomial from a distribution.
 
 #include <string.h>  // memcmp
 
+#include "aes256ctr.h"
+#include "chacha20.h"
 #include "ckks_common.h"
 #include "defines.h"
 #include "parameters.h"
@@ -67,7 +69,312 @@ void test_ternary_poly_stats(ZZ *s, size_t n)
     }
 }
 
-// TODO: Create tests for cbd sampling
+/**
+Reference cbd sample from 6 random bytes (see: get_cbd_val in sample.c), computed one byte at a time
+*/
+static int8_t cbd_val_ref(const uint8_t *x)
+{
+    const uint8_t mask[6] = {0xFF, 0xFF, 0x1F, 0xFF, 0xFF, 0x1F};
+    int val               = 0;
+    for (size_t i = 0; i < 6; i++)
+    {
+        for (size_t b = 0; b < 8; b++)
+        {
+            int bit = ((x[i] & mask[i]) >> b) & 1;
+            val += (i < 3) ? bit : -bit;
+        }
+    }
+    return (int8_t)val;
+}
+
+/**
+Checks that the cbd samplers match a reference implementation for the same PRNG output, and checks
+the statistics of the samples against the centered binomial distribution with k = 21 (i.e., mean 0,
+variance 10.5, values in [-21, 21], and the probability of each value).
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_sample_poly_cbd(size_t n)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+    printf("\n******************************************\n");
+    printf("Beginning test for sample_poly_cbd...\n");
+
+#ifdef SE_USE_MALLOC
+    int8_t *e      = calloc(2 * n, sizeof(int8_t));
+    int8_t *e_exp  = &(e[n]);
+    int64_t *e_add = calloc(n, sizeof(int64_t));
+#else
+    int8_t e[SE_DEGREE_N];
+    int8_t e_exp[SE_DEGREE_N];
+    int64_t e_add[SE_DEGREE_N];
+#endif
+    uint8_t buffer[96];
+    size_t counts[43];
+    memset(counts, 0, sizeof(counts));
+    double sum = 0, sum_sq = 0;
+
+    const size_t npolys = 16;
+    for (size_t testnum = 0; testnum < npolys; testnum++)
+    {
+        SE_PRNG prng, prng_exp, prng_add;
+        prng_randomize_reset(&prng, NULL);
+        memcpy(&prng_exp, &prng, sizeof(SE_PRNG));
+        memcpy(&prng_add, &prng, sizeof(SE_PRNG));
+
+        // -- Reference: 16 samples per 96-byte prng call (prng_fill_buffer_x4 matches 4 calls)
+        for (size_t j = 0; j < n; j += 16)
+        {
+            prng_fill_buffer(96, &prng_exp, buffer);
+            for (size_t i = 0; i < 16; i++) e_exp[i + j] = cbd_val_ref(&(buffer[6 * i]));
+        }
+
+        sample_poly_cbd_generic_prng_16(n, &prng, e);
+        se_assert(prng.counter == prng_exp.counter);
+        se_assert(!memcmp(e, e_exp, n));
+
+        for (size_t i = 0; i < n; i++) e_add[i] = (int64_t)i - 7;
+        sample_add_poly_cbd_generic_inpl_prng_16(e_add, n, &prng_add);
+        for (size_t i = 0; i < n; i++) se_assert(e_add[i] == (int64_t)i - 7 + e_exp[i]);
+
+        // -- 1 sample per prng call
+        if (testnum == 0)
+        {
+            memcpy(&prng_exp, &prng, sizeof(SE_PRNG));
+            sample_poly_cbd_generic(64, &prng, e);
+            for (size_t i = 0; i < 64; i++)
+            {
+                prng_fill_buffer(6, &prng_exp, buffer);
+                se_assert(e[i] == cbd_val_ref(buffer));
+            }
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            se_assert(e_exp[i] >= -21 && e_exp[i] <= 21);
+            counts[e_exp[i] + 21]++;
+            sum += e_exp[i];
+            sum_sq += (double)e_exp[i] * e_exp[i];
+        }
+    }
+
+    // -- Mean should be 0 and variance should be k/2 = 10.5. The tolerances are over 7 standard
+    //    errors (for n >= 1024).
+    double nsamples = (double)(npolys * n);
+    double mean     = sum / nsamples;
+    double var      = sum_sq / nsamples - mean * mean;
+    printf("mean     (should be ~0)    : %0.4f\n", mean);
+    printf("variance (should be ~10.5) : %0.4f\n", var);
+    se_assert(fabs(mean) < 0.2);
+    se_assert(fabs(var - 10.5) < 0.9);
+
+    // -- Probability of each value v is C(42, 21 + v) / 2^42. Values with p <= 1e-3 are merged into
+    //    one tail bin, since a single draw of a rarer value would exceed a per-value tolerance.
+    double binom       = 1;  // C(42, i)
+    double p_tail      = 0;
+    size_t counts_tail = 0;
+    for (size_t i = 0; i <= 42; i++)
+    {
+        double p = binom / pow(2, 42);
+        binom    = binom * (double)(42 - i) / (double)(i + 1);
+        if (p <= 1e-3)
+        {
+            p_tail += p;
+            counts_tail += counts[i];
+            continue;
+        }
+        double freq    = (double)counts[i] / nsamples;
+        double std_err = sqrt(p * (1 - p) / nsamples);
+        if (p > 0.01) printf("P(%3d): %0.4f (expected %0.4f)\n", (int)i - 21, freq, p);
+        se_assert(fabs(freq - p) < 7 * std_err);
+    }
+    double freq_tail    = (double)counts_tail / nsamples;
+    double std_err_tail = sqrt(p_tail * (1 - p_tail) / nsamples);
+    printf("P(tail): %0.6f (expected %0.6f)\n", freq_tail, p_tail);
+    se_assert(fabs(freq_tail - p_tail) < 7 * std_err_tail);
+
+#ifdef SE_USE_MALLOC
+    free(e_add);
+    free(e);
+#endif
+    printf("... done with tests for sample_poly_cbd.\n");
+    printf("******************************************\n");
+}
+
+/**
+Checks that prng_fill_buffer_x4 matches 4 consecutive calls to prng_fill_buffer (both in output
+and in the prng's counter), for output lengths around the SHAKE256 rate (136 bytes).
+*/
+void test_prng_fill_buffer_x4(void)
+{
+    printf("\n******************************************\n");
+    printf("Beginning test for prng_fill_buffer_x4...\n");
+
+    const size_t byte_counts[7] = {1, 6, 96, 135, 136, 137, 300};
+    uint8_t buffer[4 * 300];
+    uint8_t buffer_exp[4 * 300];
+
+    for (size_t testnum = 0; testnum < 3; testnum++)
+    {
+        SE_PRNG prng, prng_exp;
+        prng_randomize_reset(&prng, NULL);
+        switch (testnum)
+        {
+            case 0: break;
+            case 1: prng.counter = 12345; break;
+            case 2: prng.counter = UINT64_MAX - 4; break;  // Largest counter w/o overflow
+        }
+        for (size_t k = 0; k < 7; k++)
+        {
+            size_t byte_count = byte_counts[k];
+            memcpy(&prng_exp, &prng, sizeof(SE_PRNG));
+            memset(buffer, 0, sizeof(buffer));
+            memset(buffer_exp, 0xFF, sizeof(buffer_exp));
+
+            for (size_t i = 0; i < 4; i++)
+            { prng_fill_buffer(byte_count, &prng_exp, &(buffer_exp[i * byte_count])); }
+            prng_fill_buffer_x4(byte_count, &prng, buffer);
+
+            printf("byte count: %zu, counter: %" PRIu64 "\n", byte_count, prng.counter);
+            se_assert(prng.counter == prng_exp.counter);
+            se_assert(!memcmp(buffer, buffer_exp, 4 * byte_count));
+            if (testnum == 2) prng.counter = UINT64_MAX - 4;
+        }
+    }
+    printf("... done with tests for prng_fill_buffer_x4.\n");
+    printf("******************************************\n");
+}
+
+/**
+Checks that a PRNG stream squeezed in pieces of various sizes matches a single call to
+prng_fill_buffer (and updates the prng's counter in the same way).
+*/
+void test_prng_stream(void)
+{
+    printf("\n******************************************\n");
+    printf("Beginning test for prng_stream_squeeze...\n");
+
+    // -- Piece sizes around the SHAKE256 rate (136 bytes). Sum is 1024.
+    const size_t piece_sizes[9] = {1, 4, 131, 136, 137, 272, 3, 96, 244};
+    uint8_t buffer[1024];
+    uint8_t buffer_exp[1024];
+
+    SE_PRNG prng, prng_exp;
+    prng_randomize_reset(&prng, NULL);
+    prng.counter = 7;
+    memcpy(&prng_exp, &prng, sizeof(SE_PRNG));
+    memset(buffer, 0, sizeof(buffer));
+
+    prng_fill_buffer(sizeof(buffer_exp), &prng_exp, buffer_exp);
+
+    SE_PRNG_STREAM stream;
+    prng_stream_init(&prng, &stream);
+    size_t pos = 0;
+    for (size_t i = 0; i < 9; i++)
+    {
+        prng_stream_squeeze(piece_sizes[i], &stream, &(buffer[pos]));
+        pos += piece_sizes[i];
+    }
+    se_assert(pos == sizeof(buffer));
+    se_assert(prng.counter == prng_exp.counter);
+    se_assert(!memcmp(buffer, buffer_exp, sizeof(buffer)));
+
+    printf("... done with tests for prng_stream_squeeze.\n");
+    printf("******************************************\n");
+}
+
+/**
+Checks the AES-256-CTR and ChaCha20 PRNG backends against known answers (FIPS-197 Appendix C.3 and
+RFC 8439 Section 2.3.2), checks their seed expansion (see: SE_PRNG_SEED_VERSION) against outputs of
+an independent implementation, and checks that prng_fill_buffer uses the configured PRNG type.
+*/
+void test_prng_backends(void)
+{
+    printf("\n******************************************\n");
+    printf("Beginning test for prng backends...\n");
+
+    uint8_t key[32];
+    uint8_t buffer[128], buffer_exp[128];
+    for (size_t i = 0; i < 32; i++) key[i] = (uint8_t)i;
+
+    // -- AES-256 of a single block. The counter block is le64(nonce) || be64(block index).
+    const uint8_t aes_kat[16] = {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90,
+        0x4b, 0x49, 0x60, 0x89};
+    aes256ctr_ctx aes_state;
+    aes256ctr_init(&aes_state, key, 0x7766554433221100ULL);
+    aes_state.block_idx = 0x8899AABBCCDDEEFFULL;
+    aes256ctr_squeezeblocks(buffer, 1, &aes_state);
+    se_assert(!memcmp(buffer, aes_kat, 16));
+    se_assert(aes_state.block_idx == 0x8899AABBCCDDEEFFULL + 4);
+
+    // -- ChaCha20 block function. The 96-bit nonce is le64(nonce) || 0^32.
+    const uint8_t chacha20_kat[64] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f,
+        0xa3, 0x20, 0x71, 0xc4, 0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03,
+        0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e, 0xd2, 0x82, 0x64, 0x46,
+        0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8,
+        0xa2, 0x50, 0x3c, 0x4e};
+    chacha20_ctx chacha20_state;
+    chacha20_init(&chacha20_state, key, 0x4A00000009000000ULL);
+    chacha20_state.input[12] = 1;  // block counter
+    chacha20_squeezeblocks(buffer, 1, &chacha20_state);
+    se_assert(!memcmp(buffer, chacha20_kat, 64));
+
+    // -- Seed expansion for counter = 5: key = seed[0:32], nonce = counter
+    SE_PRNG prng;
+    for (size_t i = 0; i < SE_PRNG_SEED_BYTE_COUNT; i++) prng.seed[i] = (uint8_t)(7 * i + 3);
+    prng.counter = 5;
+    memcpy(key, prng.seed, 32);
+
+    const uint8_t aes_exp[64] = {
+        0x8e, 0xf6, 0x63, 0x63, 0x54, 0x99, 0x5c, 0x8c, 0xd2, 0x13, 0x86, 0x25,
+        0xb4, 0x8d, 0xd3, 0xdb, 0x00, 0x56, 0xcd, 0x0c, 0xcb, 0x21, 0x57, 0xf1,
+        0x83, 0x04, 0xd6, 0x00, 0xb3, 0x66, 0xe9, 0x13, 0x73, 0x13, 0xe2, 0x17,
+        0x4c, 0xde, 0x43, 0xcd, 0x73, 0xfb, 0x7e, 0x28, 0x38, 0x3e, 0xe2, 0x71,
+        0x3a, 0x16, 0x32, 0x63, 0x31, 0x8b, 0x1c, 0xdf, 0xc4, 0x87, 0x82, 0x8e,
+        0xda, 0xb1, 0x28, 0xb5};
+    const uint8_t chacha20_exp[64] = {
+        0x24, 0x9a, 0x05, 0xd4, 0xcc, 0x3e, 0xfd, 0x26, 0x5b, 0x45, 0x3a, 0xba,
+        0x2d, 0x09, 0xe4, 0x83, 0x13, 0x20, 0xe8, 0x2c, 0x21, 0x93, 0x05, 0x6c,
+        0x4d, 0x9b, 0xbe, 0x4a, 0x4f, 0x75, 0xc3, 0xb0, 0x01, 0xdb, 0xb6, 0x86,
+        0x05, 0xeb, 0x14, 0x80, 0xf2, 0xab, 0xe8, 0xd5, 0x5f, 0x01, 0x89, 0x9b,
+        0x30, 0xa0, 0x67, 0xea, 0x27, 0xcf, 0xa1, 0xf4, 0x28, 0xcf, 0xb9, 0x02,
+        0x51, 0xda, 0xc4, 0x2a};
+
+    // -- Output lengths that are not a multiple of the block size return a prefix of the stream
+    aes256ctr_prf(buffer_exp, 128, key, prng.counter);
+    se_assert(!memcmp(buffer_exp, aes_exp, 64));
+    aes256ctr_prf(buffer, 100, key, prng.counter);
+    se_assert(!memcmp(buffer, buffer_exp, 100));
+
+    chacha20_prf(buffer_exp, 128, key, prng.counter);
+    se_assert(!memcmp(buffer_exp, chacha20_exp, 64));
+    chacha20_prf(buffer, 100, key, prng.counter);
+    se_assert(!memcmp(buffer, buffer_exp, 100));
+
+    // -- prng_fill_buffer must match the seed format it advertises
+#if SE_PRNG_SEED_VERSION == 1
+    uint8_t seed_ext[SE_PRNG_SEED_BYTE_COUNT + 8];
+    memcpy(seed_ext, prng.seed, SE_PRNG_SEED_BYTE_COUNT);
+    memcpy(&(seed_ext[SE_PRNG_SEED_BYTE_COUNT]), &(prng.counter), 8);
+    shake256(buffer_exp, 100, seed_ext, SE_PRNG_SEED_BYTE_COUNT + 8);
+#elif SE_PRNG_SEED_VERSION == 2
+    aes256ctr_prf(buffer_exp, 100, key, prng.counter);
+#else
+    chacha20_prf(buffer_exp, 100, key, prng.counter);
+#endif
+    prng_fill_buffer(100, &prng, buffer);
+    se_assert(prng.counter == 6);
+    se_assert(!memcmp(buffer, buffer_exp, 100));
+
+    printf("... done with tests for prng backends.\n");
+    printf("******************************************\n");
+}
 
 /**
 @param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
@@ -146,6 +453,89 @@ void test_sample_poly_uniform(size_t n)
     printf("******************************************\n");
 }
 
+/**
+Reference uniform sampler: rejection samples one coefficient at a time, replacing each rejected
+value with the next value of the same stream.
+*/
+static void sample_poly_uniform_ref(const Parms *parms, SE_PRNG *prng, ZZ *poly)
+{
+    size_t n         = parms->coeff_count;
+    const Modulus *q = parms->curr_modulus;
+
+    ZZ max_random   = (ZZ)0xFFFFFFFFUL;
+    ZZ max_multiple = max_random - barrett_reduce_32input_32modulus(max_random, q) - 1;
+
+    SE_PRNG_STREAM stream;
+    prng_stream_init(prng, &stream);
+    prng_stream_squeeze(n * sizeof(ZZ), &stream, (void *)poly);
+    for (size_t i = 0; i < n; i++)
+    {
+        ZZ rand_val = poly[i];
+        while (rand_val >= max_multiple)
+        { prng_stream_squeeze(sizeof(ZZ), &stream, (void *)&rand_val); }
+        poly[i] = barrett_reduce_32input_32modulus(rand_val, q);
+    }
+}
+
+/**
+Checks that the batched uniform sampler matches the reference sampler exactly (so that the server
+can regenerate the uniform polynomial from the shared seed), both for the default modulus (rare
+rejections) and for a modulus that rejects about 1/3 of the candidates.
+
+@param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
+*/
+void test_sample_poly_uniform_rejection(size_t n)
+{
+#ifndef SE_USE_MALLOC
+    se_assert(n == SE_DEGREE_N);
+    if (n != SE_DEGREE_N) n = SE_DEGREE_N;
+#endif
+
+    printf("\n******************************************\n");
+    printf("Beginning test for sample_poly_uniform rejection...\n");
+    Parms parms;
+    set_parms_ckks(n, 1, &parms);
+    Modulus *default_modulus = parms.curr_modulus;
+
+    // -- floor(2^64/q) = 0x2FFFFFFFA. (2^32 - 1) mod q = 1431655763.
+    Modulus high_reject_modulus;
+    set_modulus_custom(1431655766, 0x2, 0xFFFFFFFA, &high_reject_modulus);
+
+#ifdef SE_USE_MALLOC
+    ZZ *a     = calloc(2 * n, sizeof(ZZ));
+    ZZ *a_exp = &(a[n]);
+#else
+    ZZ a[SE_DEGREE_N];
+    ZZ a_exp[SE_DEGREE_N];
+#endif
+
+    for (size_t testnum = 0; testnum < 2; testnum++)
+    {
+        parms.curr_modulus = testnum ? &high_reject_modulus : default_modulus;
+        print_zz("q", parms.curr_modulus->value);
+        for (size_t seednum = 0; seednum < 4; seednum++)
+        {
+            SE_PRNG prng, prng_exp;
+            prng_randomize_reset(&prng, NULL);
+            memcpy(&prng_exp, &prng, sizeof(SE_PRNG));
+
+            sample_poly_uniform(&parms, &prng, a);
+            sample_poly_uniform_ref(&parms, &prng_exp, a_exp);
+            se_assert(prng.counter == prng_exp.counter);
+            se_assert(!memcmp(a, a_exp, n * sizeof(ZZ)));
+            for (size_t i = 0; i < n; i++) se_assert(a[i] < parms.curr_modulus->value);
+        }
+    }
+    parms.curr_modulus = default_modulus;
+
+#ifdef SE_USE_MALLOC
+    delete_parameters(&parms);
+    free(a);
+#endif
+    printf("... done with tests for sample_poly_uniform rejection.\n");
+    printf("******************************************\n");
+}
+
 /**
 @param[in] n  Polynomial ring degree (ignored if SE_USE_MALLOC is defined)
 */